@@ -14,6 +14,7 @@
 #include "lv_app_util/lv_app_fsel.h"
 
 #include "lvgl/lv_misc/anim.h"
+#include "lvgl/lv_obj/lv_layer.h"
 
 #include "../lv_appx/lv_app_example.h"
 #include "../lv_appx/lv_app_sysmon.h"
@@ -50,6 +51,8 @@ static lv_action_res_t lv_app_win_minim_action(lv_obj_t * close_minim, lv_dispi_
 static lv_action_res_t lv_app_win_open_anim_create(lv_app_inst_t * app);
 static lv_action_res_t lv_app_win_minim_anim_create(lv_app_inst_t * app);
 #if LV_APP_EFFECT_ANIM != 0 && LV_APP_ANIM_WIN != 0
+static bool lv_app_win_layer_anim(lv_app_inst_t * app, const area_t * sc_cords, bool open, void (*cb)(lv_obj_t *));
+static void lv_app_win_open_anim_cb(lv_obj_t * app_win);
 static void lv_app_win_close_anim_cb(lv_obj_t * app_win);
 static void lv_app_win_minim_anim_cb(lv_obj_t * app_win);
 #endif
@@ -782,8 +785,32 @@ static lv_action_res_t lv_app_win_close_action(lv_obj_t * close_btn, lv_dispi_t
 	lv_app_kb_close(false);
 
 #if  LV_APP_EFFECT_ANIM != 0 && LV_APP_EFFECT_OPA != 0 && LV_APP_ANIM_WIN != 0
-    lv_obj_anim(app->win, LV_ANIM_FLOAT_BOTTOM | ANIM_OUT, LV_APP_ANIM_WIN, 0, NULL);
-	lv_obj_anim(app->win, LV_ANIM_FLOAT_LEFT | ANIM_OUT, LV_APP_ANIM_WIN, 0, lv_app_win_close_anim_cb);
+	if(lv_layer_create(app->win) != false) {
+	    /*Move only the snapshot of the window. It will be closed anyway.*/
+	    lv_obj_t * par = lv_obj_get_parent(app->win);
+	    anim_t a;
+	    a.act_time = 0;
+	    a.time = LV_APP_ANIM_WIN;
+	    a.playback = 0;
+	    a.repeat = 0;
+	    a.var = app->win;
+	    a.path = anim_get_path(ANIM_PATH_LIN);
+
+	    a.start = 0;
+	    a.end = lv_obj_get_height(par) - lv_obj_get_y(app->win);
+	    a.fp = (anim_fp_t) lv_layer_set_y;
+	    a.end_cb = NULL;
+	    anim_create(&a);
+
+	    a.start = 0;
+	    a.end = -lv_obj_get_width(app->win) - lv_obj_get_x(app->win);
+	    a.fp = (anim_fp_t) lv_layer_set_x;
+	    a.end_cb = (void (*)(void *))lv_app_win_close_anim_cb;
+	    anim_create(&a);
+	} else {
+	    lv_obj_anim(app->win, LV_ANIM_FLOAT_BOTTOM | ANIM_OUT, LV_APP_ANIM_WIN, 0, NULL);
+	    lv_obj_anim(app->win, LV_ANIM_FLOAT_LEFT | ANIM_OUT, LV_APP_ANIM_WIN, 0, lv_app_win_close_anim_cb);
+	}
 	lv_app_sc_close(app);
 	/*The animation will close the window*/
     return LV_ACTION_RES_OK;
@@ -837,6 +864,11 @@ static lv_action_res_t lv_app_win_open_anim_create(lv_app_inst_t * app)
         lv_obj_get_cords(app->sc, &cords);
     }
 
+    /*Grow only a snapshot of the window if possible*/
+    if(lv_app_win_layer_anim(app, &cords, true, lv_app_win_open_anim_cb) != false) {
+        return LV_ACTION_RES_OK;
+    }
+
     anim_t a;
     a.act_time = 0;
     a.time = LV_APP_ANIM_WIN;
@@ -889,6 +921,11 @@ static lv_action_res_t lv_app_win_minim_anim_create(lv_app_inst_t * app)
         lv_obj_get_cords(app->sc, &cords);
     }
 
+    /*Shrink only a snapshot of the window if possible*/
+    if(lv_app_win_layer_anim(app, &cords, false, lv_app_win_minim_anim_cb) != false) {
+        return LV_ACTION_RES_OK;
+    }
+
     anim_t a;
     a.act_time = 0;
     a.time = LV_APP_ANIM_WIN;
@@ -927,7 +964,66 @@ static lv_action_res_t lv_app_win_minim_anim_create(lv_app_inst_t * app)
 #endif
 }
 
-#if LV_APP_EFFECT_ANIM != 0
+#if LV_APP_EFFECT_ANIM != 0 && LV_APP_ANIM_WIN != 0
+/**
+ * Animate the snapshot of a window between a shortcut and the window's real place
+ * @param app pointer to an application
+ * @param sc_cords coordinates of the shortcut
+ * @param open true: grow from the shortcut, false: shrink to the shortcut
+ * @param cb a function to call when the animation is ready
+ * @return true: the animation is created, false: no snapshot (animate the window itself)
+ */
+static bool lv_app_win_layer_anim(lv_app_inst_t * app, const area_t * sc_cords, bool open, void (*cb)(lv_obj_t *))
+{
+    if(lv_layer_create(app->win) == false) return false;
+
+    area_t win_cords;
+    lv_obj_get_cords(app->win, &win_cords);
+
+    anim_t a;
+    a.act_time = 0;
+    a.time = LV_APP_ANIM_WIN;
+    a.end_cb = NULL;
+    a.playback = 0;
+    a.repeat = 0;
+    a.var = app->win;
+    a.path = anim_get_path(ANIM_PATH_LIN);
+
+    /*Init. to open and swap start and end to minimize*/
+    int32_t start[4];
+    int32_t end[4];
+    anim_fp_t fp[4] = {(anim_fp_t) lv_layer_set_zoom_x, (anim_fp_t) lv_layer_set_zoom_y,
+                       (anim_fp_t) lv_layer_set_x, (anim_fp_t) lv_layer_set_y};
+    start[0] = (area_get_width(sc_cords) * LV_LAYER_ZOOM_NONE) / area_get_width(&win_cords);
+    end[0] = LV_LAYER_ZOOM_NONE;
+    start[1] = (area_get_height(sc_cords) * LV_LAYER_ZOOM_NONE) / area_get_height(&win_cords);
+    end[1] = LV_LAYER_ZOOM_NONE;
+    start[2] = sc_cords->x1 - win_cords.x1;
+    end[2] = 0;
+    start[3] = sc_cords->y1 - win_cords.y1;
+    end[3] = 0;
+
+    uint8_t i;
+    for(i = 0; i < 4; i++) {
+        a.start = open != false ? start[i] : end[i];
+        a.end = open != false ? end[i] : start[i];
+        a.fp = fp[i];
+        if(i == 3) a.end_cb = (void (*)(void *))cb;
+        anim_create(&a);
+    }
+
+    return true;
+}
+
+/**
+ * Called when the window open animation is ready to draw the window normally again
+ * @param app_win pointer to a window
+ */
+static void lv_app_win_open_anim_cb(lv_obj_t * app_win)
+{
+    lv_layer_del(app_win);
+}
+
 /**
  * Called when the window close animation is ready to close the application
  * @param app_win pointer to a window
@@ -1,6 +1,6 @@
 /**
  * @file lv_app_notice.c
- * 
+ *
  */
 
 /*********************
@@ -13,24 +13,78 @@
 #include "lvgl/lv_objx/lv_label.h"
 
 #include "lvgl/lv_misc/anim.h"
+#include "misc/os/ptask.h"
+#include "hal/systick/systick.h"
 #include <stdio.h>
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
+/*Test configurations*/
+#ifndef LV_APP_NOTICE_POOL_SIZE
+#define LV_APP_NOTICE_POOL_SIZE 4    /*Max. number of notices on the screen (pre-built message boxes)*/
+#endif
+
+#ifndef LV_APP_NOTICE_QUEUE_LEN
+#define LV_APP_NOTICE_QUEUE_LEN 8    /*Max. number of notices waiting for a free message box*/
+#endif
+
+#ifndef LV_APP_NOTICE_PERIOD
+#define LV_APP_NOTICE_PERIOD    100  /*Show at most one new notice in this time [ms]*/
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+/*A notice waiting in the queue*/
+typedef struct
+{
+    char txt[LV_APP_NOTICE_MAX_LEN];
+    lv_mboxs_t * style;
+    uint16_t cnt;           /*Number of the coalesced same notices*/
+}lv_app_notice_dsc_t;
+
+/*States of the message boxes in the pool*/
+typedef enum
+{
+    LV_APP_NOTICE_FREE,     /*Hidden, can be used for a new notice*/
+    LV_APP_NOTICE_SHOWN,
+    LV_APP_NOTICE_CLOSING,  /*The close animation is in progress*/
+}lv_app_notice_state_t;
+
+/*A message box in the pool*/
+typedef struct
+{
+    lv_app_notice_dsc_t dsc;    /*The shown notice*/
+    lv_obj_t * mbox;            /*NULL if not created yet (or deleted)*/
+    uint32_t show_time;         /*When the notice was shown or repeated last time [systick]*/
+    uint16_t cnt_shown;         /*'dsc.cnt' on the label (to refresh it only once per period)*/
+    uint8_t state;              /*From 'lv_app_notice_state_t'*/
+}lv_app_notice_slot_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static bool lv_app_notice_vadd(lv_mboxs_t * style, const char * format, va_list va);
+static void lv_app_notice_task(void * param);
+static void lv_app_notice_show(lv_app_notice_slot_t * slot);
+static void lv_app_notice_refr_txt(lv_app_notice_slot_t * slot);
+static void lv_app_notice_close(lv_app_notice_slot_t * slot);
+static void lv_app_notice_release(lv_obj_t * mbox);
+static void lv_app_notice_create_mbox(lv_app_notice_slot_t * slot);
+static lv_app_notice_slot_t * lv_app_notice_find_slot(lv_obj_t * mbox);
+static bool lv_app_notice_signal(lv_obj_t * mbox, lv_signal_t sign, void * param);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static lv_obj_t * notice_h;
+static ptask_t * notice_task;
+static lv_app_notice_slot_t notice_pool[LV_APP_NOTICE_POOL_SIZE];
+static lv_app_notice_dsc_t notice_queue[LV_APP_NOTICE_QUEUE_LEN];   /*Ring buffer*/
+static uint8_t queue_start;     /*Index of the oldest waiting notice*/
+static uint8_t queue_num;       /*Number of waiting notices*/
 
 /**********************
  *      MACROS
@@ -52,42 +106,275 @@ void lv_app_notice_init(void)
     lv_obj_set_click(notice_h, false);
     lv_obj_set_style(notice_h, lv_rects_get(LV_RECTS_TRANSP, NULL));
     lv_rect_set_layout(notice_h, LV_RECT_LAYOUT_COL_R);
+
+    /*Build the message boxes now to not allocate them when the notices come*/
+    uint8_t i;
+    for(i = 0; i < LV_APP_NOTICE_POOL_SIZE; i++) {
+        notice_pool[i].mbox = NULL;
+        notice_pool[i].state = LV_APP_NOTICE_FREE;
+        lv_app_notice_create_mbox(&notice_pool[i]);
+    }
+
+    queue_start = 0;
+    queue_num = 0;
+
+    /*The task runs only while there are notices*/
+    notice_task = ptask_create(lv_app_notice_task, LV_APP_NOTICE_PERIOD, PTASK_PRIO_OFF, NULL);
 }
 
 /**
- * Add a notification with a given text
+ * Add a notification with a given text.
+ * Only the text is stored here. The notices are shown later one by one in every LV_APP_NOTICE_PERIOD.
+ * The same notices are shown once with a repeat count (e.g. "Text (x3)").
  * @param format pritntf-like format string
- * @return pointer the notice which is a message box (lv_mbox) object
+ * @return true: the notice is added, false: the queue is full so the notice is dropped
  */
-lv_obj_t *  lv_app_notice_add(const char * format, ...)
+bool lv_app_notice_add(const char * format, ...)
 {
-    char txt[LV_APP_NOTICE_MAX_LEN];
+    bool res;
+    va_list va;
+    va_start(va, format);
+    res = lv_app_notice_vadd(lv_mboxs_get(LV_MBOXS_INFO, NULL), format, va);
+    va_end(va);
+
+    return res;
+}
 
+/**
+ * Add a notification with a given style and text (see 'lv_app_notice_add')
+ * @param style pointer to a message box style (e.g. lv_mboxs_get(LV_MBOXS_WARN, NULL)).
+ *              It has to be valid while the notice is shown.
+ * @param format pritntf-like format string
+ * @return true: the notice is added, false: the queue is full so the notice is dropped
+ */
+bool lv_app_notice_add_style(lv_mboxs_t * style, const char * format, ...)
+{
+    bool res;
     va_list va;
     va_start(va, format);
-    vsprintf(txt,format, va);
+    res = lv_app_notice_vadd(style, format, va);
     va_end(va);
 
-    lv_app_style_t * app_style = lv_app_style_get();
+    return res;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Coalesce a notice with a same shown or waiting one or add it to the queue
+ * @param style pointer to a message box style
+ * @param format pritntf-like format string
+ * @param va the arguments of 'format'
+ * @return true: the notice is added, false: the queue is full so the notice is dropped
+ */
+static bool lv_app_notice_vadd(lv_mboxs_t * style, const char * format, va_list va)
+{
+    char txt[LV_APP_NOTICE_MAX_LEN];
+    vsnprintf(txt, sizeof(txt), format, va);
+
+    /*Count a repetition of a shown notice*/
+    uint8_t i;
+    for(i = 0; i < LV_APP_NOTICE_POOL_SIZE; i++) {
+        lv_app_notice_slot_t * slot = &notice_pool[i];
+        if(slot->state == LV_APP_NOTICE_SHOWN && slot->dsc.style == style &&
+           strcmp(slot->dsc.txt, txt) == 0) {
+            if(slot->dsc.cnt < UINT16_MAX) slot->dsc.cnt++;
+            slot->show_time = systick_get();
+            ptask_set_prio(notice_task, PTASK_PRIO_LOW);
+            return true;
+        }
+    }
 
-    lv_obj_t * mbox;
-    mbox = lv_mbox_create(notice_h, NULL);
-    lv_obj_set_style(mbox, lv_mboxs_get(LV_MBOXS_INFO, NULL));
-    lv_mbox_set_title(mbox, "");
-    lv_mbox_set_text(mbox, txt);
-    lv_obj_set_opa(mbox, app_style->menu_opa);
+    /*Count a repetition of a waiting notice*/
+    lv_app_notice_dsc_t * dsc;
+    for(i = 0; i < queue_num; i++) {
+        dsc = &notice_queue[(queue_start + i) % LV_APP_NOTICE_QUEUE_LEN];
+        if(dsc->style == style && strcmp(dsc->txt, txt) == 0) {
+            if(dsc->cnt < UINT16_MAX) dsc->cnt++;
+            return true;
+        }
+    }
 
+    if(queue_num >= LV_APP_NOTICE_QUEUE_LEN) return false;
+
+    dsc = &notice_queue[(queue_start + queue_num) % LV_APP_NOTICE_QUEUE_LEN];
+    strcpy(dsc->txt, txt);
+    dsc->style = style;
+    dsc->cnt = 1;
+    queue_num++;
+
+    ptask_set_prio(notice_task, PTASK_PRIO_LOW);
+
+    return true;
+}
+
+/**
+ * Periodically show a waiting notice, refresh the repeat counts and close the old notices
+ * @param param unused
+ */
+static void lv_app_notice_task(void * param)
+{
+    bool busy = false;
+    lv_app_notice_slot_t * free_slot = NULL;
+    uint8_t i;
+
+    for(i = 0; i < LV_APP_NOTICE_POOL_SIZE; i++) {
+        lv_app_notice_slot_t * slot = &notice_pool[i];
+        if(slot->state == LV_APP_NOTICE_SHOWN) {
+            if(slot->cnt_shown != slot->dsc.cnt) lv_app_notice_refr_txt(slot);
 #if LV_APP_NOTICE_SHOW_TIME != 0
-    lv_mbox_start_auto_close(mbox, LV_APP_NOTICE_SHOW_TIME);
+            if(systick_elaps(slot->show_time) >= LV_APP_NOTICE_SHOW_TIME) {
+                lv_app_notice_close(slot);
+            }
 #endif
+            busy = true;
+        }
+        else if(slot->state == LV_APP_NOTICE_CLOSING) busy = true;
+        else if(free_slot == NULL) free_slot = slot;
+    }
+
+    if(queue_num != 0) {
+        busy = true;
+        if(free_slot != NULL) {
+            memcpy(&free_slot->dsc, &notice_queue[queue_start], sizeof(lv_app_notice_dsc_t));
+            queue_start = (queue_start + 1) % LV_APP_NOTICE_QUEUE_LEN;
+            queue_num--;
+            lv_app_notice_show(free_slot);
+        }
+    }
+
+    if(busy == false) ptask_set_prio(notice_task, PTASK_PRIO_OFF);
+}
+
+/**
+ * Show the notice of a slot on its message box
+ * @param slot pointer to a free slot with the notice to show in 'slot->dsc'
+ */
+static void lv_app_notice_show(lv_app_notice_slot_t * slot)
+{
+    if(slot->mbox == NULL) lv_app_notice_create_mbox(slot);
+
+    lv_obj_t * mbox = slot->mbox;
+    if(lv_obj_get_style(mbox) != slot->dsc.style) lv_obj_set_style(mbox, slot->dsc.style);
+
+    slot->state = LV_APP_NOTICE_SHOWN;
+    slot->show_time = systick_get();
+    lv_app_notice_refr_txt(slot);
+
+    /*Set the parent again to show the notice as the newest one*/
+    lv_obj_set_parent(mbox, notice_h);
+    lv_obj_set_hidden(mbox, false);
+    lv_rect_set_fit(mbox, true, true);
 
     lv_obj_set_parent(notice_h, lv_scr_act());
+}
 
-    return mbox;
+/**
+ * Write the text of a slot (with the repeat count) to its message box
+ * @param slot pointer to a slot with a message box
+ */
+static void lv_app_notice_refr_txt(lv_app_notice_slot_t * slot)
+{
+    if(slot->dsc.cnt <= 1) {
+        lv_mbox_set_text(slot->mbox, slot->dsc.txt);
+    } else {
+        char txt[LV_APP_NOTICE_MAX_LEN + 16];
+        sprintf(txt, "%s (x%d)", slot->dsc.txt, slot->dsc.cnt);
+        lv_mbox_set_text(slot->mbox, txt);
+    }
 
+    slot->cnt_shown = slot->dsc.cnt;
+}
+
+/**
+ * Animate out a shown notice. Its message box is given back to the pool at the end.
+ * @param slot pointer to a slot with a shown notice
+ */
+static void lv_app_notice_close(lv_app_notice_slot_t * slot)
+{
+    slot->state = LV_APP_NOTICE_CLOSING;
+
+#if LV_MBOX_ANIM_TIME != 0
+    lv_rect_set_fit(slot->mbox, false, false);
+    lv_obj_anim(slot->mbox, LV_ANIM_GROW_H | ANIM_OUT, LV_MBOX_ANIM_TIME, 0, NULL);
+    lv_obj_anim(slot->mbox, LV_ANIM_GROW_V | ANIM_OUT, LV_MBOX_ANIM_TIME, 0, lv_app_notice_release);
+#else
+    lv_app_notice_release(slot->mbox);
+#endif
+}
+
+/**
+ * Hide the message box of a closed notice to use it for a new notice later
+ * @param mbox pointer to a message box of the pool
+ */
+static void lv_app_notice_release(lv_obj_t * mbox)
+{
+    lv_app_notice_slot_t * slot = lv_app_notice_find_slot(mbox);
+    if(slot == NULL) return;
+
+    lv_obj_set_hidden(mbox, true);
+    slot->state = LV_APP_NOTICE_FREE;
+}
+
+/**
+ * Create the message box of a slot
+ * @param slot pointer to slot without message box
+ */
+static void lv_app_notice_create_mbox(lv_app_notice_slot_t * slot)
+{
+    lv_app_style_t * app_style = lv_app_style_get();
+
+    slot->mbox = lv_mbox_create(notice_h, NULL);
+    lv_obj_set_style(slot->mbox, lv_mboxs_get(LV_MBOXS_INFO, NULL));
+    lv_obj_set_opa(slot->mbox, app_style->menu_opa);
+    lv_obj_set_signal_f(slot->mbox, lv_app_notice_signal);
+    lv_obj_set_hidden(slot->mbox, true);
+    slot->state = LV_APP_NOTICE_FREE;
+}
+
+/**
+ * Get the slot of a message box
+ * @param mbox pointer to a message box of the pool
+ * @return pointer to the slot of 'mbox' or NULL if not found
+ */
+static lv_app_notice_slot_t * lv_app_notice_find_slot(lv_obj_t * mbox)
+{
+    uint8_t i;
+    for(i = 0; i < LV_APP_NOTICE_POOL_SIZE; i++) {
+        if(notice_pool[i].mbox == mbox) return &notice_pool[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * Signal function of the notices. Close them on long press instead of deleting.
+ * @param mbox pointer to a message box of the pool
+ * @param sign a signal type from lv_signal_t enum
+ * @param param pointer to a signal specific variable
+ * @return true: the object is still valid (not deleted), false: the object become invalid
+ */
+static bool lv_app_notice_signal(lv_obj_t * mbox, lv_signal_t sign, void * param)
+{
+    lv_app_notice_slot_t * slot = lv_app_notice_find_slot(mbox);
+
+    if(sign == LV_SIGNAL_LONG_PRESS) {
+        if(slot != NULL && slot->state == LV_APP_NOTICE_SHOWN) lv_app_notice_close(slot);
+        lv_dispi_wait_release(param);
+        return true;
+    }
+
+    bool valid = lv_mbox_signal(mbox, sign, param);
+
+    /*If the message box is deleted (e.g. with its screen) create a new one when required*/
+    if(sign == LV_SIGNAL_CLEANUP && slot != NULL) {
+        slot->mbox = NULL;
+        slot->state = LV_APP_NOTICE_FREE;
+    }
+
+    return valid;
 }
-/**********************
- *   STATIC FUNCTIONS
- **********************/
 
 #endif
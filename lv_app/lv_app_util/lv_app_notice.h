@@ -31,11 +31,22 @@
 void lv_app_notice_init(void);
 
 /**
- * Add a notification with a given text
+ * Add a notification with a given text.
+ * Only the text is stored here. The notices are shown later one by one in every LV_APP_NOTICE_PERIOD.
+ * The same notices are shown once with a repeat count (e.g. "Text (x3)").
  * @param format pritntf-like format string
- * @return pointer the notice which is a message box (lv_mbox) object
+ * @return true: the notice is added, false: the queue is full so the notice is dropped
  */
-lv_obj_t *  lv_app_notice_add(const char * format, ...);
+bool lv_app_notice_add(const char * format, ...);
+
+/**
+ * Add a notification with a given style and text (see 'lv_app_notice_add')
+ * @param style pointer to a message box style (e.g. lv_mboxs_get(LV_MBOXS_WARN, NULL)).
+ *              It has to be valid while the notice is shown.
+ * @param format pritntf-like format string
+ * @return true: the notice is added, false: the queue is full so the notice is dropped
+ */
+bool lv_app_notice_add_style(lv_mboxs_t * style, const char * format, ...);
 
 /**********************
  *      MACROS
@@ -13,6 +13,7 @@
 #include "misc/os/ptask.h"
 #include "misc/os/idle.h"
 #include "lvgl/lv_objx/lv_chart.h"
+#include "lvgl/lv_misc/slab.h"
 #include "lvgl/lv_app/lv_app_util/lv_app_notice.h"
 #include "hal/systick/systick.h"
 
@@ -85,6 +86,7 @@ static lv_pbs_t cpu_pbs;
 static lv_pbs_t mem_pbs;
 #if USE_DYN_MEM != 0  && DM_CUSTOM == 0
 static  dm_mon_t mem_mon;
+static  slab_mon_t slab_mon;
 #endif
 
 /**********************
@@ -287,6 +289,7 @@ static void sysmon_task(void * param)
 #if  USE_DYN_MEM != 0  && DM_CUSTOM == 0
     dm_monitor(&mem_mon);
     mem_used_pct = mem_mon.pct_used;
+    slab_monitor(&slab_mon);
 #endif
 
     /*Add the CPU and memory data*/
@@ -311,8 +314,7 @@ static void sysmon_task(void * param)
     static bool mem_warn_report = false;
     if(mem_mon.size_free < LV_APP_SYSMON_MEM_WARN && mem_warn_report == false) {
         mem_warn_report = true;
-        lv_obj_t * not = lv_app_notice_add("Critically low memory");
-        lv_obj_set_style(not, lv_mboxs_get(LV_MBOXS_WARN, NULL));
+        lv_app_notice_add_style(lv_mboxs_get(LV_MBOXS_WARN, NULL), "Critically low memory");
     }
 
     if(mem_mon.size_free > LV_APP_SYSMON_MEM_WARN)  mem_warn_report = false;
@@ -321,10 +323,10 @@ static void sysmon_task(void * param)
     if(mem_mon.pct_frag > LV_APP_SYSMON_FRAG_WARN) {
         if(frag_warn_report == false) {
             frag_warn_report = true;
-            lv_obj_t * not =lv_app_notice_add("Critical memory\nfragmentation");
-            lv_obj_set_style(not, lv_mboxs_get(LV_MBOXS_WARN, NULL));
+            lv_app_notice_add_style(lv_mboxs_get(LV_MBOXS_WARN, NULL), "Critical memory\nfragmentation");
 
-            dm_defrag(); /*Defrag. if the fragmentation is critical*/
+            slab_trim();  /*Give back the empty slab chunks and defrag. if the fragmentation is critical*/
+            dm_defrag();
         }
     }
 
@@ -349,11 +351,13 @@ static void lv_app_sysmon_refr(void)
 #endif
 
 #if USE_DYN_MEM != 0  && DM_CUSTOM == 0
-    sprintf(buf_long, "%sMEMORY: %d %%\nTotal: %d bytes\nUsed: %d bytes\nFree: %d bytes\nFrag: %d %%",
+    sprintf(buf_long, "%sMEMORY: %d %%\nTotal: %d bytes\nUsed: %d bytes\nFree: %d bytes\nFrag: %d %%\n"
+                      "Slab: %d/%d bytes (%d %%)",
                   buf_long,
                   mem_pct[LV_APP_SYSMON_PNUM - 1],
                   mem_mon.size_total,
-                  mem_mon.size_total - mem_mon.size_free, mem_mon.size_free, mem_mon.pct_frag);
+                  mem_mon.size_total - mem_mon.size_free, mem_mon.size_free, mem_mon.pct_frag,
+                  slab_mon.size_total - slab_mon.size_free, slab_mon.size_total, slab_mon.pct_frag);
 
     sprintf(buf_short, "%sMem: %d %%\nFrag: %d %%\n",
                   buf_short, mem_pct[LV_APP_SYSMON_PNUM - 1], mem_mon.pct_frag);
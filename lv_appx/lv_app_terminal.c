@@ -189,6 +189,7 @@ static void my_sc_open(lv_app_inst_t * app, lv_obj_t * sc)
 
     /*Create a dark background*/
     lv_obj_t * txt_bg = lv_obj_create(sc, NULL);
+    lv_obj_refr_cords(app->sc_title);
     lv_obj_set_size(txt_bg, 7 * LV_APP_SC_WIDTH / 8 , app->sc->cords.y2 - app->sc_title->cords.y2 - 10 * LV_DOWNSCALE);
     lv_obj_set_style(txt_bg, &sc_txt_bgs);
     lv_obj_align(txt_bg, app->sc_title, LV_ALIGN_OUT_BOTTOM_MID, 0, 3 * LV_DOWNSCALE);
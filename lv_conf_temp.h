@@ -35,17 +35,27 @@
 
 #define LV_REFR_PERIOD      40    /*Screen refresh period in milliseconds*/
 #define LV_INV_FIFO_SIZE    32    /*The average number of objects on a screen */
+#define LV_ANIM_MAX_STEP    (3 * LV_REFR_PERIOD) /*Max. time step of an animation in one frame (frame skip protection, 0: no limit)*/
+#define LV_ANIM_VAR_SLOTS   32    /*Slots of the animation index by variable (must be 2^N)*/
+#define LV_LAYER_NUM        2     /*Max. number of objects drawn from a snapshot at the same time (0: disable)*/
+#define LV_LAYER_CACHE_SIZE (32 * 1024) /*Memory for the snapshots of the cached objects [bytes] (0: disable the caching)*/
+#define LV_CMD_QUEUE_SIZE   16    /*Commands posted by other threads before the next refresh (must be 2^N, 0: disable)*/
+#define LV_CMD_TXT_LEN      32    /*Max. text length of a posted command (e.g. lv_cmd_label_set_text)*/
+#define LV_SCRD_MAX_DEPTH   8     /*Max. depth of the object trees in the screen descriptions (lv_scrd_load)*/
 
 /*=================
    Misc. setting
  *=================*/
 /*Display Input settings*/
 #define LV_DISPI_READ_PERIOD      50     /*Input device read period milliseconds*/
+#define LV_DISPI_IDLE_PERIOD      LV_DISPI_READ_PERIOD /*Read period if nothing is pressed (0: wait for lv_dispi_wake())*/
 #define LV_DISPI_TP_MARKER        0      /*Mark the pressed points*/
 #define LV_DISPI_DRAG_LIMIT       10     /*Drag threshold in pixels */
 #define LV_DISPI_DRAG_THROW       20     /*Drag throw slow-down in [%]. Greater value means faster slow-down */
 #define LV_DISPI_LONG_PRESS_TIME  400    /*Long press time in milliseconds*/
 #define LV_DISPI_LONG_PRESS_REP_TIME 100 /*Repeated trigger period in long press [ms] */
+#define LV_DISPI_HIT_IDX_NUM      4      /*Number of cached hit-test indexes (0: disable)*/
+#define LV_DISPI_HIT_IDX_MIN      16     /*Build a hit-test index for objects with at least this many children*/
 
 /*Coordinates*/
 #define LV_CORD_TYPE    int16_t /*Coordinate type*/
@@ -65,10 +75,12 @@
 #define USE_FONT_SYMBOL_60   1
 #define LV_FONT_DEFAULT      FONT_DEJAVU_30  /*Always set a default font*/
 #define LV_TXT_BREAK_CHARS  " ,.;-" /*Can break texts on these chars*/
+#define LV_TXT_POOL_SIZE    32      /*Hash slots to share identical label texts (0: disable sharing)*/
 
 /*lv_obj (base object) settings*/
 #define LV_OBJ_FREE_P            1           /*Enable the free pointer attribute*/
 #define LV_OBJ_DEF_SCR_COLOR     COLOR_SILVER /*Default screen color*/
+#define LV_SLAB_BLOCK_NUM        8           /*Blocks in a slab chunk for ext. data and styles (0: use dyn_mem directly, max. 255)*/
 
 /*Others*/
 #define LV_COLOR_TRANSP     COLOR_LIME
@@ -87,6 +99,7 @@
 #define LV_LABEL_SCROLL_SPEED_VER   (10 * LV_DOWNSCALE) /*Ver. scroll speed if hor. scroll is applied too*/
 #define LV_LABEL_SCROLL_PLAYBACK_PAUSE  500 /*Wait before the scroll turns back in ms*/
 #define LV_LABEL_SCROLL_REPEAT_PAUSE    500 /*Wait before the scroll begins again in ms*/
+#define LV_LABEL_LINE_INDEX         1   /*Store the line starts in break mode. Speeds up editing and drawing long texts*/
 #endif
 
 /*Button (dependencies: lv_rect*/
@@ -112,6 +125,10 @@
 #define USE_LV_PAGE     1
 #if USE_LV_PAGE != 0
 #define LV_PAGE_ANIM_FOCUS_TIME 300 /*List focus animation time [ms] (0: turn off the animation)*/
+#define LV_PAGE_KIN_DECEL       (2000 * LV_DOWNSCALE)   /*Deceleration of kinetic scrolling [px/s^2] (0: use the drag throw of lv_dispi)*/
+#define LV_PAGE_ELASTIC         (30 * LV_DOWNSCALE)     /*Max. overscroll on the edges [px] (0: no elastic edges)*/
+#define LV_PAGE_SB_HIDE_DELAY   1000    /*Keep the scrollbars visible after scrolling in LV_PAGE_SB_MODE_HIDE [ms]*/
+#define LV_PAGE_SB_FADE_TIME    300     /*Fade out time of the scrollbars in LV_PAGE_SB_MODE_HIDE [ms] (0: hide without fading)*/
 #endif
 
 /*List (dependencies: lv_btn, lv_label, lv_img)*/
@@ -125,14 +142,20 @@
 
 /*LED (dependencies: lv_rect)*/
 #define USE_LV_LED      1
+#if USE_LV_LED != 0
+#define LV_LED_CACHE_SIZE   (16 * 1024)  /*Memory for the snapshots shared by the LEDs with the same style and size [bytes] (0: no caching)*/
+#endif
 
 /*Chart (dependencies: lv_rect, lv_line)*/
 #define USE_LV_CHART    1
+#if USE_LV_CHART != 0
+#define LV_CHART_LOD_SHIFT  2       /*A level of the min/max pyramids merges 2^N elements (more: less memory, slower drawing)*/
+#endif
 
 /*Text area (dependencies: lv_label, lv_page)*/
 #define USE_LV_TA       1
 #if USE_LV_TA != 0
-#define LV_TA_MAX_LENGTH    256
+#define LV_TA_MAX_LENGTH    256     /*Max. number of characters (<= 32767). The text is edited in place, no stack buffer is used*/
 #define LV_TA_CUR_BLINK_TIME 400    /*ms*/
 #endif
 
@@ -150,6 +173,9 @@
 
 /*Gauge (dependencies: lv_rect, lv_label, lv_line, misc: trigo)*/
 #define USE_LV_GAUGE    1
+#if USE_LV_GAUGE != 0
+#define LV_GAUGE_CACHE_SIZE (256 * 1024)  /*Memory for the cached backgrounds and scales shared by the gauges [bytes] (0: no caching)*/
+#endif
 
 /*==================
  *  LV APP SETTINGS
@@ -195,6 +221,9 @@
 /* App. utility settings */
 #define LV_APP_NOTICE_SHOW_TIME 4000 /*Notices will be shown for this time [ms]*/
 #define LV_APP_NOTICE_MAX_LEN   256  /*Max. number of characters on a notice*/
+#define LV_APP_NOTICE_POOL_SIZE 4    /*Max. number of notices on the screen (pre-built message boxes)*/
+#define LV_APP_NOTICE_QUEUE_LEN 8    /*Max. number of notices waiting for a free message box (the further ones are dropped)*/
+#define LV_APP_NOTICE_PERIOD    100  /*Show at most one new notice in this time [ms]*/
 /*==================
  *  LV APP X USAGE 
  * ================*/
@@ -142,6 +142,9 @@ void lv_draw_label(const area_t * cords_p,const area_t * mask_p,
 
     /*Write out all lines*/
     while(txt[line_start] != '\0') {
+        /*The next lines are below the mask so no more work*/
+        if(pos.y > mask_p->y2) break;
+
         /*Write all letter of a line*/
         for(i = line_start; i < line_end; i++) {
         	letter_fp(&pos, mask_p, font_p, txt[i], labels_p->objs.color, opa);
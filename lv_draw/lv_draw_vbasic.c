@@ -333,6 +333,65 @@ void lv_vmap(const area_t * cords_p, const area_t * mask_p,
 }
 
 
+/**
+ * Draw a color map scaled to an area (the nearest map pixel is used)
+ * @param cords_p coordinates of the scaled map
+ * @param mask_p the map will drawn only on this area
+ * @param map_p pointer to a color_t array
+ * @param map_w width of the map in pixels
+ * @param map_h height of the map in pixels
+ * @param opa opacity of the map (0..255)
+ * @param transp true: enable transparency of LV_COLOR_TRANSP color pixels
+ */
+void lv_vmap_scale(const area_t * cords_p, const area_t * mask_p,
+                   const color_t * map_p, cord_t map_w, cord_t map_h, opa_t opa, bool transp)
+{
+    cord_t dst_w = area_get_width(cords_p);
+    cord_t dst_h = area_get_height(cords_p);
+    if(dst_w <= 0 || dst_h <= 0 || map_w <= 0 || map_h <= 0) return;
+
+    /*Not scaled: draw it as a normal map*/
+    if(dst_w == map_w && dst_h == map_h) {
+        lv_vmap(cords_p, mask_p, map_p, opa, transp, false, COLOR_BLACK, OPA_TRANSP);
+        return;
+    }
+
+    area_t masked_a;
+    lv_vdb_t * vdb_p = lv_vdb_get();
+    if(area_union(&masked_a, cords_p, mask_p) == false) return;
+
+    cord_t vdb_width = area_get_width(&vdb_p->vdb_area);
+    color_t * vdb_buf_tmp = vdb_p->buf;
+    vdb_buf_tmp += (uint32_t) vdb_width * (masked_a.y1 - vdb_p->vdb_area.y1);
+
+    color_t transp_color = LV_COLOR_TRANSP;
+    uint32_t x_ofs = masked_a.x1 - cords_p->x1;
+    cord_t vdb_x1 = vdb_p->vdb_area.x1;
+    cord_t row;
+    cord_t col;
+    for(row = masked_a.y1; row <= masked_a.y2; row++) {
+        const color_t * map_row = map_p + (uint32_t) map_w * (((uint32_t)(row - cords_p->y1) * map_h) / dst_h);
+
+        /*Step on the map row without division: 'map_x + err / dst_w' is the exact map position*/
+        cord_t map_x = (x_ofs * map_w) / dst_w;
+        uint32_t err = (x_ofs * map_w) % dst_w;
+        for(col = masked_a.x1; col <= masked_a.x2; col++) {
+            color_t c = map_row[map_x];
+            if(transp == false || c.full != transp_color.full) {
+                if(opa == OPA_COVER) vdb_buf_tmp[col - vdb_x1] = c;
+                else vdb_buf_tmp[col - vdb_x1] = color_mix(c, vdb_buf_tmp[col - vdb_x1], opa);
+            }
+
+            err += map_w;
+            while(err >= dst_w) {
+                err -= dst_w;
+                map_x++;
+            }
+        }
+
+        vdb_buf_tmp += vdb_width;   /*Next row on the VDB*/
+    }
+}
 
 /**********************
  *   STATIC FUNCTIONS
@@ -67,6 +67,19 @@ void lv_vmap(const area_t * cords_p, const area_t * mask_p,
             const color_t * map_p, opa_t opa, bool transp, bool upscale,
             color_t recolor, opa_t recolor_opa);
 
+/**
+ * Draw a color map scaled to an area (the nearest map pixel is used)
+ * @param cords_p coordinates of the scaled map
+ * @param mask_p the map will drawn only on this area
+ * @param map_p pointer to a color_t array
+ * @param map_w width of the map in pixels
+ * @param map_h height of the map in pixels
+ * @param opa opacity of the map (0..255)
+ * @param transp true: enable transparency of LV_COLOR_TRANSP color pixels
+ */
+void lv_vmap_scale(const area_t * cords_p, const area_t * mask_p,
+                   const color_t * map_p, cord_t map_w, cord_t map_h, opa_t opa, bool transp);
+
 
 
 /**********************
@@ -9,17 +9,25 @@
 #include <string.h>
 #include "anim.h"
 #include "misc/math/math_base.h"
-#include "misc/os/ptask.h"
 #include "hal/systick/systick.h"
+#include "slab.h"
 
 
 /*********************
  *      DEFINES
  *********************/
-#define ANIM_PATH_LENGTH		129	/*Elements in a path array*/
-#define ANIM_PATH_START			64  /*In path array a value which corresponds to the start position*/
-#define ANIM_PATH_END			192 /* ... to the end position. Not required, just for clearance.*/
-#define ANIM_PATH_NORM_SHIFT	7 	/*ANIM_PATH_START - ANIM_PATH_END. Must be 2^N. The exponent goes here. */
+#define ANIM_PATH_NORM_SHIFT	10 	/*ANIM_PATH_END - ANIM_PATH_START. Must be 2^N. The exponent goes here. */
+#define ANIM_PATH_DYN_FIRST     ANIM_PATH_EASE_IN /*The paths from here are calculated when first used*/
+#define ANIM_PATH_DYN_NUM       (ANIM_PATH_SPRING - ANIM_PATH_DYN_FIRST + 1)
+
+/*Test configurations*/
+#ifndef LV_ANIM_MAX_STEP
+#define LV_ANIM_MAX_STEP    (3 * LV_REFR_PERIOD)
+#endif
+
+#ifndef LV_ANIM_VAR_SLOTS
+#define LV_ANIM_VAR_SLOTS   32
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,31 +36,45 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void anim_task (void * param);
+static int32_t anim_path_bezier_calc(int32_t u, int32_t p1, int32_t p2);
 static bool anim_ready_handler(anim_t * a);
+static void anim_rem(anim_t * a);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-static ll_dsc_t anim_ll;
-static uint32_t last_task_run;
+static anim_t * anim_first;		/*Head of the list of all animations*/
+static anim_t * anim_var_slot[LV_ANIM_VAR_SLOTS];	/*The animations indexed by their variable*/
 static bool anim_del_global_flag = false;
 
+static anim_path_t * anim_path_dyn[ANIM_PATH_DYN_NUM];
+
 static anim_path_t anim_path_lin[] =
-		{64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,  94,  95,
-		 96,  97,  98,  99,  100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
-		 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159,
-		 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192};
+		{0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120,
+		 128, 136, 144, 152, 160, 168, 176, 184, 192, 200, 208, 216, 224, 232, 240, 248,
+		 256, 264, 272, 280, 288, 296, 304, 312, 320, 328, 336, 344, 352, 360, 368, 376,
+		 384, 392, 400, 408, 416, 424, 432, 440, 448, 456, 464, 472, 480, 488, 496, 504,
+		 512, 520, 528, 536, 544, 552, 560, 568, 576, 584, 592, 600, 608, 616, 624, 632,
+		 640, 648, 656, 664, 672, 680, 688, 696, 704, 712, 720, 728, 736, 744, 752, 760,
+		 768, 776, 784, 792, 800, 808, 816, 824, 832, 840, 848, 856, 864, 872, 880, 888,
+		 896, 904, 912, 920, 928, 936, 944, 952, 960, 968, 976, 984, 992, 1000, 1008, 1016,
+		 1024};
 
 static anim_path_t anim_path_step[] =
-		{64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-		 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-         64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-         64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 192,};
+		{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		 1024};
 
 /**********************
  *      MACROS
  **********************/
+#define ANIM_VAR_SLOT(var) (&anim_var_slot[((uintptr_t)(var) >> 3) & (LV_ANIM_VAR_SLOTS - 1)])
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -63,9 +85,74 @@ static anim_path_t anim_path_step[] =
  */
 void anim_init(void)
 {
-	ll_init(&anim_ll, sizeof(anim_t));
-	last_task_run = systick_get();
-	ptask_create(anim_task, LV_REFR_PERIOD, PTASK_PRIO_MID, NULL);
+	anim_first = NULL;
+	memset(anim_var_slot, 0, sizeof(anim_var_slot));
+}
+
+/**
+ * Step all animations. Called by the screen refresh task right before the redrawing
+ * so the values of all animations are set in one batch for every frame.
+ */
+void anim_handler(void)
+{
+	uint32_t now = systick_get();
+
+	anim_t * a;
+	anim_t * a_next;
+	a = anim_first;
+	while(a != NULL) {
+		/*'a' might be deleted, so get the next object while 'a' is valid*/
+		a_next = a->next;
+
+		/* Every animation measures its own time (e.g. a new animation starts from its creation)
+		 * and doesn't jump more than 'LV_ANIM_MAX_STEP' if a frame is late.
+		 * The delay is not limited because the refresh might sleep until its end.*/
+		uint32_t elaps = now - a->last_tick;
+#if LV_ANIM_MAX_STEP != 0
+		uint32_t max_step = LV_ANIM_MAX_STEP;
+		if(a->act_time < 0) max_step += -a->act_time;
+		if(elaps > max_step) elaps = max_step;
+#endif
+		a->last_tick = now;
+
+		a->act_time += elaps;
+		if(a->act_time >= 0) {
+			if(a->act_time > a->time) a->act_time = a->time;
+
+			/* Get the position in the path array based on the elapsed time.
+			 * Interpolate between the elements with 8 bit fraction.*/
+			int32_t path_v;
+			if(a->time == a->act_time) {
+				path_v = a->path[ANIM_PATH_LENGTH - 1]; /*Use the last value if the time fully elapsed*/
+			} else {
+				uint32_t pos = ((uint32_t)a->act_time * ((ANIM_PATH_LENGTH - 1) << 8)) / a->time;
+				uint32_t path_i = pos >> 8;
+				int32_t frac = pos & 0xFF;
+				path_v = a->path[path_i];
+				path_v += ((a->path[path_i + 1] - path_v) * frac) >> 8;
+			}
+
+			/* Get the new value which will be proportional to the path value
+			 * and the 'start' and 'end' values*/
+			int32_t new_val;
+			new_val =  (int32_t)(path_v - ANIM_PATH_START) * (a->end - a->start);
+			new_val = new_val >> ANIM_PATH_NORM_SHIFT;
+			new_val += a->start;
+
+			if(a->fp != NULL) a->fp(a->var, new_val);	/*Apply the calculated value*/
+
+			/*If the time is elapsed the animation is ready*/
+			if(a->act_time >= a->time) {
+				bool invalid;
+				invalid = anim_ready_handler(a);
+				if(invalid != false) {
+					a_next = anim_first;	/*a_next might be invalid if animation delete occurred*/
+				}
+			}
+		}
+
+		a = a_next;
+	}
 }
 
 /**
@@ -74,14 +161,25 @@ void anim_init(void)
  */
 void anim_create(anim_t * anim_p)
 {
-	/*Add the new animation to the animation linked list*/
-	anim_t * new_anim = ll_ins_head(&anim_ll);
+	anim_t * new_anim = slab_alloc(sizeof(anim_t));
 	dm_assert(new_anim);
 
 	/*Initialize the animation descriptor*/
 	anim_p->playback_now = 0;
+	anim_p->last_tick = systick_get();
 	memcpy(new_anim, anim_p, sizeof(anim_t));
 
+	/*Add the new animation to the head of the list (the handler will step it from the next frame)*/
+	new_anim->prev = NULL;
+	new_anim->next = anim_first;
+	if(anim_first != NULL) anim_first->prev = new_anim;
+	anim_first = new_anim;
+
+	/*Add it to the slot of its variable too*/
+	anim_t ** slot = ANIM_VAR_SLOT(new_anim->var);
+	new_anim->var_next = *slot;
+	*slot = new_anim;
+
 	/*Set the start value*/
 	if(new_anim->fp != NULL) new_anim->fp(new_anim->var, new_anim->start);
 }
@@ -98,14 +196,15 @@ bool anim_del(void * var, anim_fp_t fp)
 	bool del = false;
 	anim_t * a;
 	anim_t * a_next;
-	a = ll_get_head(&anim_ll);
+
+	/*Only the animations in the slot of 'var' can animate it*/
+	a = *ANIM_VAR_SLOT(var);
 	while(a != NULL) {
 		/*'a' might be deleted, so get the next object while 'a' is valid*/
-		a_next = ll_get_next(&anim_ll, a);
+		a_next = a->var_next;
 
 		if(a->var == var && (a->fp == fp || fp == NULL)) {
-			ll_rem(&anim_ll, a);
-			dm_free(a);
+			anim_rem(a);
 			del = true;
 			anim_del_global_flag = true;
 		}
@@ -116,6 +215,45 @@ bool anim_del(void * var, anim_fp_t fp)
 	return del;
 }
 
+/**
+ * Get an animation of a variable with a given animator function
+ * @param var pointer to variable
+ * @param fp a function pointer which is animating 'var',
+ *           or NULL to ignore it and get any animation of 'var'
+ * @return pointer to the animation or NULL if 'var' is not animated
+ */
+anim_t * anim_get(void * var, anim_fp_t fp)
+{
+	anim_t * a;
+	for(a = *ANIM_VAR_SLOT(var); a != NULL; a = a->var_next) {
+		if(a->var == var && (a->fp == fp || fp == NULL)) return a;
+	}
+
+	return NULL;
+}
+
+/**
+ * Get the time until an animation changes a value
+ * @return 0: an animation is running, time in milliseconds until the first delay ends
+ *         or UINT32_MAX if there are no animations
+ */
+uint32_t anim_get_sleep_time(void)
+{
+	uint32_t now = systick_get();
+	uint32_t t = UINT32_MAX;
+	anim_t * a;
+	for(a = anim_first; a != NULL; a = a->next) {
+		if(a->act_time >= 0) return 0;
+
+		uint32_t elaps = now - a->last_tick;
+		uint32_t delay = -a->act_time;
+		if(elaps >= delay) return 0;
+		if(delay - elaps < t) t = delay - elaps;
+	}
+
+	return t;
+}
+
 /**
  * Calculate the time of an animation with a given speed and the start and end values
  * @param speed speed of animation in unit/sec
@@ -142,72 +280,119 @@ uint16_t anim_speed_to_time(uint16_t speed, int32_t start, int32_t end)
  */
 anim_path_t * anim_get_path(anim_path_name_t name)
 {
-	switch (name) {
-		case ANIM_PATH_LIN:
-			return anim_path_lin;
+	if(name == ANIM_PATH_LIN) return anim_path_lin;
+	if(name == ANIM_PATH_STEP) return anim_path_step;
+	if(name < ANIM_PATH_DYN_FIRST || name > ANIM_PATH_SPRING) return NULL;
+
+	/*Calculate the other paths only when they are used first*/
+	anim_path_t ** dyn = &anim_path_dyn[name - ANIM_PATH_DYN_FIRST];
+	if(*dyn != NULL) return *dyn;
+
+	*dyn = dm_alloc(ANIM_PATH_LENGTH * sizeof(anim_path_t));
+	dm_assert(*dyn);
+
+	switch(name) {
+		case ANIM_PATH_EASE_IN:
+			anim_path_bezier(*dyn, 430, 0, 1024, 1024);		/*0.42, 0, 1, 1*/
+			break;
+		case ANIM_PATH_EASE_OUT:
+			anim_path_bezier(*dyn, 0, 0, 594, 1024);		/*0, 0, 0.58, 1*/
 			break;
-		case ANIM_PATH_STEP:
-			return anim_path_step;
+		case ANIM_PATH_EASE_IN_OUT:
+			anim_path_bezier(*dyn, 430, 0, 594, 1024);		/*0.42, 0, 0.58, 1*/
+			break;
+		case ANIM_PATH_OVERSHOOT:
+			anim_path_bezier(*dyn, 348, 1597, 655, 1024);	/*0.34, 1.56, 0.64, 1*/
 			break;
 		default:
-			return NULL;
+			anim_path_spring(*dyn, 200, 12);
 			break;
 	}
+
+	return *dyn;
 }
-/**********************
- *   STATIC FUNCTIONS
- **********************/
 
 /**
- * Periodically handle the animations.
- * @param param unused
+ * Fill a path array with a cubic bezier curve (the same as the CSS 'cubic-bezier()').
+ * The first and last control points are (0;0) and (ANIM_PATH_END;ANIM_PATH_END)
+ * @param path an array with ANIM_PATH_LENGTH elements
+ * @param x1 x coordinate of the second control point (ANIM_PATH_START..ANIM_PATH_END)
+ * @param y1 y coordinate of the second control point (can be out of the range to overshoot)
+ * @param x2 x coordinate of the third control point (ANIM_PATH_START..ANIM_PATH_END)
+ * @param y2 y coordinate of the third control point (can be out of the range to overshoot)
  */
-static void anim_task (void * param)
+void anim_path_bezier(anim_path_t * path, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
 {
-	uint32_t elaps;
-	elaps = systick_elaps(last_task_run);
+	uint16_t i;
+	for(i = 0; i < ANIM_PATH_LENGTH; i++) {
+		/*The time (x) of the element*/
+		int32_t x = (i * ANIM_PATH_END) / (ANIM_PATH_LENGTH - 1);
+
+		/*Search the curve parameter for 'x' with bisection (x is monotonic on the curve)*/
+		int32_t u_min = 0;
+		int32_t u_max = ANIM_PATH_END;
+		while(u_max - u_min > 1) {
+			int32_t u = (u_min + u_max) >> 1;
+			if(anim_path_bezier_calc(u, x1, x2) < x) u_min = u;
+			else u_max = u;
+		}
 
-	anim_t * a;
-	anim_t * a_next;
-	a = ll_get_head(&anim_ll);
-	while(a != NULL) {
-		/*'a' might be deleted, so get the next object while 'a' is valid*/
-		a_next = ll_get_next(&anim_ll, a);
+		path[i] = anim_path_bezier_calc(u_max, y1, y2);
+	}
 
-		a->act_time += elaps;
-		if(a->act_time >= 0) {
-			if(a->act_time > a->time) a->act_time = a->time;
+	path[0] = ANIM_PATH_START;
+	path[ANIM_PATH_LENGTH - 1] = ANIM_PATH_END;
+}
 
-			/* Get the index of the path array based on the elapsed time*/
-			uint8_t path_i;
-			if(a->time == a->act_time) {
-                path_i = ANIM_PATH_LENGTH - 1; /*Use the last value id the time fully elapsed*/
-			} else {
-                path_i = a->act_time * (ANIM_PATH_LENGTH - 1) / a->time;
-			}
-			/* Get the new value which will be proportional to the current element of 'path_p'
-			 * and the 'start' and 'end' values*/
-			int32_t new_val;
-			new_val =  (int32_t)(a->path[path_i] - ANIM_PATH_START) * (a->end - a->start);
-			new_val = new_val >> ANIM_PATH_NORM_SHIFT;
-			new_val += a->start;
+/**
+ * Fill a path array with the movement of a damped spring released from the start position.
+ * The last element is always the end position.
+ * @param path an array with ANIM_PATH_LENGTH elements
+ * @param stiffness stiffness of the spring (e.g. 200, higher: faster, more oscillation)
+ * @param damping damping of the spring (e.g. 12, higher: less oscillation)
+ */
+void anim_path_spring(anim_path_t * path, uint16_t stiffness, uint16_t damping)
+{
+	/* Simulate the spring with 4 steps between the elements (semi-implicit Euler).
+	 * The position and the velocity are stored with 6 bit fraction.
+	 * The whole animation time is 1 unit time.*/
+	int32_t x = 0;
+	int32_t v = 0;
+	int32_t x_end = ANIM_PATH_END << 6;
+	uint16_t i;
+	uint8_t s;
+	for(i = 0; i < ANIM_PATH_LENGTH; i++) {
+		path[i] = x >> 6;
+		for(s = 0; s < 4; s++) {
+			int32_t acc = stiffness * (x_end - x) - damping * v;
+			v += acc / (4 * (ANIM_PATH_LENGTH - 1));
+			x += v / (4 * (ANIM_PATH_LENGTH - 1));
+		}
+	}
 
-			if(a->fp != NULL) a->fp(a->var, new_val);	/*Apply the calculated value*/
+	path[ANIM_PATH_LENGTH - 1] = ANIM_PATH_END;
+}
 
-			/*If the time is elapsed the animation is ready*/
-			if(a->act_time >= a->time) {
-				bool invalid;
-				invalid = anim_ready_handler(a);
-				if(invalid != false) {
-					a_next = ll_get_head(&anim_ll);	/*a_next might be invalid if animation delete occurred*/
-				}
-			}
-		}
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
 
-		a = a_next;
-	}
+/**
+ * Calculate a coordinate of a cubic bezier curve with (0;0) and (ANIM_PATH_END;ANIM_PATH_END) end points
+ * @param u the curve parameter (0..ANIM_PATH_END)
+ * @param p1 the coordinate of the second control point
+ * @param p2 the coordinate of the third control point
+ * @return the coordinate on the curve
+ */
+static int32_t anim_path_bezier_calc(int32_t u, int32_t p1, int32_t p2)
+{
+	/*B(u) = 3(1-u)^2 u p1 + 3(1-u) u^2 p2 + u^3 in ANIM_PATH_NORM_SHIFT bit fixed point*/
+	int32_t rem = ANIM_PATH_END - u;
+	int32_t t1 = (((3 * rem * rem) >> ANIM_PATH_NORM_SHIFT) * u) >> ANIM_PATH_NORM_SHIFT;
+	int32_t t2 = (((3 * rem * u) >> ANIM_PATH_NORM_SHIFT) * u) >> ANIM_PATH_NORM_SHIFT;
+	int32_t t3 = (((u * u) >> ANIM_PATH_NORM_SHIFT) * u) >> ANIM_PATH_NORM_SHIFT;
 
-	last_task_run = systick_get();
+	return ((t1 * p1 + t2 * p2) >> ANIM_PATH_NORM_SHIFT) + t3;
 }
 
 /**
@@ -227,8 +412,7 @@ static bool anim_ready_handler(anim_t * a)
 	   (a->repeat == 0 && a->playback == 1 && a->playback_now == 1)) {
 		void (*cb) (void *) = a->end_cb;
 		void * p = a->var;
-		ll_rem(&anim_ll, a);
-		dm_free(a);
+		anim_rem(a);
 
 		/*Call the callback function at the end*/
 		/* Check if an animation is deleted in the cb function
@@ -257,3 +441,20 @@ static bool anim_ready_handler(anim_t * a)
 
 	return invalid;
 }
+
+/**
+ * Remove an animation from the list and from the variable index, and free it
+ * @param a pointer to an animation descriptor
+ */
+static void anim_rem(anim_t * a)
+{
+	if(a->prev != NULL) a->prev->next = a->next;
+	else anim_first = a->next;
+	if(a->next != NULL) a->next->prev = a->prev;
+
+	anim_t ** i = ANIM_VAR_SLOT(a->var);
+	while(*i != a) i = &(*i)->var_next;
+	*i = a->var_next;
+
+	slab_free(a);
+}
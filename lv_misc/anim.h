@@ -14,6 +14,9 @@
 /*********************
  *      DEFINES
  *********************/
+#define ANIM_PATH_LENGTH		129	/*Elements in a path array*/
+#define ANIM_PATH_START			0   /*In path array a value which corresponds to the start position*/
+#define ANIM_PATH_END			1024 /* ... to the end position.*/
 
 /**********************
  *      TYPEDEFS
@@ -23,14 +26,19 @@ typedef enum
 {
 	ANIM_PATH_LIN,
 	ANIM_PATH_STEP,
+	ANIM_PATH_EASE_IN,
+	ANIM_PATH_EASE_OUT,
+	ANIM_PATH_EASE_IN_OUT,
+	ANIM_PATH_OVERSHOOT,
+	ANIM_PATH_SPRING,
 }anim_path_name_t;
 
-typedef uint8_t anim_path_t;
+typedef int16_t anim_path_t;
 
 typedef void (*anim_fp_t)(void *, int32_t);
 typedef void (*anim_cb_t)(void *);
 
-typedef struct
+typedef struct _anim_t
 {
 	void * var;						/*Variable to animate*/
 	anim_fp_t fp;	/*Animator function*/
@@ -46,6 +54,10 @@ typedef struct
 	uint8_t repeat :1;				/*Repeat the animation infinitely*/
 	/*Animation system use these - user shouldn't set*/
 	uint8_t playback_now :1;		/*Play back is in progress*/
+	uint32_t last_tick;				/*Time of the last step*/
+	struct _anim_t * next;			/*Next animation in the list of all animations*/
+	struct _anim_t * prev;			/*Previous animation in the list of all animations*/
+	struct _anim_t * var_next;		/*Next animation in the same slot of the variable index*/
 }anim_t;
 
 /**********************
@@ -57,6 +69,12 @@ typedef struct
  */
 void anim_init(void);
 
+/**
+ * Step all animations. Called by the screen refresh task right before the redrawing
+ * so the values of all animations are set in one batch for every frame.
+ */
+void anim_handler(void);
+
 /**
  * Create an animation
  * @param anim_p an initialized 'anim_t' variable. Not required after call.
@@ -72,6 +90,22 @@ void anim_create(anim_t * anim_p);
  */
 bool anim_del(void * var, anim_fp_t fp);
 
+/**
+ * Get an animation of a variable with a given animator function
+ * @param var pointer to variable
+ * @param fp a function pointer which is animating 'var',
+ *           or NULL to ignore it and get any animation of 'var'
+ * @return pointer to the animation or NULL if 'var' is not animated
+ */
+anim_t * anim_get(void * var, anim_fp_t fp);
+
+/**
+ * Get the time until an animation changes a value
+ * @return 0: an animation is running, time in milliseconds until the first delay ends
+ *         or UINT32_MAX if there are no animations
+ */
+uint32_t anim_get_sleep_time(void);
+
 /**
  * Calculate the time of an animation with a given speed and the start and end values
  * @param speed speed of animation in unit/sec
@@ -88,6 +122,26 @@ uint16_t anim_speed_to_time(uint16_t speed, int32_t start, int32_t end);
  */
 anim_path_t * anim_get_path(anim_path_name_t name);
 
+/**
+ * Fill a path array with a cubic bezier curve (the same as the CSS 'cubic-bezier()').
+ * The first and last control points are (0;0) and (ANIM_PATH_END;ANIM_PATH_END)
+ * @param path an array with ANIM_PATH_LENGTH elements
+ * @param x1 x coordinate of the second control point (ANIM_PATH_START..ANIM_PATH_END)
+ * @param y1 y coordinate of the second control point (can be out of the range to overshoot)
+ * @param x2 x coordinate of the third control point (ANIM_PATH_START..ANIM_PATH_END)
+ * @param y2 y coordinate of the third control point (can be out of the range to overshoot)
+ */
+void anim_path_bezier(anim_path_t * path, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+
+/**
+ * Fill a path array with the movement of a damped spring released from the start position.
+ * The last element is always the end position.
+ * @param path an array with ANIM_PATH_LENGTH elements
+ * @param stiffness stiffness of the spring (e.g. 200, higher: faster, more oscillation)
+ * @param damping damping of the spring (e.g. 12, higher: less oscillation)
+ */
+void anim_path_spring(anim_path_t * path, uint16_t stiffness, uint16_t damping);
+
 /**********************
  *      MACROS
  **********************/
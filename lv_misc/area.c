@@ -166,44 +166,13 @@ bool area_is_point_on(const area_t * a_p, const point_t * p_p)
  */
 bool area_is_on(const area_t * a1_p, const area_t * a2_p)
 {
-    /*Two area are on each other if... */
-    
-    point_t p;
-    /*a2 left-top corner is on a1*/
-    p.x = a2_p->x1;
-    p.y = a2_p->y1;
-    if(area_is_point_on(a1_p, &p)) return true;
-    
-    /*a2 right-top corner is on a1*/
-    p.x = a2_p->x1;
-    p.y = a2_p->y1;
-    if(area_is_point_on(a1_p, &p)) return true;
-    
-    /*a2 left-bottom corner is on a1*/
-    p.x = a2_p->x1;
-    p.y = a2_p->y2;
-    if(area_is_point_on(a1_p, &p)) return true;
-    
-    /*a2 right-bottom corner is on a1*/
-    p.x = a2_p->x2;
-    p.y = a2_p->y2;
-    if(area_is_point_on(a1_p, &p)) return true;
-    
-    /*a2 is horizontally bigger then a1 and covers it*/
-    if((a2_p->x1 <= a1_p->x1 && a2_p->x2 >= a1_p->x2) &&  /*a2 hor. cover a1?*/
-      ((a2_p->y1 <= a1_p->y1 && a2_p->y1 >= a1_p->y2) || /*upper edge is on a1?*/
-       (a2_p->y2 <= a1_p->y1 && a2_p->y2 >= a1_p->y2) ||/* or lower edge is on a1?*/
-       (a2_p->y1 <= a1_p->y1 && a2_p->y2 >= a1_p->y2))) /*or a2 vert bigger then a1*/     
-       return true;
-    
-    /*a2 is vertically bigger then a1 and covers it*/
-    if((a2_p->y1 <= a1_p->y1 && a2_p->y2 >= a1_p->y2) &&  /*a2 vert. cover a1?*/
-      ((a2_p->x1 <= a1_p->x1 && a2_p->x1 >= a1_p->x2) || /*left edge is on a1?*/
-       (a2_p->x2 <= a1_p->x1 && a2_p->x2 >= a1_p->x2) ||/* or right edge is on a1?*/
-       (a2_p->x1 <= a1_p->x1 && a2_p->x2 >= a1_p->x2)))  /*or a2 hor. bigger then a1*/     
-        return true; 
-   
-    /*Else no cover*/
+    /*Two area are on each other if they overlap on both axes.
+     *(Checking only the corners misses the areas crossing each other)*/
+    if((a1_p->x1 <= a2_p->x2) && (a1_p->x2 >= a2_p->x1) &&
+       (a1_p->y1 <= a2_p->y2) && (a1_p->y2 >= a2_p->y1)) {
+        return true;
+    }
+
     return false;
 }
 
@@ -0,0 +1,330 @@
+/**
+ * @file slab.c
+ * Size class based slab pools for small, frequently allocated blocks
+ * (object ext. data, isolated styles)
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "slab.h"
+#include <stddef.h>
+#include <string.h>
+#include "misc/mem/dyn_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_SLAB_BLOCK_NUM
+#define LV_SLAB_BLOCK_NUM   8   /*Number of blocks in a chunk*/
+#endif
+
+#define SLAB_CLASS_NUM  (sizeof(slab_class_size) / sizeof(slab_class_size[0]))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_SLAB_BLOCK_NUM != 0
+typedef struct _slab_chunk_t
+{
+    struct _slab_chunk_t * next;    /*Next chunk in the same size class*/
+    void * free_first;              /*First free block (the free blocks store the next free block)*/
+    uint8_t cls;                    /*Index of the size class*/
+    uint8_t used;                   /*Number of used blocks*/
+}slab_chunk_t;
+
+typedef struct
+{
+    slab_chunk_t * chunk;   /*Chunk of the block or NULL if allocated with dyn_mem directly*/
+}slab_hdr_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_SLAB_BLOCK_NUM != 0
+static slab_hdr_t * slab_get_hdr(void * p);
+static int16_t slab_get_class(uint32_t size);
+static slab_chunk_t * slab_chunk_create(uint8_t cls);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_SLAB_BLOCK_NUM != 0
+static const uint16_t slab_class_size[] = {16, 32, 48, 64, 96, 128, 192, 256};
+static slab_chunk_t * slab_chunks[SLAB_CLASS_NUM];
+static uint16_t slab_big_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+#define SLAB_BLOCK_SIZE(cls) (sizeof(slab_hdr_t) + slab_class_size[cls])
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_SLAB_BLOCK_NUM != 0
+
+/**
+ * Allocate a block from the slab pool of its size class.
+ * Too large blocks are allocated with dyn_mem directly.
+ * @param size size of the block in bytes
+ * @return pointer to the block or NULL if out of memory
+ */
+void * slab_alloc(uint32_t size)
+{
+    int16_t cls = slab_get_class(size);
+    slab_hdr_t * hdr;
+
+    /*Too large for the classes: allocate it directly*/
+    if(cls < 0) {
+        hdr = dm_alloc(sizeof(slab_hdr_t) + size);
+        if(hdr == NULL) return NULL;
+        hdr->chunk = NULL;
+        slab_big_cnt++;
+        return hdr + 1;
+    }
+
+    /*Find a chunk with a free block or create a new one*/
+    slab_chunk_t * chunk = slab_chunks[cls];
+    while(chunk != NULL && chunk->free_first == NULL) chunk = chunk->next;
+
+    if(chunk == NULL) {
+        chunk = slab_chunk_create(cls);
+        if(chunk == NULL) return NULL;
+    }
+
+    void * p = chunk->free_first;
+    memcpy(&chunk->free_first, p, sizeof(void *));
+    chunk->used++;
+
+    return p;
+}
+
+/**
+ * Reallocate a block. The block is kept if the new size fits into its size class.
+ * @param p pointer to a block (a return value of 'slab_alloc') or NULL
+ * @param size the new size in bytes
+ * @return pointer to the block (the content is kept) or NULL if out of memory
+ */
+void * slab_realloc(void * p, uint32_t size)
+{
+    if(p == NULL) return slab_alloc(size);
+
+    uint32_t size_old = slab_get_size(p);
+    slab_hdr_t * hdr = slab_get_hdr(p);
+
+    /*Keep the block if it is still in the best class*/
+    if(hdr->chunk != NULL && slab_get_class(size) == hdr->chunk->cls) return p;
+
+    /*Large blocks remain large: let dyn_mem handle them*/
+    if(hdr->chunk == NULL && slab_get_class(size) < 0) {
+        hdr = dm_realloc(hdr, sizeof(slab_hdr_t) + size);
+        if(hdr == NULL) return NULL;
+        return hdr + 1;
+    }
+
+    void * p_new = slab_alloc(size);
+    if(p_new == NULL) return NULL;
+
+    memcpy(p_new, p, size_old < size ? size_old : size);
+    slab_free(p);
+
+    return p_new;
+}
+
+/**
+ * Free a block. Chunks which become empty are kept until 'slab_trim'.
+ * @param p pointer to a block (a return value of 'slab_alloc') or NULL
+ */
+void slab_free(void * p)
+{
+    if(p == NULL) return;
+
+    slab_hdr_t * hdr = slab_get_hdr(p);
+    slab_chunk_t * chunk = hdr->chunk;
+
+    if(chunk == NULL) {
+        slab_big_cnt--;
+        dm_free(hdr);
+        return;
+    }
+
+    memcpy(p, &chunk->free_first, sizeof(void *));
+    chunk->free_first = p;
+    chunk->used--;
+}
+
+/**
+ * Get the usable size of a block
+ * @param p pointer to a block (a return value of 'slab_alloc')
+ * @return the usable size of the block in bytes
+ */
+uint32_t slab_get_size(void * p)
+{
+    slab_hdr_t * hdr = slab_get_hdr(p);
+
+    if(hdr->chunk == NULL) return dm_get_size(hdr) - sizeof(slab_hdr_t);
+
+    return slab_class_size[hdr->chunk->cls];
+}
+
+/**
+ * Give back the empty chunks to dyn_mem. One empty chunk is kept in every size class
+ * to avoid allocating it again immediately.
+ */
+void slab_trim(void)
+{
+    uint8_t cls;
+    for(cls = 0; cls < SLAB_CLASS_NUM; cls++) {
+        bool keep = true;
+        slab_chunk_t ** i = &slab_chunks[cls];
+        while(*i != NULL) {
+            slab_chunk_t * chunk = *i;
+            if(chunk->used == 0 && keep == false) {
+                *i = chunk->next;
+                dm_free(chunk);
+            } else {
+                if(chunk->used == 0) keep = false;
+                i = &chunk->next;
+            }
+        }
+    }
+}
+
+/**
+ * Give information about the slab pools
+ * @param mon pointer to a slab_mon_t variable to store the result
+ */
+void slab_monitor(slab_mon_t * mon)
+{
+    memset(mon, 0, sizeof(slab_mon_t));
+
+    uint32_t size_part = 0;     /*Size of the non-empty chunks*/
+    uint32_t free_part = 0;     /*Free blocks in the non-empty chunks*/
+    uint8_t cls;
+    for(cls = 0; cls < SLAB_CLASS_NUM; cls++) {
+        uint32_t chunk_size = sizeof(slab_chunk_t) + SLAB_BLOCK_SIZE(cls) * LV_SLAB_BLOCK_NUM;
+        uint32_t blk_size = SLAB_BLOCK_SIZE(cls);
+        slab_chunk_t * chunk;
+        for(chunk = slab_chunks[cls]; chunk != NULL; chunk = chunk->next) {
+            uint32_t free_size = (LV_SLAB_BLOCK_NUM - chunk->used) * blk_size;
+            mon->chunk_cnt++;
+            mon->size_total += chunk_size;
+            mon->size_free += free_size;
+            mon->blk_used += chunk->used;
+
+            if(chunk->used == 0) {
+                mon->chunk_empty++;
+            } else {
+                size_part += chunk_size;
+                free_part += free_size;
+            }
+        }
+    }
+
+    mon->big_cnt = slab_big_cnt;
+    if(size_part != 0) mon->pct_frag = (free_part * 100) / size_part;
+}
+
+#else /*LV_SLAB_BLOCK_NUM == 0: use dyn_mem directly*/
+
+void * slab_alloc(uint32_t size)
+{
+    return dm_alloc(size);
+}
+
+void * slab_realloc(void * p, uint32_t size)
+{
+    return dm_realloc(p, size);
+}
+
+void slab_free(void * p)
+{
+    if(p != NULL) dm_free(p);
+}
+
+uint32_t slab_get_size(void * p)
+{
+    return dm_get_size(p);
+}
+
+void slab_trim(void)
+{
+
+}
+
+void slab_monitor(slab_mon_t * mon)
+{
+    memset(mon, 0, sizeof(slab_mon_t));
+}
+
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_SLAB_BLOCK_NUM != 0
+
+/**
+ * Get the header of a block
+ * @param p pointer to a block
+ * @return pointer to the header of 'p'
+ */
+static slab_hdr_t * slab_get_hdr(void * p)
+{
+    return (slab_hdr_t *)p - 1;
+}
+
+/**
+ * Get the smallest size class which can store a block
+ * @param size size of the block in bytes
+ * @return index of the size class or -1 if the block is too large for the classes
+ */
+static int16_t slab_get_class(uint32_t size)
+{
+    uint8_t cls;
+    for(cls = 0; cls < SLAB_CLASS_NUM; cls++) {
+        if(size <= slab_class_size[cls]) return cls;
+    }
+
+    return -1;
+}
+
+/**
+ * Allocate a new chunk for a size class and add it to the head of the class
+ * @param cls index of the size class
+ * @return pointer to the new chunk or NULL if out of memory
+ */
+static slab_chunk_t * slab_chunk_create(uint8_t cls)
+{
+    uint32_t blk_size = SLAB_BLOCK_SIZE(cls);
+    slab_chunk_t * chunk = dm_alloc(sizeof(slab_chunk_t) + blk_size * LV_SLAB_BLOCK_NUM);
+    if(chunk == NULL) return NULL;
+
+    chunk->cls = cls;
+    chunk->used = 0;
+    chunk->free_first = NULL;
+
+    /*Link all blocks into the free list. The first block will be the head.*/
+    uint8_t * blk = (uint8_t *)(chunk + 1) + blk_size * (LV_SLAB_BLOCK_NUM - 1);
+    uint16_t i;
+    for(i = 0; i < LV_SLAB_BLOCK_NUM; i++) {
+        slab_hdr_t * hdr = (slab_hdr_t *)blk;
+        hdr->chunk = chunk;
+        memcpy(hdr + 1, &chunk->free_first, sizeof(void *));
+        chunk->free_first = hdr + 1;
+        blk -= blk_size;
+    }
+
+    chunk->next = slab_chunks[cls];
+    slab_chunks[cls] = chunk;
+
+    return chunk;
+}
+
+#endif
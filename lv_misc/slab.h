@@ -0,0 +1,84 @@
+/**
+ * @file slab.h
+ * Size class based slab pools for small, frequently allocated blocks
+ * (object ext. data, isolated styles)
+ */
+
+#ifndef SLAB_H
+#define SLAB_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    uint32_t size_total;    /*Size of all chunks in bytes*/
+    uint32_t size_free;     /*Size of the free blocks in the chunks in bytes*/
+    uint16_t chunk_cnt;     /*Number of chunks*/
+    uint16_t chunk_empty;   /*Number of chunks without used blocks*/
+    uint16_t blk_used;      /*Number of used blocks in the chunks*/
+    uint16_t big_cnt;       /*Number of blocks allocated directly from dyn_mem (too large for a class)*/
+    uint8_t pct_frag;       /*Free part of the non-empty chunks [%]*/
+}slab_mon_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Allocate a block from the slab pool of its size class.
+ * Too large blocks are allocated with dyn_mem directly.
+ * @param size size of the block in bytes
+ * @return pointer to the block or NULL if out of memory
+ */
+void * slab_alloc(uint32_t size);
+
+/**
+ * Reallocate a block. The block is kept if the new size fits into its size class.
+ * @param p pointer to a block (a return value of 'slab_alloc') or NULL
+ * @param size the new size in bytes
+ * @return pointer to the block (the content is kept) or NULL if out of memory
+ */
+void * slab_realloc(void * p, uint32_t size);
+
+/**
+ * Free a block. Chunks which become empty are kept until 'slab_trim'.
+ * @param p pointer to a block (a return value of 'slab_alloc') or NULL
+ */
+void slab_free(void * p);
+
+/**
+ * Get the usable size of a block
+ * @param p pointer to a block (a return value of 'slab_alloc')
+ * @return the usable size of the block in bytes
+ */
+uint32_t slab_get_size(void * p);
+
+/**
+ * Give back the empty chunks to dyn_mem. One empty chunk is kept in every size class
+ * to avoid allocating it again immediately.
+ */
+void slab_trim(void);
+
+/**
+ * Give information about the slab pools
+ * @param mon pointer to a slab_mon_t variable to store the result
+ */
+void slab_monitor(slab_mon_t * mon);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif
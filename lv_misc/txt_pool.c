@@ -0,0 +1,140 @@
+/**
+ * @file txt_pool.c
+ * Pool of shared, reference counted texts
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "txt_pool.h"
+#include <stddef.h>
+#include <string.h>
+#include "misc/mem/dyn_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_TXT_POOL_SIZE
+#define LV_TXT_POOL_SIZE    32  /*Number of hash slots*/
+#endif
+
+#if LV_TXT_POOL_SIZE != 0
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _txt_pool_node_t
+{
+    struct _txt_pool_node_t * next; /*Next node in the same hash slot*/
+    uint32_t hash;                  /*Hash of the text*/
+    uint16_t ref_cnt;               /*Number of users of the text*/
+    char txt[];                     /*The '\0' terminated text*/
+}txt_pool_node_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t txt_pool_hash(const char * txt, uint32_t len);
+static txt_pool_node_t * txt_pool_get_node(const char * txt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static txt_pool_node_t * slots[LV_TXT_POOL_SIZE];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get a shared text from the pool. If the same text is already in the pool
+ * only its reference counter is incremented, else it is copied into the pool.
+ * @param txt pointer to a text (it doesn't have to be '\0' terminated)
+ * @param len number of characters in 'txt'
+ * @return pointer to the '\0' terminated shared text (don't modify it) or NULL if out of memory
+ */
+const char * txt_pool_get(const char * txt, uint32_t len)
+{
+    uint32_t hash = txt_pool_hash(txt, len);
+    txt_pool_node_t ** slot = &slots[hash % LV_TXT_POOL_SIZE];
+
+    /*Search the text in its slot*/
+    txt_pool_node_t * node;
+    for(node = *slot; node != NULL; node = node->next) {
+        if(node->hash == hash && node->ref_cnt < UINT16_MAX &&
+           strncmp(node->txt, txt, len) == 0 && node->txt[len] == '\0') {
+            node->ref_cnt++;
+            return node->txt;
+        }
+    }
+
+    /*Not found so add a new node*/
+    node = dm_alloc(sizeof(txt_pool_node_t) + len + 1);
+    if(node == NULL) return NULL;
+
+    memcpy(node->txt, txt, len);
+    node->txt[len] = '\0';
+    node->hash = hash;
+    node->ref_cnt = 1;
+    node->next = *slot;
+    *slot = node;
+
+    return node->txt;
+}
+
+/**
+ * Decrement the reference counter of a shared text and free it when not used any more
+ * @param txt pointer to a shared text (a return value of 'txt_pool_get')
+ */
+void txt_pool_release(const char * txt)
+{
+    txt_pool_node_t * node = txt_pool_get_node(txt);
+
+    node->ref_cnt--;
+    if(node->ref_cnt != 0) return;
+
+    /*Unlink the node from its slot and free it*/
+    txt_pool_node_t ** i = &slots[node->hash % LV_TXT_POOL_SIZE];
+    while(*i != node) i = &(*i)->next;
+    *i = node->next;
+
+    dm_free(node);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Calculate the hash of a text (FNV-1a)
+ * @param txt pointer to a text
+ * @param len number of characters in 'txt'
+ * @return the hash value
+ */
+static uint32_t txt_pool_hash(const char * txt, uint32_t len)
+{
+    uint32_t hash = 2166136261UL;
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        hash ^= (uint8_t)txt[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+/**
+ * Get the node of a shared text
+ * @param txt pointer to a shared text
+ * @return pointer to the node which contains 'txt'
+ */
+static txt_pool_node_t * txt_pool_get_node(const char * txt)
+{
+    return (txt_pool_node_t *)(txt - offsetof(txt_pool_node_t, txt));
+}
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file txt_pool.h
+ * Pool of shared, reference counted texts
+ */
+
+#ifndef TXT_POOL_H
+#define TXT_POOL_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get a shared text from the pool. If the same text is already in the pool
+ * only its reference counter is incremented, else it is copied into the pool.
+ * @param txt pointer to a text (it doesn't have to be '\0' terminated)
+ * @param len number of characters in 'txt'
+ * @return pointer to the '\0' terminated shared text (don't modify it) or NULL if out of memory
+ */
+const char * txt_pool_get(const char * txt, uint32_t len);
+
+/**
+ * Decrement the reference counter of a shared text and free it when not used any more
+ * @param txt pointer to a shared text (a return value of 'txt_pool_get')
+ */
+void txt_pool_release(const char * txt);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif
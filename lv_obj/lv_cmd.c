@@ -0,0 +1,416 @@
+/**
+ * @file lv_cmd.c
+ * Queue of object commands posted by other threads and applied by the GUI thread
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_cmd.h"
+#include <stddef.h>
+#include <string.h>
+#include "../lv_objx/lv_label.h"
+#include "../lv_objx/lv_chart.h"
+#include "../lv_objx/lv_pb.h"
+#include "../lv_objx/lv_led.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Test configurations*/
+#ifndef LV_CMD_QUEUE_SIZE
+#define LV_CMD_QUEUE_SIZE   16      /*Number of commands in the queue (must be 2^N, 0: disable)*/
+#endif
+
+/* Atomic compare and swap of an uint32_t: return true if '*p' was 'old' and 'new' is written.
+ * Define them in lv_conf.h if the compiler has no GCC built-ins*/
+#ifndef LV_CMD_CAS
+#define LV_CMD_CAS(p, old, new)     __sync_bool_compare_and_swap(p, old, new)
+#endif
+
+/*Full memory barrier*/
+#ifndef LV_CMD_BARRIER
+#define LV_CMD_BARRIER()            __sync_synchronize()
+#endif
+
+#if LV_CMD_QUEUE_SIZE & (LV_CMD_QUEUE_SIZE - 1)
+#error "LV: LV_CMD_QUEUE_SIZE must be a power of 2 (or 0)"
+#endif
+
+#define LV_CMD_MASK     (LV_CMD_QUEUE_SIZE - 1)
+#define LV_CMD_DEL_NUM  4   /*Max. number of remembered objects deleted while a command was being posted*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_CMD_QUEUE_SIZE != 0
+/* A cell of the queue. 'seq' tells the state of the cell:
+ * position: free to post into, position + 1: posted, position + LV_CMD_QUEUE_SIZE: applied (free in the next round)*/
+typedef struct
+{
+    volatile uint32_t seq;
+    uint8_t drop;       /*1: drop the command when it's published (set by the GUI thread)*/
+    lv_cmd_t cmd;
+}lv_cmd_cell_t;
+
+/* An object deleted while some cells were reserved but not published yet.
+ * The commands of these cells are dropped if they turn out to be for this object.*/
+typedef struct
+{
+    lv_obj_t * obj;     /*The deleted object or NULL if unused*/
+    uint32_t end;       /*Check the cells before this position*/
+}lv_cmd_del_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if USE_LV_LABEL != 0
+static void lv_cmd_label_set_text_exec(lv_obj_t * obj, const lv_cmd_t * cmd);
+#endif
+#if USE_LV_CHART != 0
+static void lv_cmd_chart_set_next_exec(lv_obj_t * obj, const lv_cmd_t * cmd);
+#endif
+#if USE_LV_PB != 0
+static void lv_cmd_pb_set_value_exec(lv_obj_t * obj, const lv_cmd_t * cmd);
+#endif
+#if USE_LV_LED != 0
+static void lv_cmd_led_set_bright_exec(lv_obj_t * obj, const lv_cmd_t * cmd);
+#endif
+#if LV_CMD_QUEUE_SIZE != 0
+static bool lv_cmd_is_deleted(const lv_obj_t * obj, uint32_t pos);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_CMD_QUEUE_SIZE != 0
+static lv_cmd_cell_t cmd_cells[LV_CMD_QUEUE_SIZE];
+static volatile uint32_t cmd_post_pos;      /*Next position to post (shared by the posting threads)*/
+static uint32_t cmd_apply_pos;              /*Next position to apply (used only by the GUI thread)*/
+static lv_cmd_del_t cmd_dels[LV_CMD_DEL_NUM];
+#endif
+static void (*cmd_lock_f)(void);
+static void (*cmd_unlock_f)(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the command queue
+ */
+void lv_cmd_init(void)
+{
+#if LV_CMD_QUEUE_SIZE != 0
+    uint32_t i;
+    for(i = 0; i < LV_CMD_QUEUE_SIZE; i++) {
+        cmd_cells[i].seq = i;
+        cmd_cells[i].drop = 0;
+    }
+    memset(cmd_dels, 0, sizeof(cmd_dels));
+    cmd_post_pos = 0;
+    cmd_apply_pos = 0;
+#endif
+    cmd_lock_f = NULL;
+    cmd_unlock_f = NULL;
+}
+
+/**
+ * Post a command from any thread (or interrupt). It will be applied in the GUI thread
+ * at the start of the next refresh, in the order of posting.
+ * @param exec function to apply the command
+ * @param obj pointer to the object to change. Must not be deleted while it has posted commands.
+ * @param ptr a free to use parameter (saved in 'cmd->ptr')
+ * @param num a free to use parameter (saved in 'cmd->num')
+ * @param txt a text to copy into 'cmd->txt' (cut to LV_CMD_TXT_LEN - 1 characters) or NULL
+ * @return true: the command is posted, false: the queue is full (try again later)
+ */
+bool lv_cmd_post(lv_cmd_exec_t exec, lv_obj_t * obj, void * ptr, int32_t num, const char * txt)
+{
+#if LV_CMD_QUEUE_SIZE != 0
+    /*Reserve a cell: the posting threads race only for 'cmd_post_pos'*/
+    lv_cmd_cell_t * cell;
+    uint32_t pos = cmd_post_pos;
+    while(1) {
+        cell = &cmd_cells[pos & LV_CMD_MASK];
+        int32_t dif = (int32_t)(cell->seq - pos);
+        if(dif == 0) {
+            if(LV_CMD_CAS(&cmd_post_pos, pos, pos + 1)) break;
+        } else if(dif < 0) {
+            return false;   /*The cell is not applied yet: the queue is full*/
+        }
+        pos = cmd_post_pos; /*An other thread took this position*/
+    }
+
+    cell->cmd.exec = exec;
+    cell->cmd.obj = obj;
+    cell->cmd.ptr = ptr;
+    cell->cmd.num = num;
+    cell->cmd.txt[0] = '\0';
+    if(txt != NULL) {
+        strncpy(cell->cmd.txt, txt, LV_CMD_TXT_LEN - 1);
+        cell->cmd.txt[LV_CMD_TXT_LEN - 1] = '\0';
+    }
+
+    /*Publish the command*/
+    LV_CMD_BARRIER();
+    cell->seq = pos + 1;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if USE_LV_LABEL != 0
+/**
+ * Post a 'lv_label_set_text' from any thread
+ * @param label pointer to a label object
+ * @param txt the new text (copied, max. LV_CMD_TXT_LEN - 1 characters)
+ * @return true: the command is posted, false: the queue is full
+ */
+bool lv_cmd_label_set_text(lv_obj_t * label, const char * txt)
+{
+    return lv_cmd_post(lv_cmd_label_set_text_exec, label, NULL, 0, txt);
+}
+#endif
+
+#if USE_LV_CHART != 0
+/**
+ * Post a 'lv_chart_set_next' from any thread
+ * @param chart pointer to a chart object
+ * @param dl pointer to a data line of the chart
+ * @param y the new value
+ * @return true: the command is posted, false: the queue is full
+ */
+bool lv_cmd_chart_set_next(lv_obj_t * chart, cord_t * dl, cord_t y)
+{
+    return lv_cmd_post(lv_cmd_chart_set_next_exec, chart, dl, y, NULL);
+}
+#endif
+
+#if USE_LV_PB != 0
+/**
+ * Post a 'lv_pb_set_value' from any thread
+ * @param pb pointer to a progress bar object
+ * @param value the new value
+ * @return true: the command is posted, false: the queue is full
+ */
+bool lv_cmd_pb_set_value(lv_obj_t * pb, uint16_t value)
+{
+    return lv_cmd_post(lv_cmd_pb_set_value_exec, pb, NULL, value, NULL);
+}
+#endif
+
+#if USE_LV_LED != 0
+/**
+ * Post a 'lv_led_set_bright' from any thread
+ * @param led pointer to a LED object
+ * @param bright the new brightness
+ * @return true: the command is posted, false: the queue is full
+ */
+bool lv_cmd_led_set_bright(lv_obj_t * led, uint8_t bright)
+{
+    return lv_cmd_post(lv_cmd_led_set_bright_exec, led, NULL, bright, NULL);
+}
+#endif
+
+/**
+ * Apply the posted commands. Called by the screen refresh task.
+ * The commands posted meanwhile are applied in the next call.
+ */
+void lv_cmd_handler(void)
+{
+#if LV_CMD_QUEUE_SIZE != 0
+    uint32_t cnt;
+    for(cnt = 0; cnt < LV_CMD_QUEUE_SIZE; cnt++) {
+        lv_cmd_cell_t * cell = &cmd_cells[cmd_apply_pos & LV_CMD_MASK];
+        if(cell->seq != cmd_apply_pos + 1) break;    /*Not posted (yet)*/
+
+        LV_CMD_BARRIER();
+        if(cell->drop == 0 && cell->cmd.obj != NULL && cell->cmd.exec != NULL &&
+           lv_cmd_is_deleted(cell->cmd.obj, cmd_apply_pos) == false) {
+            cell->cmd.exec(cell->cmd.obj, &cell->cmd);
+        }
+
+        /*Free the cell for the next round*/
+        cell->drop = 0;
+        LV_CMD_BARRIER();
+        cell->seq = cmd_apply_pos + LV_CMD_QUEUE_SIZE;
+        cmd_apply_pos++;
+    }
+
+    /*Forget the deleted objects when every cell reserved before their deletion is applied*/
+    uint8_t i;
+    for(i = 0; i < LV_CMD_DEL_NUM; i++) {
+        if(cmd_dels[i].obj != NULL && (int32_t)(cmd_apply_pos - cmd_dels[i].end) >= 0) cmd_dels[i].obj = NULL;
+    }
+#endif
+}
+
+/**
+ * Tell whether there are posted commands to apply
+ * @return true: there is at least one posted command
+ */
+bool lv_cmd_is_pending(void)
+{
+#if LV_CMD_QUEUE_SIZE != 0
+    return cmd_cells[cmd_apply_pos & LV_CMD_MASK].seq == cmd_apply_pos + 1;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Drop the posted commands of an object. Called when the object is deleted.
+ * The commands being posted meanwhile are dropped too when they are published.
+ * @param obj pointer to an object
+ */
+void lv_cmd_rem_obj(lv_obj_t * obj)
+{
+#if LV_CMD_QUEUE_SIZE != 0
+    /*The cells from 'cmd_apply_pos' to 'end' are reserved. Some of them can be still written.*/
+    uint32_t end = cmd_post_pos;
+    bool unpublished = false;
+    uint32_t pos;
+    for(pos = cmd_apply_pos; pos != end; pos++) {
+        lv_cmd_cell_t * cell = &cmd_cells[pos & LV_CMD_MASK];
+        if(cell->seq != pos + 1) {
+            unpublished = true;
+            continue;
+        }
+
+        LV_CMD_BARRIER();
+        if(cell->cmd.obj == obj) cell->cmd.obj = NULL;
+    }
+
+    if(unpublished == false) return;
+
+    /*Check the not published cells when they are applied*/
+    uint8_t i;
+    for(i = 0; i < LV_CMD_DEL_NUM; i++) {
+        if(cmd_dels[i].obj == NULL) {
+            cmd_dels[i].obj = obj;
+            cmd_dels[i].end = end;
+            return;
+        }
+    }
+
+    /*Too many deleted objects to remember: drop every not published command
+     *(check the cells published since the first scan again)*/
+    for(pos = cmd_apply_pos; pos != end; pos++) {
+        lv_cmd_cell_t * cell = &cmd_cells[pos & LV_CMD_MASK];
+        if(cell->seq != pos + 1) {
+            cell->drop = 1;
+            continue;
+        }
+
+        LV_CMD_BARRIER();
+        if(cell->cmd.obj == obj) cell->cmd.obj = NULL;
+    }
+#endif
+}
+
+/**
+ * Set the functions of a (recursive) mutex for direct access to the objects from more threads
+ * @param lock_f function to lock the mutex or NULL
+ * @param unlock_f function to unlock the mutex or NULL
+ */
+void lv_cmd_set_lock_f(void (*lock_f)(void), void (*unlock_f)(void))
+{
+    cmd_lock_f = lock_f;
+    cmd_unlock_f = unlock_f;
+}
+
+/**
+ * Lock the objects. The GUI thread should call 'ptask_handler' between 'lv_lock' and 'lv_unlock',
+ * the other threads can access the objects directly between them.
+ */
+void lv_lock(void)
+{
+    if(cmd_lock_f != NULL) cmd_lock_f();
+}
+
+/**
+ * Unlock the objects
+ */
+void lv_unlock(void)
+{
+    if(cmd_unlock_f != NULL) cmd_unlock_f();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_CMD_QUEUE_SIZE != 0
+/**
+ * Tell whether an object was deleted while a command was being posted to it
+ * @param obj pointer to an object
+ * @param pos position of the command
+ * @return true: the object is deleted (drop its command)
+ */
+static bool lv_cmd_is_deleted(const lv_obj_t * obj, uint32_t pos)
+{
+    uint8_t i;
+    for(i = 0; i < LV_CMD_DEL_NUM; i++) {
+        if(cmd_dels[i].obj == obj && (int32_t)(pos - cmd_dels[i].end) < 0) return true;
+    }
+
+    return false;
+}
+#endif
+
+#if USE_LV_LABEL != 0
+/**
+ * Apply a posted 'lv_label_set_text'
+ * @param obj pointer to a label object
+ * @param cmd the command with the text
+ */
+static void lv_cmd_label_set_text_exec(lv_obj_t * obj, const lv_cmd_t * cmd)
+{
+    lv_label_set_text(obj, cmd->txt);
+}
+#endif
+
+#if USE_LV_CHART != 0
+/**
+ * Apply a posted 'lv_chart_set_next'
+ * @param obj pointer to a chart object
+ * @param cmd the command with the data line and the value
+ */
+static void lv_cmd_chart_set_next_exec(lv_obj_t * obj, const lv_cmd_t * cmd)
+{
+    lv_chart_set_next(obj, cmd->ptr, cmd->num);
+}
+#endif
+
+#if USE_LV_PB != 0
+/**
+ * Apply a posted 'lv_pb_set_value'
+ * @param obj pointer to a progress bar object
+ * @param cmd the command with the value
+ */
+static void lv_cmd_pb_set_value_exec(lv_obj_t * obj, const lv_cmd_t * cmd)
+{
+    lv_pb_set_value(obj, cmd->num);
+}
+#endif
+
+#if USE_LV_LED != 0
+/**
+ * Apply a posted 'lv_led_set_bright'
+ * @param obj pointer to a LED object
+ * @param cmd the command with the brightness
+ */
+static void lv_cmd_led_set_bright_exec(lv_obj_t * obj, const lv_cmd_t * cmd)
+{
+    lv_led_set_bright(obj, cmd->num);
+}
+#endif
@@ -0,0 +1,143 @@
+/**
+ * @file lv_cmd.h
+ * Queue of object commands posted by other threads and applied by the GUI thread
+ */
+
+#ifndef LV_CMD_H
+#define LV_CMD_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Test configurations*/
+#ifndef LV_CMD_TXT_LEN
+#define LV_CMD_TXT_LEN      32      /*Max. length of the text of a command (with the closing '\0')*/
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_cmd_t;
+
+/*Apply a command on an object. Called in the GUI thread.*/
+typedef void (*lv_cmd_exec_t)(lv_obj_t * obj, const struct _lv_cmd_t * cmd);
+
+typedef struct _lv_cmd_t
+{
+    lv_cmd_exec_t exec;         /*Function to apply the command*/
+    lv_obj_t * obj;             /*The object to change (NULL if it was deleted meanwhile)*/
+    void * ptr;                 /*Free to use parameter*/
+    int32_t num;                /*Free to use parameter*/
+    char txt[LV_CMD_TXT_LEN];   /*Copy of the text parameter*/
+}lv_cmd_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the command queue
+ */
+void lv_cmd_init(void);
+
+/**
+ * Post a command from any thread (or interrupt). It will be applied in the GUI thread
+ * at the start of the next refresh, in the order of posting.
+ * @param exec function to apply the command
+ * @param obj pointer to the object to change. Must not be deleted while it has posted commands.
+ * @param ptr a free to use parameter (saved in 'cmd->ptr')
+ * @param num a free to use parameter (saved in 'cmd->num')
+ * @param txt a text to copy into 'cmd->txt' (cut to LV_CMD_TXT_LEN - 1 characters) or NULL
+ * @return true: the command is posted, false: the queue is full (try again later)
+ */
+bool lv_cmd_post(lv_cmd_exec_t exec, lv_obj_t * obj, void * ptr, int32_t num, const char * txt);
+
+#if USE_LV_LABEL != 0
+/**
+ * Post a 'lv_label_set_text' from any thread
+ * @param label pointer to a label object
+ * @param txt the new text (copied, max. LV_CMD_TXT_LEN - 1 characters)
+ * @return true: the command is posted, false: the queue is full
+ */
+bool lv_cmd_label_set_text(lv_obj_t * label, const char * txt);
+#endif
+
+#if USE_LV_CHART != 0
+/**
+ * Post a 'lv_chart_set_next' from any thread
+ * @param chart pointer to a chart object
+ * @param dl pointer to a data line of the chart
+ * @param y the new value
+ * @return true: the command is posted, false: the queue is full
+ */
+bool lv_cmd_chart_set_next(lv_obj_t * chart, cord_t * dl, cord_t y);
+#endif
+
+#if USE_LV_PB != 0
+/**
+ * Post a 'lv_pb_set_value' from any thread
+ * @param pb pointer to a progress bar object
+ * @param value the new value
+ * @return true: the command is posted, false: the queue is full
+ */
+bool lv_cmd_pb_set_value(lv_obj_t * pb, uint16_t value);
+#endif
+
+#if USE_LV_LED != 0
+/**
+ * Post a 'lv_led_set_bright' from any thread
+ * @param led pointer to a LED object
+ * @param bright the new brightness
+ * @return true: the command is posted, false: the queue is full
+ */
+bool lv_cmd_led_set_bright(lv_obj_t * led, uint8_t bright);
+#endif
+
+/**
+ * Apply the posted commands. Called by the screen refresh task.
+ * The commands posted meanwhile are applied in the next call.
+ */
+void lv_cmd_handler(void);
+
+/**
+ * Tell whether there are posted commands to apply
+ * @return true: there is at least one posted command
+ */
+bool lv_cmd_is_pending(void);
+
+/**
+ * Drop the posted commands of an object. Called when the object is deleted.
+ * The commands being posted meanwhile are dropped too when they are published.
+ * @param obj pointer to an object
+ */
+void lv_cmd_rem_obj(lv_obj_t * obj);
+
+/**
+ * Set the functions of a (recursive) mutex for direct access to the objects from more threads
+ * @param lock_f function to lock the mutex or NULL
+ * @param unlock_f function to unlock the mutex or NULL
+ */
+void lv_cmd_set_lock_f(void (*lock_f)(void), void (*unlock_f)(void));
+
+/**
+ * Lock the objects. The GUI thread should call 'ptask_handler' between 'lv_lock' and 'lv_unlock',
+ * the other threads can access the objects directly between them.
+ */
+void lv_lock(void);
+
+/**
+ * Unlock the objects
+ */
+void lv_unlock(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif
@@ -10,28 +10,69 @@
 
 #include "misc/os/ptask.h"
 #include "misc/math/math_base.h"
+#include "misc/mem/dyn_mem.h"
 #include "lv_dispi.h"
 #include "../lv_draw/lv_draw_rbasic.h"
 #include "hal/indev/indev.h"
 #include "hal/systick/systick.h"
 #include "lv_obj.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
+/*Test configurations*/
+#ifndef LV_DISPI_HIT_IDX_NUM
+#define LV_DISPI_HIT_IDX_NUM    4   /*Number of cached hit-test indexes (0: disable)*/
+#endif
+
+#ifndef LV_DISPI_HIT_IDX_MIN
+#define LV_DISPI_HIT_IDX_MIN    16  /*Build a hit-test index for objects with at least this many children*/
+#endif
+
+#ifndef LV_DISPI_IDLE_PERIOD
+#define LV_DISPI_IDLE_PERIOD    LV_DISPI_READ_PERIOD   /*Read period if nothing is pressed (0: wait for 'lv_dispi_wake')*/
+#endif
+
+#define LV_DISPI_HIT_GRID_MAX   16  /*Max. number of rows and columns of a hit-test index*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DISPI_HIT_IDX_NUM != 0
+/* Grid of the children of an object to find the children on a point quickly.
+ * The cells contain the indexes of the children in 'children' (top first).
+ * The grid is relative to the object so it remains valid when the object is moved (e.g. scrolling)*/
+typedef struct
+{
+    lv_obj_t * obj;             /*Index of this object's children (NULL: free slot)*/
+    area_t grid;                /*Area of the grid relative to 'obj'*/
+    cord_t cell_w;
+    cord_t cell_h;
+    uint8_t col_num;
+    uint8_t row_num;
+    lv_obj_t ** children;       /*The children in the order of 'child_ll'*/
+    uint16_t * cell_start;      /*Start of the cells in 'items' ('col_num * row_num + 1' element)*/
+    uint16_t * items;           /*Child indexes of the cells*/
+    uint32_t last_use;
+}dispi_hit_idx_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void dispi_task(void * param);
+static void dispi_set_period(uint32_t period);
 static void dispi_proc_point(lv_dispi_t * dispi_p, cord_t x, cord_t y);
 static void dispi_proc_press(lv_dispi_t * dispi_p);
 static void disi_proc_release(lv_dispi_t * dispi_p);
 static lv_obj_t * dispi_search_obj(const lv_dispi_t * dispi_p, lv_obj_t * obj);
+#if LV_DISPI_HIT_IDX_NUM != 0
+static dispi_hit_idx_t * dispi_hit_idx_get(lv_obj_t * obj);
+static dispi_hit_idx_t * dispi_hit_idx_build(lv_obj_t * obj);
+static void dispi_hit_idx_child_area(lv_obj_t * child, area_t * area);
+static void dispi_hit_idx_free(dispi_hit_idx_t * idx);
+#endif
 static void dispi_drag(lv_dispi_t * dispi_p);
 static void dispi_drag_throw(lv_dispi_t * dispi_p);
 
@@ -39,8 +80,15 @@ static void dispi_drag_throw(lv_dispi_t * dispi_p);
  *  STATIC VARIABLES
  **********************/
 static ptask_t* dispi_task_p;
+static uint32_t dispi_period;           /*Period of 'dispi_task_p' (tracked here because 'ptask_t' is private to misc)*/
+static uint32_t dispi_last_run;         /*Time of the last reading*/
+static volatile bool dispi_wake_qry;    /*Set by 'lv_dispi_wake' (maybe in an interrupt), applied in the task context*/
 static bool lv_dispi_reset_qry;
 static bool lv_dispi_reset_now;
+#if LV_DISPI_HIT_IDX_NUM != 0
+static dispi_hit_idx_t hit_idx[LV_DISPI_HIT_IDX_NUM];
+static uint32_t hit_idx_use_cnt;
+#endif
 
 /**********************
  *      MACROS
@@ -57,6 +105,9 @@ void lv_dispi_init(void)
 {
     lv_dispi_reset_qry = false;
     lv_dispi_reset_now = false;
+    dispi_period = LV_DISPI_READ_PERIOD;
+    dispi_last_run = systick_get();
+    dispi_wake_qry = false;
 
 #if LV_DISPI_READ_PERIOD != 0
     dispi_task_p = ptask_create(dispi_task, LV_DISPI_READ_PERIOD, PTASK_PRIO_MID, NULL);
@@ -73,6 +124,59 @@ void lv_dispi_reset(void)
     lv_dispi_reset_qry = true;
 }
 
+/**
+ * Read the display inputs as soon as possible and continue with the normal read period.
+ * Call it e.g. from a touch interrupt if LV_DISPI_IDLE_PERIOD is long or 0.
+ * It only sets a flag (interrupt safe). The reading is started by the next
+ * 'lv_dispi_get_sleep_time' (or 'lv_refr_get_sleep_time') or the next idle period.
+ */
+void lv_dispi_wake(void)
+{
+    dispi_wake_qry = true;
+}
+
+/**
+ * Get the time until the display inputs are read again
+ * @return time in milliseconds or UINT32_MAX if the reading waits for 'lv_dispi_wake'
+ */
+uint32_t lv_dispi_get_sleep_time(void)
+{
+#if LV_DISPI_READ_PERIOD != 0
+    /*Apply the wake up here, in the task context ('dispi_task' clears the flag)*/
+    if(dispi_wake_qry != false) {
+        dispi_set_period(LV_DISPI_READ_PERIOD);
+        ptask_ready(dispi_task_p);
+        return 0;
+    }
+
+    if(dispi_period == UINT32_MAX) return UINT32_MAX;
+
+    uint32_t elaps = systick_elaps(dispi_last_run);
+    if(elaps >= dispi_period) return 0;
+    return dispi_period - elaps;
+#else
+    return UINT32_MAX;
+#endif
+}
+
+/**
+ * Invalidate the hit-test index of the children of an object.
+ * Call it if a child is added, deleted, moved, resized or reordered and when the object is deleted.
+ * @param obj pointer to an object
+ */
+void lv_dispi_hit_inv(lv_obj_t * obj)
+{
+#if LV_DISPI_HIT_IDX_NUM != 0
+    uint8_t i;
+    for(i = 0; i < LV_DISPI_HIT_IDX_NUM; i++) {
+        if(hit_idx[i].obj == obj) {
+            dispi_hit_idx_free(&hit_idx[i]);
+            break;
+        }
+    }
+#endif
+}
+
 /**
  * Reset the long press state of a display input
  * @param dispi pointer to a display input
@@ -141,6 +245,10 @@ static void dispi_task(void * param)
 	cord_t y;
 	uint8_t i;
 
+	/*The inputs are read now so a wake up is handled*/
+	dispi_wake_qry = false;
+	dispi_last_run = systick_get();
+
 	for (i = 0; i < INDEV_NUM; i++) {
 		dispi[i].pressed = indev_get(i, &x, &y);
 		dispi_proc_point(&dispi[i], x, y);
@@ -156,6 +264,29 @@ static void dispi_task(void * param)
     else if (lv_dispi_reset_now != false){
         lv_dispi_reset_now = false;
     }
+
+    /*Read less frequently (or wait for 'lv_dispi_wake') while nothing is pressed or thrown*/
+    bool active = lv_dispi_reset_qry;
+    for (i = 0; i < INDEV_NUM; i++) {
+        if(dispi[i].pressed != false || dispi[i].drag_in_prog != 0) active = true;
+    }
+
+    if(active != false) dispi_set_period(LV_DISPI_READ_PERIOD);
+#if LV_DISPI_IDLE_PERIOD != 0
+    else dispi_set_period(LV_DISPI_IDLE_PERIOD);
+#else
+    else dispi_set_period(UINT32_MAX);
+#endif
+}
+
+/**
+ * Set the period of the display input task and save it for 'lv_dispi_get_sleep_time'
+ * @param period new period [ms] (UINT32_MAX: wait for 'lv_dispi_wake')
+ */
+static void dispi_set_period(uint32_t period)
+{
+    dispi_period = period;
+    ptask_set_period(dispi_task_p, period);
 }
 
 /**
@@ -261,6 +392,7 @@ static void dispi_proc_press(lv_dispi_t * dispi_p)
             	lv_obj_t * par =lv_obj_get_parent(last_top);
             	/*After list change it will be the new head*/
                 ll_chg_list(&par->child_ll, &par->child_ll, last_top);
+                lv_dispi_hit_inv(par);
                 lv_obj_inv(last_top);
             }
 
@@ -352,30 +484,47 @@ static lv_obj_t * dispi_search_obj(const lv_dispi_t * dispi_p, lv_obj_t * obj)
 {
     lv_obj_t * found_p = NULL;
     
+    /*A hidden object and its children are not clickable*/
+    if(lv_obj_get_hidden(obj) != false) return NULL;
+
+    lv_obj_refr_cords(obj);
+
     /*If the point is on this object*/
     /*Check its children too*/
     if(area_is_point_on(&obj->cords, &dispi_p->act_point)) {
         lv_obj_t * i;
-    
-        LL_READ(obj->child_ll, i) {
-            found_p = dispi_search_obj(dispi_p, i);
-            
-            /*If a child was found then break*/
-            if(found_p != NULL) {
-                break;
+#if LV_DISPI_HIT_IDX_NUM != 0
+        dispi_hit_idx_t * idx = dispi_hit_idx_get(obj);
+        if(idx != NULL) {
+            /*Check only the children in the cell of the point*/
+            cord_t x = dispi_p->act_point.x - obj->cords.x1;
+            cord_t y = dispi_p->act_point.y - obj->cords.y1;
+            if(x >= idx->grid.x1 && x <= idx->grid.x2 &&
+               y >= idx->grid.y1 && y <= idx->grid.y2) {
+                uint16_t cell = ((y - idx->grid.y1) / idx->cell_h) * idx->col_num +
+                                 (x - idx->grid.x1) / idx->cell_w;
+                uint16_t c;
+                for(c = idx->cell_start[cell]; c < idx->cell_start[cell + 1]; c++) {
+                    found_p = dispi_search_obj(dispi_p, idx->children[idx->items[c]]);
+                    if(found_p != NULL) break;
+                }
+            }
+        } else
+#endif
+        {
+            LL_READ(obj->child_ll, i) {
+                found_p = dispi_search_obj(dispi_p, i);
+
+                /*If a child was found then break*/
+                if(found_p != NULL) {
+                    break;
+                }
             }
         }
         
-        /*If then the children was not ok, but this obj is clickable
-         * and it or its parent is not hidden then save this object*/
+        /*If then the children was not ok, but this obj is clickable then save this object*/
         if(found_p == NULL && lv_obj_get_click(obj) != false) {
-        	lv_obj_t * i = obj;
-        	while(i != NULL) {
-        		if(lv_obj_get_hidden(i) == true) break;
-        		i = lv_obj_get_parent(i);
-        	}
-        	/*No parent found with hidden == true*/
-        	if(i == NULL) found_p = obj;
+            found_p = obj;
         }
         
     }
@@ -383,6 +532,168 @@ static lv_obj_t * dispi_search_obj(const lv_dispi_t * dispi_p, lv_obj_t * obj)
     return found_p;    
 }
 
+#if LV_DISPI_HIT_IDX_NUM != 0
+/**
+ * Get the hit-test index of the children of an object. Build it if required.
+ * @param obj pointer to an object
+ * @return pointer to the index or NULL if the object has not got enough children
+ */
+static dispi_hit_idx_t * dispi_hit_idx_get(lv_obj_t * obj)
+{
+    dispi_hit_idx_t * idx = NULL;
+    uint8_t i;
+    for(i = 0; i < LV_DISPI_HIT_IDX_NUM; i++) {
+        if(hit_idx[i].obj == obj) {
+            idx = &hit_idx[i];
+            break;
+        }
+    }
+
+    if(idx == NULL) idx = dispi_hit_idx_build(obj);
+
+    if(idx != NULL) {
+        hit_idx_use_cnt++;
+        idx->last_use = hit_idx_use_cnt;
+    }
+
+    return idx;
+}
+
+/**
+ * Build the hit-test index of the children of an object in the least recently used slot
+ * @param obj pointer to an object
+ * @return pointer to the new index or NULL if the object has not got enough children or no memory
+ */
+static dispi_hit_idx_t * dispi_hit_idx_build(lv_obj_t * obj)
+{
+    /*Count the children and get their area (relative to the object)*/
+    uint16_t child_num = 0;
+    area_t grid;
+    area_t child_area;
+    lv_obj_t * child;
+    grid.x1 = LV_CORD_MAX;
+    grid.y1 = LV_CORD_MAX;
+    grid.x2 = LV_CORD_MIN;
+    grid.y2 = LV_CORD_MIN;
+    LL_READ(obj->child_ll, child) {
+        if(child_num == UINT16_MAX) return NULL;
+        child_num++;
+        dispi_hit_idx_child_area(child, &child_area);
+        grid.x1 = MATH_MIN(grid.x1, child_area.x1);
+        grid.y1 = MATH_MIN(grid.y1, child_area.y1);
+        grid.x2 = MATH_MAX(grid.x2, child_area.x2);
+        grid.y2 = MATH_MAX(grid.y2, child_area.y2);
+    }
+
+    if(child_num < LV_DISPI_HIT_IDX_MIN) return NULL;
+
+    /*Use the least recently used slot*/
+    dispi_hit_idx_t * idx = &hit_idx[0];
+    uint8_t i;
+    for(i = 0; i < LV_DISPI_HIT_IDX_NUM; i++) {
+        if(hit_idx[i].obj == NULL) {
+            idx = &hit_idx[i];
+            break;
+        }
+        if(hit_idx[i].last_use < idx->last_use) idx = &hit_idx[i];
+    }
+    dispi_hit_idx_free(idx);
+
+    /*About one child per cell*/
+    uint8_t grid_size = 1;
+    while(grid_size < LV_DISPI_HIT_GRID_MAX && grid_size * grid_size < child_num) grid_size++;
+
+    uint16_t cell_num = grid_size * grid_size;
+    idx->col_num = grid_size;
+    idx->row_num = grid_size;
+    idx->cell_w = (area_get_width(&grid) + grid_size - 1) / grid_size;
+    idx->cell_h = (area_get_height(&grid) + grid_size - 1) / grid_size;
+    idx->children = dm_alloc(child_num * sizeof(lv_obj_t *) + (cell_num + 1) * sizeof(uint16_t));
+    if(idx->children == NULL) return NULL;
+    idx->cell_start = (uint16_t *) &idx->children[child_num];
+    memset(idx->cell_start, 0, (cell_num + 1) * sizeof(uint16_t));
+
+    /*Count the children of the cells*/
+    uint32_t item_num = 0;
+    uint16_t child_id = 0;
+    uint8_t col;
+    uint8_t row;
+    LL_READ(obj->child_ll, child) {
+        idx->children[child_id] = child;
+        child_id++;
+        dispi_hit_idx_child_area(child, &child_area);
+        for(row = (child_area.y1 - grid.y1) / idx->cell_h; row <= (child_area.y2 - grid.y1) / idx->cell_h; row++) {
+            for(col = (child_area.x1 - grid.x1) / idx->cell_w; col <= (child_area.x2 - grid.x1) / idx->cell_w; col++) {
+                idx->cell_start[row * grid_size + col + 1]++;
+                item_num++;
+            }
+        }
+    }
+
+    if(item_num > UINT16_MAX) {
+        dm_free(idx->children);
+        return NULL;
+    }
+
+    idx->items = dm_alloc(item_num * sizeof(uint16_t));
+    if(idx->items == NULL) {
+        dm_free(idx->children);
+        return NULL;
+    }
+
+    /*Fill the cells. The children remain in the order of 'child_ll' (top first)*/
+    uint16_t c;
+    for(c = 1; c <= cell_num; c++) idx->cell_start[c] += idx->cell_start[c - 1];
+    for(child_id = 0; child_id < child_num; child_id++) {
+        child = idx->children[child_id];
+        dispi_hit_idx_child_area(child, &child_area);
+        for(row = (child_area.y1 - grid.y1) / idx->cell_h; row <= (child_area.y2 - grid.y1) / idx->cell_h; row++) {
+            for(col = (child_area.x1 - grid.x1) / idx->cell_w; col <= (child_area.x2 - grid.x1) / idx->cell_w; col++) {
+                c = row * grid_size + col;
+                idx->items[idx->cell_start[c]] = child_id;
+                idx->cell_start[c]++;
+            }
+        }
+    }
+    /*'cell_start[c]' is the end of the cell now. Shift back.*/
+    for(c = cell_num; c > 0; c--) idx->cell_start[c] = idx->cell_start[c - 1];
+    idx->cell_start[0] = 0;
+
+    idx->obj = obj;
+    area_cpy(&idx->grid, &grid);
+
+    return idx;
+}
+
+/**
+ * Get the area of a child relative to its parent
+ * @param child pointer to an object
+ * @param area store the area here
+ */
+static void dispi_hit_idx_child_area(lv_obj_t * child, area_t * area)
+{
+    area->x1 = lv_obj_get_x(child);
+    area->y1 = lv_obj_get_y(child);
+    area->x2 = area->x1 + lv_obj_get_width(child) - 1;
+    area->y2 = area->y1 + lv_obj_get_height(child) - 1;
+}
+
+/**
+ * Free a hit-test index
+ * @param idx pointer to a hit-test index
+ */
+static void dispi_hit_idx_free(dispi_hit_idx_t * idx)
+{
+    if(idx->obj == NULL) return;
+
+    dm_free(idx->children);
+    dm_free(idx->items);
+    idx->obj = NULL;
+    idx->children = NULL;
+    idx->items = NULL;
+}
+#endif
+
 /**
  * Handle the dragging of dispi_p->act_obj
  * @param dispi_p pointer to a display input
@@ -59,6 +59,27 @@ void lv_dispi_init(void);
  */
 void lv_dispi_reset(void);
 
+/**
+ * Read the display inputs as soon as possible and continue with the normal read period.
+ * Call it e.g. from a touch interrupt if LV_DISPI_IDLE_PERIOD is long or 0.
+ * It only sets a flag (interrupt safe). The reading is started by the next
+ * 'lv_dispi_get_sleep_time' (or 'lv_refr_get_sleep_time') or the next idle period.
+ */
+void lv_dispi_wake(void);
+
+/**
+ * Get the time until the display inputs are read again
+ * @return time in milliseconds or UINT32_MAX if the reading waits for 'lv_dispi_wake'
+ */
+uint32_t lv_dispi_get_sleep_time(void);
+
+/**
+ * Invalidate the hit-test index of the children of an object.
+ * Call it if a child is added, deleted, moved, resized or reordered and when the object is deleted.
+ * @param obj pointer to an object
+ */
+void lv_dispi_hit_inv(lv_obj_t * obj);
+
 /**
  * Reset the long press state of a display input
  * @param dispi pointer to a display input
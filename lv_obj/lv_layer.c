@@ -0,0 +1,782 @@
+/**
+ * @file lv_layer.c
+ * Draw objects from a snapshot (e.g. to animate them without redrawing their content)
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "misc/math/math_base.h"
+#include "lv_layer.h"
+#include "lv_refr.h"
+#include "../lv_draw/lv_draw_vbasic.h"
+#include "../lv_misc/anim.h"
+#include "../lv_misc/slab.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Test configurations*/
+#ifndef LV_LAYER_NUM
+#define LV_LAYER_NUM    2
+#endif
+
+#ifndef LV_LAYER_CACHE_SIZE
+#define LV_LAYER_CACHE_SIZE    (32 * 1024)
+#endif
+
+#define LV_LAYER_EN         (LV_LAYER_NUM != 0 && LV_VDB_SIZE != 0)
+#define LV_LAYER_CACHE_EN   (LV_LAYER_CACHE_SIZE != 0 && LV_VDB_SIZE != 0)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_LAYER_EN
+typedef struct
+{
+    lv_obj_t * obj;         /*The object drawn from this layer or NULL if the layer is free*/
+    color_t * buf;          /*The snapshot of the object*/
+    cord_t w;               /*Width of the snapshot*/
+    cord_t h;               /*Height of the snapshot*/
+    cord_t ext_size;        /*Ext. size of the object when the snapshot was taken*/
+    point_t ofs;            /*Offset of the snapshot relative to the object*/
+    uint16_t zoom_x;        /*Horizontal zoom (LV_LAYER_ZOOM_NONE: original size)*/
+    uint16_t zoom_y;        /*Vertical zoom (LV_LAYER_ZOOM_NONE: original size)*/
+    opa_t opa;              /*Opacity of the snapshot*/
+    anim_fp_t end_fp;       /*Apply the end state of an 'lv_layer_anim' with it (NULL: nothing to apply)*/
+    int32_t end_v;          /*End value for 'end_fp'*/
+    void (*end_cb)(lv_obj_t *); /*Callback of an 'lv_layer_anim'*/
+}lv_layer_t;
+#endif
+
+#if LV_LAYER_CACHE_EN
+typedef struct _lv_layer_cache_t
+{
+    struct _lv_layer_cache_t * prev;    /*The more recently drawn cache*/
+    struct _lv_layer_cache_t * next;    /*The less recently drawn cache*/
+    lv_obj_t * obj;         /*The cached object*/
+    color_t * buf;          /*The snapshot or NULL if not rendered yet (or dropped)*/
+    cord_t w;               /*Width of the snapshot*/
+    cord_t h;               /*Height of the snapshot*/
+    cord_t inv_y1;          /*First invalid row of the snapshot*/
+    cord_t inv_y2;          /*Last invalid row of the snapshot (inv_y1 > inv_y2: no invalid rows)*/
+    uint8_t busy :1;        /*1: the snapshot is being rendered*/
+}lv_layer_cache_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_LAYER_EN
+static lv_layer_t * lv_layer_find(lv_obj_t * obj);
+static void lv_layer_inv(lv_layer_t * layer);
+static void lv_layer_anim_ready(void * obj);
+#endif
+#if LV_LAYER_CACHE_EN
+static lv_layer_cache_t * lv_layer_cache_find(lv_obj_t * obj);
+static void lv_layer_cache_get_area(lv_obj_t * obj, area_t * area_p);
+static void lv_layer_cache_free_buf(lv_layer_cache_t * cache);
+static void lv_layer_cache_unlink(lv_layer_cache_t * cache);
+static void lv_layer_cache_link_first(lv_layer_cache_t * cache);
+#endif
+#if LV_LAYER_EN || LV_LAYER_CACHE_EN
+static bool lv_layer_is_opaque(lv_obj_t * obj);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_LAYER_EN
+static lv_layer_t layers[LV_LAYER_NUM];
+#endif
+#if LV_LAYER_CACHE_EN
+static lv_layer_cache_t * cache_first;  /*The most recently drawn cache*/
+static lv_layer_cache_t * cache_last;   /*The least recently drawn cache*/
+static uint32_t cache_size;             /*Size of all snapshots in bytes*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_LAYER_EN
+
+/**
+ * Take a snapshot of an object and its children and draw the object from it until 'lv_layer_del'.
+ * The content of the object is frozen meanwhile, but the snapshot can be moved, faded and zoomed.
+ * @param obj pointer to an object (not a screen)
+ * @return true: the object is drawn from a snapshot,
+ *         false: no free layer, not enough memory, the object is not opaque or the layers are disabled
+ */
+bool lv_layer_create(lv_obj_t * obj)
+{
+    if(obj->layer != 0) return true;
+    if(lv_obj_get_parent(obj) == NULL) return false;    /*A screen has nothing behind it*/
+
+    if(lv_layer_is_opaque(obj) == false) return false;
+
+    lv_layer_t * layer = lv_layer_find(NULL);
+    if(layer == NULL) return false;
+
+    /*The snapshot contains the ext. size of the object too (e.g. shadow)*/
+    area_t area;
+    lv_obj_get_cords(obj, &area);
+    area.x1 -= obj->ext_size;
+    area.y1 -= obj->ext_size;
+    area.x2 += obj->ext_size;
+    area.y2 += obj->ext_size;
+    if(area_get_width(&area) <= 0 || area_get_height(&area) <= 0) return false;
+
+    uint32_t px_num = area_get_size(&area);
+    color_t * buf = dm_alloc(px_num * sizeof(color_t));
+    if(buf == NULL) return false;
+
+    /*The not drawn pixels will be transparent*/
+    color_t transp_color = LV_COLOR_TRANSP;
+    uint32_t i;
+    for(i = 0; i < px_num; i++) buf[i] = transp_color;
+
+    lv_refr_snapshot(obj, buf, &area, NULL);
+
+    layer->obj = obj;
+    layer->buf = buf;
+    layer->w = area_get_width(&area);
+    layer->h = area_get_height(&area);
+    layer->ext_size = obj->ext_size;
+    layer->ofs.x = 0;
+    layer->ofs.y = 0;
+    layer->zoom_x = LV_LAYER_ZOOM_NONE;
+    layer->zoom_y = LV_LAYER_ZOOM_NONE;
+    layer->opa = OPA_COVER;
+    layer->end_fp = NULL;
+    layer->end_cb = NULL;
+
+    obj->layer = 1;
+
+    return true;
+}
+
+/**
+ * Delete the snapshot of an object and draw the object normally again
+ * @param obj pointer to an object
+ */
+void lv_layer_del(lv_obj_t * obj)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    if(layer == NULL) return;
+
+    lv_layer_inv(layer);
+    dm_free(layer->buf);
+    layer->buf = NULL;
+    layer->obj = NULL;
+    obj->layer = 0;
+
+    lv_obj_inv(obj);
+}
+
+/**
+ * Move the snapshot of an object horizontally
+ * @param obj pointer to an object with a layer
+ * @param x offset relative to the object
+ */
+void lv_layer_set_x(lv_obj_t * obj, cord_t x)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    if(layer == NULL || layer->ofs.x == x) return;
+
+    lv_layer_inv(layer);
+    layer->ofs.x = x;
+    lv_layer_inv(layer);
+}
+
+/**
+ * Move the snapshot of an object vertically
+ * @param obj pointer to an object with a layer
+ * @param y offset relative to the object
+ */
+void lv_layer_set_y(lv_obj_t * obj, cord_t y)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    if(layer == NULL || layer->ofs.y == y) return;
+
+    lv_layer_inv(layer);
+    layer->ofs.y = y;
+    lv_layer_inv(layer);
+}
+
+/**
+ * Set the opacity of the snapshot of an object
+ * @param obj pointer to an object with a layer
+ * @param opa opacity of the snapshot (0..255)
+ */
+void lv_layer_set_opa(lv_obj_t * obj, opa_t opa)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    if(layer == NULL || layer->opa == opa) return;
+
+    layer->opa = opa;
+    lv_layer_inv(layer);
+}
+
+/**
+ * Zoom the snapshot of an object horizontally. The left side remains at the same place.
+ * @param obj pointer to an object with a layer
+ * @param zoom the zoom (LV_LAYER_ZOOM_NONE: original size)
+ */
+void lv_layer_set_zoom_x(lv_obj_t * obj, uint16_t zoom)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    if(layer == NULL || layer->zoom_x == zoom) return;
+
+    lv_layer_inv(layer);
+    layer->zoom_x = zoom;
+    lv_layer_inv(layer);
+}
+
+/**
+ * Zoom the snapshot of an object vertically. The top side remains at the same place.
+ * @param obj pointer to an object with a layer
+ * @param zoom the zoom (LV_LAYER_ZOOM_NONE: original size)
+ */
+void lv_layer_set_zoom_y(lv_obj_t * obj, uint16_t zoom)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    if(layer == NULL || layer->zoom_y == zoom) return;
+
+    lv_layer_inv(layer);
+    layer->zoom_y = zoom;
+    lv_layer_inv(layer);
+}
+
+/**
+ * Animate an object with a built-in animation by transforming its snapshot.
+ * The snapshot is deleted when the animation is ready and the end state is applied to the object.
+ * @param obj pointer to an object to animate
+ * @param type type of animation from 'lv_anim_builtin_t'. 'OR' it with ANIM_IN or ANIM_OUT
+ * @param time time of animation in milliseconds
+ * @param delay delay before the animation in milliseconds
+ * @param cb a function to call when the animation is ready
+ * @return true: the animation is created, false: the layer can not be created (animate the object normally)
+ */
+bool lv_layer_anim(lv_obj_t * obj, lv_anim_builtin_t type, uint16_t time, uint16_t delay, void (*cb) (lv_obj_t *))
+{
+    lv_obj_t * par = lv_obj_get_parent(obj);
+
+    /*Get the direction*/
+    bool out = (type & ANIM_DIR_MASK) == ANIM_IN ? false : true;
+    type = type & (~ANIM_DIR_MASK);
+
+    if(type == LV_ANIM_NONE || par == NULL) return false;
+
+    /*Restart from a new snapshot if a layer animation is running already*/
+    if(obj->layer != 0) {
+        anim_del(obj, (anim_fp_t)lv_layer_set_x);
+        anim_del(obj, (anim_fp_t)lv_layer_set_y);
+        anim_del(obj, (anim_fp_t)lv_layer_set_opa);
+        anim_del(obj, (anim_fp_t)lv_layer_set_zoom_x);
+        anim_del(obj, (anim_fp_t)lv_layer_set_zoom_y);
+        lv_layer_del(obj);
+    }
+
+    if(lv_layer_create(obj) == false) return false;
+    lv_layer_t * layer = lv_layer_find(obj);
+
+    anim_t a;
+    a.var = obj;
+    a.time = time;
+    a.act_time = (int32_t)-delay;
+    a.end_cb = lv_layer_anim_ready;
+    a.path = anim_get_path(ANIM_PATH_LIN);
+    a.playback_pause = 0;
+    a.repeat_pause = 0;
+    a.playback = 0;
+    a.repeat = 0;
+
+    /* Init to ANIM_IN. The snapshot moves to the object's real place
+     * and the 'end_fp' with 'end_v' is the real state after ANIM_OUT*/
+    switch(type) {
+        case LV_ANIM_FLOAT_LEFT:
+            a.fp = (anim_fp_t)lv_layer_set_x;
+            a.start = -lv_obj_get_width(obj) - lv_obj_get_x(obj);
+            layer->end_fp = (anim_fp_t)lv_obj_set_x;
+            layer->end_v = -lv_obj_get_width(obj);
+            break;
+        case LV_ANIM_FLOAT_RIGHT:
+            a.fp = (anim_fp_t)lv_layer_set_x;
+            a.start = lv_obj_get_width(par) - lv_obj_get_x(obj);
+            layer->end_fp = (anim_fp_t)lv_obj_set_x;
+            layer->end_v = lv_obj_get_width(par);
+            break;
+        case LV_ANIM_FLOAT_TOP:
+            a.fp = (anim_fp_t)lv_layer_set_y;
+            a.start = -lv_obj_get_height(obj) - lv_obj_get_y(obj);
+            layer->end_fp = (anim_fp_t)lv_obj_set_y;
+            layer->end_v = -lv_obj_get_height(obj);
+            break;
+        case LV_ANIM_FLOAT_BOTTOM:
+            a.fp = (anim_fp_t)lv_layer_set_y;
+            a.start = lv_obj_get_height(par) - lv_obj_get_y(obj);
+            layer->end_fp = (anim_fp_t)lv_obj_set_y;
+            layer->end_v = lv_obj_get_height(par);
+            break;
+        case LV_ANIM_FADE:
+            a.fp = (anim_fp_t)lv_layer_set_opa;
+            a.start = OPA_TRANSP;
+            layer->end_fp = (anim_fp_t)lv_obj_set_opar;
+            layer->end_v = OPA_TRANSP;
+            break;
+        case LV_ANIM_GROW_H:
+            a.fp = (anim_fp_t)lv_layer_set_zoom_x;
+            a.start = 0;
+            layer->end_fp = (anim_fp_t)lv_obj_set_width;
+            layer->end_v = 0;
+            break;
+        case LV_ANIM_GROW_V:
+            a.fp = (anim_fp_t)lv_layer_set_zoom_y;
+            a.start = 0;
+            layer->end_fp = (anim_fp_t)lv_obj_set_height;
+            layer->end_v = 0;
+            break;
+        default:
+            lv_layer_del(obj);
+            return false;
+    }
+
+    /*The end value is the original state of the snapshot*/
+    if(a.fp == (anim_fp_t)lv_layer_set_opa) a.end = OPA_COVER;
+    else if(a.fp == (anim_fp_t)lv_layer_set_zoom_x || a.fp == (anim_fp_t)lv_layer_set_zoom_y) a.end = LV_LAYER_ZOOM_NONE;
+    else a.end = 0;
+
+    /*Swap start and end in case of ANIM OUT. Nothing to apply at the end of ANIM_IN.*/
+    if(out != false) {
+        int32_t tmp = a.start;
+        a.start = a.end;
+        a.end = tmp;
+    } else {
+        layer->end_fp = NULL;
+    }
+
+    layer->end_cb = cb;
+
+    anim_create(&a);
+
+    return true;
+}
+
+/**
+ * Get the area where the snapshot of an object is drawn
+ * @param obj pointer to an object with a layer
+ * @param area_p store the area here
+ */
+void lv_layer_get_area(lv_obj_t * obj, area_t * area_p)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    lv_obj_get_cords(obj, area_p);
+    if(layer == NULL) return;
+
+    area_p->x1 += layer->ofs.x - layer->ext_size;
+    area_p->y1 += layer->ofs.y - layer->ext_size;
+    area_p->x2 = area_p->x1 + (((int32_t)layer->w * layer->zoom_x) >> 8) - 1;
+    area_p->y2 = area_p->y1 + (((int32_t)layer->h * layer->zoom_y) >> 8) - 1;
+}
+
+/**
+ * Draw the snapshot of an object. Called by the screen refresh instead of drawing the object.
+ * @param obj pointer to an object with a layer
+ * @param mask_p the snapshot will be drawn only on this area
+ */
+void lv_layer_draw(lv_obj_t * obj, const area_t * mask_p)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    if(layer == NULL || layer->opa == OPA_TRANSP) return;
+
+    area_t area;
+    lv_layer_get_area(obj, &area);
+    lv_vmap_scale(&area, mask_p, layer->buf, layer->w, layer->h, layer->opa, true);
+}
+
+#else /*LV_LAYER_EN == 0: the objects are always drawn normally*/
+
+bool lv_layer_create(lv_obj_t * obj)
+{
+    return false;
+}
+
+void lv_layer_del(lv_obj_t * obj)
+{
+
+}
+
+void lv_layer_set_x(lv_obj_t * obj, cord_t x)
+{
+
+}
+
+void lv_layer_set_y(lv_obj_t * obj, cord_t y)
+{
+
+}
+
+void lv_layer_set_opa(lv_obj_t * obj, opa_t opa)
+{
+
+}
+
+void lv_layer_set_zoom_x(lv_obj_t * obj, uint16_t zoom)
+{
+
+}
+
+void lv_layer_set_zoom_y(lv_obj_t * obj, uint16_t zoom)
+{
+
+}
+
+bool lv_layer_anim(lv_obj_t * obj, lv_anim_builtin_t type, uint16_t time, uint16_t delay, void (*cb) (lv_obj_t *))
+{
+    return false;
+}
+
+void lv_layer_get_area(lv_obj_t * obj, area_t * area_p)
+{
+    lv_obj_get_cords(obj, area_p);
+}
+
+void lv_layer_draw(lv_obj_t * obj, const area_t * mask_p)
+{
+
+}
+
+#endif
+
+#if LV_LAYER_CACHE_EN
+
+/**
+ * Draw an object and its children from a cached snapshot. The snapshot is rendered again
+ * only where the object or its children are invalidated.
+ * The snapshots share the LV_LAYER_CACHE_SIZE memory. The least recently drawn ones are dropped first.
+ * @param obj pointer to an object (not a screen)
+ * @return true: the object is cached, false: not enough memory or the caching is disabled
+ *         (the not opaque objects are drawn normally even if they are cached)
+ */
+bool lv_layer_cache_add(lv_obj_t * obj)
+{
+    if(obj->cache != 0) return true;
+    if(lv_obj_get_parent(obj) == NULL) return false;    /*A screen has nothing behind it*/
+
+    lv_layer_cache_t * cache = slab_alloc(sizeof(lv_layer_cache_t));
+    if(cache == NULL) return false;
+
+    /*The snapshot will be rendered when the object is drawn first*/
+    cache->obj = obj;
+    cache->buf = NULL;
+    cache->w = 0;
+    cache->h = 0;
+    cache->inv_y1 = 0;
+    cache->inv_y2 = -1;
+    cache->busy = 0;
+    lv_layer_cache_link_first(cache);
+
+    obj->cache = 1;
+
+    return true;
+}
+
+/**
+ * Stop caching an object and free its snapshot
+ * @param obj pointer to an object
+ */
+void lv_layer_cache_rem(lv_obj_t * obj)
+{
+    lv_layer_cache_t * cache = lv_layer_cache_find(obj);
+    if(cache == NULL) return;
+
+    lv_layer_cache_unlink(cache);
+    lv_layer_cache_free_buf(cache);
+    slab_free(cache);
+
+    obj->cache = 0;
+}
+
+/**
+ * Mark an area of a cached object to render again
+ * @param obj pointer to a cached object
+ * @param area_p the invalid area in absolute coordinates
+ */
+void lv_layer_cache_inv(lv_obj_t * obj, const area_t * area_p)
+{
+    lv_layer_cache_t * cache = lv_layer_cache_find(obj);
+    if(cache == NULL || cache->buf == NULL) return;
+
+    /*Only whole rows are rendered, so store only the invalid rows*/
+    area_t cache_area;
+    lv_layer_cache_get_area(obj, &cache_area);
+    cord_t y1 = MATH_MAX(area_p->y1 - cache_area.y1, 0);
+    cord_t y2 = MATH_MIN(area_p->y2 - cache_area.y1, cache->h - 1);
+    if(y1 > y2) return;
+
+    if(cache->inv_y1 > cache->inv_y2) {
+        cache->inv_y1 = y1;
+        cache->inv_y2 = y2;
+    } else {
+        cache->inv_y1 = MATH_MIN(cache->inv_y1, y1);
+        cache->inv_y2 = MATH_MAX(cache->inv_y2, y2);
+    }
+}
+
+/**
+ * Draw a cached object from its snapshot. Render the snapshot first if it's invalid.
+ * Called by the screen refresh instead of drawing the object.
+ * @param obj pointer to a cached object
+ * @param mask_p the object will be drawn only on this area
+ * @return true: the object is drawn, false: the snapshot is not available (draw the object normally)
+ */
+bool lv_layer_cache_draw(lv_obj_t * obj, const area_t * mask_p)
+{
+    lv_layer_cache_t * cache = lv_layer_cache_find(obj);
+    if(cache == NULL || cache->busy != 0) return false;   /*Busy: the snapshot is being rendered now*/
+
+    if(lv_layer_is_opaque(obj) == false) {
+        lv_layer_cache_free_buf(cache);
+        return false;
+    }
+
+    area_t cache_area;
+    lv_layer_cache_get_area(obj, &cache_area);
+    cord_t w = area_get_width(&cache_area);
+    cord_t h = area_get_height(&cache_area);
+    if(w <= 0 || h <= 0) return false;
+
+    /*Allocate a new buffer if there is no snapshot or the size is changed*/
+    if(cache->buf == NULL || cache->w != w || cache->h != h) {
+        lv_layer_cache_free_buf(cache);
+
+        uint32_t buf_size = (uint32_t)w * h * sizeof(color_t);
+        if(buf_size > LV_LAYER_CACHE_SIZE) return false;
+
+        /*Drop the least recently drawn snapshots to fit into the memory budget.
+         *Keep the busy ones: a cached parent can be rendering into its snapshot now.*/
+        lv_layer_cache_t * i = cache_last;
+        while(i != NULL && cache_size + buf_size > LV_LAYER_CACHE_SIZE) {
+            if(i->busy == 0) lv_layer_cache_free_buf(i);
+            i = i->prev;
+        }
+        if(cache_size + buf_size > LV_LAYER_CACHE_SIZE) return false;
+
+        cache->buf = dm_alloc(buf_size);
+        if(cache->buf == NULL) return false;
+
+        cache_size += buf_size;
+        cache->w = w;
+        cache->h = h;
+        cache->inv_y1 = 0;
+        cache->inv_y2 = h - 1;
+    }
+
+    /*Render the invalid rows (they are continuous in the buffer)*/
+    if(cache->inv_y1 <= cache->inv_y2) {
+        color_t * row_buf = cache->buf + (uint32_t)w * cache->inv_y1;
+        uint32_t px_num = (uint32_t)w * (cache->inv_y2 - cache->inv_y1 + 1);
+        color_t transp_color = LV_COLOR_TRANSP;
+        uint32_t px;
+        for(px = 0; px < px_num; px++) row_buf[px] = transp_color;
+
+        area_t rows;
+        rows.x1 = cache_area.x1;
+        rows.x2 = cache_area.x2;
+        rows.y1 = cache_area.y1 + cache->inv_y1;
+        rows.y2 = cache_area.y1 + cache->inv_y2;
+
+        cache->busy = 1;
+        lv_refr_snapshot(obj, row_buf, &rows, NULL);
+        cache->busy = 0;
+
+        cache->inv_y1 = 0;
+        cache->inv_y2 = -1;
+    }
+
+    /*It is the most recently drawn now*/
+    if(cache != cache_first) {
+        lv_layer_cache_unlink(cache);
+        lv_layer_cache_link_first(cache);
+    }
+
+    lv_vmap(&cache_area, mask_p, cache->buf, OPA_COVER, true, false, COLOR_BLACK, OPA_TRANSP);
+
+    return true;
+}
+
+#else /*LV_LAYER_CACHE_EN == 0: the objects are never cached*/
+
+bool lv_layer_cache_add(lv_obj_t * obj)
+{
+    return false;
+}
+
+void lv_layer_cache_rem(lv_obj_t * obj)
+{
+
+}
+
+void lv_layer_cache_inv(lv_obj_t * obj, const area_t * area_p)
+{
+
+}
+
+bool lv_layer_cache_draw(lv_obj_t * obj, const area_t * mask_p)
+{
+    return false;
+}
+
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_LAYER_EN
+
+/**
+ * Find the layer of an object
+ * @param obj pointer to an object or NULL to find a free layer
+ * @return pointer to the layer or NULL if not found
+ */
+static lv_layer_t * lv_layer_find(lv_obj_t * obj)
+{
+    uint8_t i;
+    for(i = 0; i < LV_LAYER_NUM; i++) {
+        if(layers[i].obj == obj) return &layers[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * Invalidate the area where a snapshot is drawn
+ * @param layer pointer to a layer
+ */
+static void lv_layer_inv(lv_layer_t * layer)
+{
+    area_t area;
+    lv_layer_get_area(layer->obj, &area);
+    if(area.x2 < area.x1 || area.y2 < area.y1) return;  /*Zoomed to 0*/
+
+    /*Invalidate it on the parent: the parents truncate it and their caches are updated too*/
+    lv_obj_inv_area(lv_obj_get_parent(layer->obj), &area);
+}
+
+/**
+ * Called when an 'lv_layer_anim' is ready. Delete the layer, apply the end state and call the user callback.
+ * @param obj pointer to the animated object
+ */
+static void lv_layer_anim_ready(void * obj)
+{
+    lv_layer_t * layer = lv_layer_find(obj);
+    if(layer == NULL) return;
+
+    anim_fp_t end_fp = layer->end_fp;
+    int32_t end_v = layer->end_v;
+    void (*end_cb)(lv_obj_t *) = layer->end_cb;
+
+    lv_layer_del(obj);
+    if(end_fp != NULL) end_fp(obj, end_v);
+    if(end_cb != NULL) end_cb(obj);
+}
+
+#endif
+
+#if LV_LAYER_CACHE_EN
+
+/**
+ * Find the cache of an object
+ * @param obj pointer to an object
+ * @return pointer to the cache or NULL if not found
+ */
+static lv_layer_cache_t * lv_layer_cache_find(lv_obj_t * obj)
+{
+    lv_layer_cache_t * i;
+    for(i = cache_first; i != NULL; i = i->next) {
+        if(i->obj == obj) return i;
+    }
+
+    return NULL;
+}
+
+/**
+ * Get the area of the snapshot of a cached object (its coordinates with the ext. size)
+ * @param obj pointer to a cached object
+ * @param area_p store the area here
+ */
+static void lv_layer_cache_get_area(lv_obj_t * obj, area_t * area_p)
+{
+    lv_obj_get_cords(obj, area_p);
+    area_p->x1 -= obj->ext_size;
+    area_p->y1 -= obj->ext_size;
+    area_p->x2 += obj->ext_size;
+    area_p->y2 += obj->ext_size;
+}
+
+/**
+ * Free the snapshot of a cache. It will be rendered again when the object is drawn.
+ * @param cache pointer to a cache
+ */
+static void lv_layer_cache_free_buf(lv_layer_cache_t * cache)
+{
+    if(cache->buf == NULL) return;
+
+    dm_free(cache->buf);
+    cache->buf = NULL;
+    cache_size -= (uint32_t)cache->w * cache->h * sizeof(color_t);
+}
+
+/**
+ * Remove a cache from the list of caches
+ * @param cache pointer to a cache
+ */
+static void lv_layer_cache_unlink(lv_layer_cache_t * cache)
+{
+    if(cache->prev != NULL) cache->prev->next = cache->next;
+    else cache_first = cache->next;
+
+    if(cache->next != NULL) cache->next->prev = cache->prev;
+    else cache_last = cache->prev;
+}
+
+/**
+ * Add a cache to the head of the list of caches (as the most recently drawn)
+ * @param cache pointer to a cache
+ */
+static void lv_layer_cache_link_first(lv_layer_cache_t * cache)
+{
+    cache->prev = NULL;
+    cache->next = cache_first;
+    if(cache_first != NULL) cache_first->prev = cache;
+    else cache_last = cache;
+    cache_first = cache;
+}
+
+#endif
+
+#if LV_LAYER_EN || LV_LAYER_CACHE_EN
+/**
+ * Tell whether an object covers its whole area with opaque pixels.
+ * The snapshots are keyed with LV_COLOR_TRANSP, so the semi-transparent pixels
+ * (shadow, opacity, rounded corners) would be mixed with the key color instead of the background.
+ * @param obj pointer to an object
+ * @return true: the object can be drawn from a snapshot
+ */
+static bool lv_layer_is_opaque(lv_obj_t * obj)
+{
+    if(obj->opa != OPA_COVER || obj->ext_size != 0 || LV_SA(obj, lv_objs_t)->transp != 0) return false;
+
+    area_t cords;
+    lv_obj_get_cords(obj, &cords);
+
+    return obj->design_f(obj, &cords, LV_DESIGN_COVER_CHK);
+}
+#endif
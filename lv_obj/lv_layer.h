@@ -0,0 +1,140 @@
+/**
+ * @file lv_layer.h
+ * Draw objects from a snapshot (e.g. to animate them without redrawing their content)
+ */
+
+#ifndef LV_LAYER_H
+#define LV_LAYER_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_LAYER_ZOOM_NONE      256     /*Zoom of the original size*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Take a snapshot of an object and its children and draw the object from it until 'lv_layer_del'.
+ * The content of the object is frozen meanwhile, but the snapshot can be moved, faded and zoomed.
+ * @param obj pointer to an object (not a screen)
+ * @return true: the object is drawn from a snapshot,
+ *         false: no free layer, not enough memory, the object is not opaque or the layers are disabled
+ */
+bool lv_layer_create(lv_obj_t * obj);
+
+/**
+ * Delete the snapshot of an object and draw the object normally again
+ * @param obj pointer to an object
+ */
+void lv_layer_del(lv_obj_t * obj);
+
+/**
+ * Move the snapshot of an object horizontally
+ * @param obj pointer to an object with a layer
+ * @param x offset relative to the object
+ */
+void lv_layer_set_x(lv_obj_t * obj, cord_t x);
+
+/**
+ * Move the snapshot of an object vertically
+ * @param obj pointer to an object with a layer
+ * @param y offset relative to the object
+ */
+void lv_layer_set_y(lv_obj_t * obj, cord_t y);
+
+/**
+ * Set the opacity of the snapshot of an object
+ * @param obj pointer to an object with a layer
+ * @param opa opacity of the snapshot (0..255)
+ */
+void lv_layer_set_opa(lv_obj_t * obj, opa_t opa);
+
+/**
+ * Zoom the snapshot of an object horizontally. The left side remains at the same place.
+ * @param obj pointer to an object with a layer
+ * @param zoom the zoom (LV_LAYER_ZOOM_NONE: original size)
+ */
+void lv_layer_set_zoom_x(lv_obj_t * obj, uint16_t zoom);
+
+/**
+ * Zoom the snapshot of an object vertically. The top side remains at the same place.
+ * @param obj pointer to an object with a layer
+ * @param zoom the zoom (LV_LAYER_ZOOM_NONE: original size)
+ */
+void lv_layer_set_zoom_y(lv_obj_t * obj, uint16_t zoom);
+
+/**
+ * Animate an object with a built-in animation by transforming its snapshot.
+ * The snapshot is deleted when the animation is ready and the end state is applied to the object.
+ * @param obj pointer to an object to animate
+ * @param type type of animation from 'lv_anim_builtin_t'. 'OR' it with ANIM_IN or ANIM_OUT
+ * @param time time of animation in milliseconds
+ * @param delay delay before the animation in milliseconds
+ * @param cb a function to call when the animation is ready
+ * @return true: the animation is created, false: the layer can not be created (animate the object normally)
+ */
+bool lv_layer_anim(lv_obj_t * obj, lv_anim_builtin_t type, uint16_t time, uint16_t delay, void (*cb) (lv_obj_t *));
+
+/**
+ * Draw an object and its children from a cached snapshot. The snapshot is rendered again
+ * only where the object or its children are invalidated.
+ * The snapshots share the LV_LAYER_CACHE_SIZE memory. The least recently drawn ones are dropped first.
+ * @param obj pointer to an object (not a screen)
+ * @return true: the object is cached, false: not enough memory or the caching is disabled
+ *         (the not opaque objects are drawn normally even if they are cached)
+ */
+bool lv_layer_cache_add(lv_obj_t * obj);
+
+/**
+ * Stop caching an object and free its snapshot
+ * @param obj pointer to an object
+ */
+void lv_layer_cache_rem(lv_obj_t * obj);
+
+/**
+ * Mark an area of a cached object to render again
+ * @param obj pointer to a cached object
+ * @param area_p the invalid area in absolute coordinates
+ */
+void lv_layer_cache_inv(lv_obj_t * obj, const area_t * area_p);
+
+/**
+ * Draw a cached object from its snapshot. Render the snapshot first if it's invalid.
+ * Called by the screen refresh instead of drawing the object.
+ * @param obj pointer to a cached object
+ * @param mask_p the object will be drawn only on this area
+ * @return true: the object is drawn, false: the snapshot is not available (draw the object normally)
+ */
+bool lv_layer_cache_draw(lv_obj_t * obj, const area_t * mask_p);
+
+/**
+ * Get the area where the snapshot of an object is drawn
+ * @param obj pointer to an object with a layer
+ * @param area_p store the area here
+ */
+void lv_layer_get_area(lv_obj_t * obj, area_t * area_p);
+
+/**
+ * Draw the snapshot of an object. Called by the screen refresh instead of drawing the object.
+ * @param obj pointer to an object with a layer
+ * @param mask_p the snapshot will be drawn only on this area
+ */
+void lv_layer_draw(lv_obj_t * obj, const area_t * mask_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif
@@ -11,7 +11,10 @@
 #include <lvgl/lv_draw/lv_draw_rbasic.h>
 #include <lvgl/lv_draw/lv_draw_vbasic.h>
 #include <lvgl/lv_misc/anim.h>
+#include <lvgl/lv_misc/slab.h>
+#include <lvgl/lv_obj/lv_cmd.h>
 #include <lvgl/lv_obj/lv_dispi.h>
+#include <lvgl/lv_obj/lv_layer.h>
 #include <lvgl/lv_obj/lv_obj.h>
 #include <lvgl/lv_obj/lv_refr.h>
 #include <stdint.h>
@@ -24,18 +27,33 @@
 /*********************
  *      DEFINES
  *********************/
+#define LV_STYLE_REG_SLOTS  32      /*Hash slots of the style registry*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct _lv_style_reg_t
+{
+    struct _lv_style_reg_t * next;  /*Next style in the same hash slot*/
+    void * style;                   /*The registered style*/
+    lv_obj_t * users;               /*First object with this style (linked with 'style_next')*/
+    uint16_t user_cnt;              /*Number of objects with this style*/
+    uint32_t gen;                   /*Generation of the style. Changed on every refresh.*/
+}lv_style_reg_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void lv_obj_pos_child_refr(lv_obj_t * obj, cord_t x_diff, cord_t y_diff);
-static void lv_style_refr_core(void * style_p, lv_obj_t * obj);
+static bool lv_obj_move_drawn(lv_obj_t * obj, cord_t x_diff, cord_t y_diff);
+static bool lv_obj_is_top(lv_obj_t * obj, const area_t * area_p);
+static void lv_style_refr_core(lv_obj_t * obj);
+static lv_style_reg_t * lv_style_reg_find(void * style, bool create);
+static void lv_obj_style_link(lv_obj_t * obj, void * style);
+static void lv_obj_style_unlink(lv_obj_t * obj);
 static void lv_obj_del_child(lv_obj_t * obj);
 static bool lv_obj_design(lv_obj_t * obj, const  area_t * mask_p, lv_design_mode_t mode);
+static void lv_obj_trans_mark(lv_obj_t * obj);
+static void lv_obj_trans_refr(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -43,6 +61,11 @@ static bool lv_obj_design(lv_obj_t * obj, const  area_t * mask_p, lv_design_mode
 static lv_obj_t * def_scr = NULL;
 static lv_obj_t * act_scr = NULL;
 static ll_dsc_t scr_ll;
+static uint32_t cords_gen_act;  /*Incremented when an object is moved*/
+static uint16_t trans_cnt;      /*Number of open (nested) transactions*/
+static lv_obj_t * trans_act;    /*The object whose deferred layout is being refreshed*/
+static lv_style_reg_t * style_reg[LV_STYLE_REG_SLOTS]; /*Reverse references from the styles to the objects*/
+static uint32_t style_gen_act;  /*Incremented when a style is refreshed*/
 
 static lv_objs_t lv_objs_def = {.color = COLOR_MAKE(0xa0, 0xc0, 0xe0), .transp = 0};
 static lv_objs_t lv_objs_scr = {.color = LV_OBJ_DEF_SCR_COLOR, .transp = 0};
@@ -77,6 +100,9 @@ void lv_init(void)
     /*Init. the animations*/
     anim_init();
 
+    /*Init. the command queue of the other threads*/
+    lv_cmd_init();
+
     /*Create the default screen*/
     ll_init(&scr_ll, sizeof(lv_obj_t));
 #ifdef LV_IMG_DEF_WALLPAPER
@@ -130,10 +156,13 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
 		new_obj->cords.y1 = 0;
 		new_obj->cords.x2 = LV_HOR_RES - 1;
 		new_obj->cords.y2 = LV_VER_RES - 1;
+		new_obj->rel.x = 0;
+		new_obj->rel.y = 0;
+		new_obj->cords_gen = 0;
 		new_obj->ext_size = 0;
 
 		/*Set appearance*/
-		new_obj->style_p = lv_objs_get(LV_OBJS_SCR, NULL);
+		lv_obj_style_link(new_obj, lv_objs_get(LV_OBJS_SCR, NULL));
 		new_obj->opa = OPA_COVER;
 
 		/*Set virtual functions*/
@@ -154,6 +183,11 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
 		new_obj->style_iso = 0;
 		new_obj->hidden = 0;
 		new_obj->top_en = 0;
+		new_obj->move_copy = 0;
+		new_obj->trans_refr = 0;
+		new_obj->trans_child = 0;
+		new_obj->layer = 0;
+		new_obj->cache = 0;
         new_obj->protect = LV_PROTECT_NONE;
 
 		new_obj->ext = NULL;
@@ -167,6 +201,10 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         ll_init(&(new_obj->child_ll), sizeof(lv_obj_t));
         
         /*Set coordinates left top corner of parent*/
+        lv_obj_refr_cords(parent);
+        new_obj->rel.x = 0;
+        new_obj->rel.y = 0;
+        new_obj->cords_gen = parent->cords_gen;
         new_obj->cords.x1 = parent->cords.x1;
         new_obj->cords.y1 = parent->cords.y1;
         new_obj->cords.x2 = parent->cords.x1 +
@@ -176,7 +214,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         new_obj->ext_size = 0;
 
         /*Set appearance*/
-        new_obj->style_p = lv_objs_get(LV_OBJS_DEF, NULL);
+        lv_obj_style_link(new_obj, lv_objs_get(LV_OBJS_DEF, NULL));
         new_obj->opa = OPA_COVER;
         
         /*Set virtual functions*/
@@ -197,6 +235,11 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         new_obj->style_iso = 0;
         new_obj->hidden = 0;
         new_obj->top_en = 0;
+        new_obj->move_copy = 0;
+        new_obj->trans_refr = 0;
+        new_obj->trans_child = 0;
+        new_obj->layer = 0;
+        new_obj->cache = 0;
         new_obj->protect = LV_PROTECT_NONE;
         
         new_obj->ext = NULL;
@@ -204,7 +247,9 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
     }
 
     if(copy != NULL) {
-    	area_cpy(&new_obj->cords, &copy->cords);
+        /*Copy the size. The position is set below.*/
+        new_obj->cords.x2 = new_obj->cords.x1 + lv_obj_get_width(copy) - 1;
+        new_obj->cords.y2 = new_obj->cords.y1 + lv_obj_get_height(copy) - 1;
     	new_obj->ext_size = copy->ext_size;
 
         new_obj->opa = copy->opa;
@@ -221,12 +266,15 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         new_obj->drag_parent = copy->drag_parent;
         new_obj->hidden = copy->hidden;
         new_obj->top_en = copy->top_en;
+        new_obj->move_copy = copy->move_copy;
         new_obj->protect = copy->protect;
+        if(copy->cache != 0) lv_layer_cache_add(new_obj);
 
-        new_obj->style_p = copy->style_p;
+        lv_obj_style_unlink(new_obj);
+        lv_obj_style_link(new_obj, copy->style_p);
 
         if(copy->style_iso != 0) {
-            lv_obj_iso_style(new_obj, dm_get_size(copy->style_p));
+            lv_obj_iso_style(new_obj, slab_get_size(copy->style_p));
         }
 
     	lv_obj_set_pos(new_obj, lv_obj_get_x(copy), lv_obj_get_y(copy));
@@ -235,6 +283,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
 
     /*Send a signal to the parent to notify it about the new child*/
     if(parent != NULL) {
+        lv_dispi_hit_inv(parent);
         parent->signal_f(parent, LV_SIGNAL_CHILD_CHG, new_obj);
 
         /*Invalidate the area if not screen created*/
@@ -269,6 +318,10 @@ void lv_obj_del(lv_obj_t * obj)
     
     /*Remove the animations from this object*/
     anim_del(obj, NULL);
+    if(obj->layer != 0) lv_layer_del(obj);
+    if(obj->cache != 0) lv_layer_cache_rem(obj);
+    lv_cmd_rem_obj(obj);
+    lv_dispi_hit_inv(obj);
 
     /*Remove the object from parent's children list*/
     lv_obj_t * par = lv_obj_get_parent(obj);
@@ -276,6 +329,7 @@ void lv_obj_del(lv_obj_t * obj)
     	ll_rem(&scr_ll, obj);
     } else {
     	ll_rem(&(par->child_ll), obj);
+    	lv_dispi_hit_inv(par);
     }
 
     /* All children deleted.
@@ -283,13 +337,17 @@ void lv_obj_del(lv_obj_t * obj)
     obj->signal_f(obj, LV_SIGNAL_CLEANUP, NULL);
     
     /*Delete the base objects*/
-    if(obj->ext != NULL)  dm_free(obj->ext);
-    if(obj->style_iso != 0) dm_free(obj->style_p);
+    slab_free(obj->ext);
+    lv_obj_style_unlink(obj);
+    if(obj->style_iso != 0) slab_free(obj->style_p);
     dm_free(obj); /*Free the object itself*/
     
     /* Reset all display input (dispi) because 
      * the deleted object can be being pressed*/
     lv_dispi_reset();
+
+    /*Give back the slab chunks emptied by the whole subtree at once*/
+    slab_trim();
     
     /*Send a signal to the parent to notify it about the child delete*/
     if(par != NULL) {
@@ -359,31 +417,194 @@ lv_objs_t * lv_objs_get(lv_objs_builtin_t style, lv_objs_t * copy_p)
  */
 void lv_obj_inv(lv_obj_t * obj)
 {
+    lv_obj_refr_cords(obj);
+
+    /*Start with the original coordinates*/
+    area_t area;
+    cord_t ext_size = obj->ext_size;
+    area_cpy(&area, &obj->cords);
+    area.x1 -= ext_size;
+    area.y1 -= ext_size;
+    area.x2 += ext_size;
+    area.y2 += ext_size;
+
+    lv_obj_inv_area(obj, &area);
+}
+
+/**
+ * Mark only a part of an object as invalid. Useful when only a small part
+ * of a big object is changed (e.g. some lines of a label)
+ * @param obj pointer to an object
+ * @param area the area to redraw in absolute coordinates.
+ *             It will be truncated to the object and its parents
+ */
+void lv_obj_inv_area(lv_obj_t * obj, const area_t * area)
+{
+    lv_obj_refr_cords(obj);
+
+    /*Truncate to the extended area of the object*/
+    area_t area_trunc;
+    cord_t ext_size = obj->ext_size;
+    area_cpy(&area_trunc, &obj->cords);
+    area_trunc.x1 -= ext_size;
+    area_trunc.y1 -= ext_size;
+    area_trunc.x2 += ext_size;
+    area_trunc.y2 += ext_size;
+
+    bool union_ok = area_union(&area_trunc, &area_trunc, area);
+
+    /*The cached snapshots of the object and its parents have to be rendered again there*/
+    if(union_ok != false && obj->cache != 0) lv_layer_cache_inv(obj, &area_trunc);
+
+    /*Truncate recursively to the parents and find the screen in the same loop.
+     * Stop early if nothing remains.*/
+    lv_obj_t * scr = obj;
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    while(par != NULL && union_ok != false) {
+        union_ok = area_union(&area_trunc, &area_trunc, &par->cords);
+        if(union_ok != false && par->cache != 0) lv_layer_cache_inv(par, &area_trunc);
+        scr = par;
+        par = lv_obj_get_parent(par);
+    }
+
     /*Invalidate the object only if it belongs to the 'act_scr'*/
-    lv_obj_t * act_scr_p = lv_scr_act();
-    if(lv_obj_get_scr(obj) == act_scr_p) {
-        /*Truncate recursively to the parents*/
-        area_t area_trunc;
-        lv_obj_t * par = lv_obj_get_parent(obj);
-        bool union_ok = true;
-        /*Start with the original coordinates*/
-        cord_t ext_size = obj->ext_size;
-        area_cpy(&area_trunc, &obj->cords);
-        area_trunc.x1 -= ext_size;
-        area_trunc.y1 -= ext_size;
-        area_trunc.x2 += ext_size;
-        area_trunc.y2 += ext_size;
-
-        /*Check through all parents*/
-        while(par != NULL) {
-            union_ok = area_union(&area_trunc, &area_trunc, &par->cords);
-            if(union_ok == false) break; /*If no common parts with parent break;*/
-
-            par = lv_obj_get_parent(par);
-        }
+    if(union_ok != false && scr == lv_scr_act())  lv_inv_area(&area_trunc);
+}
+
+/**
+ * Move the drawn content of a part of an object on the display (e.g. to scroll the data of a chart)
+ * and invalidate only the exposed part. Possible only if nothing else is drawn on the area.
+ * @param obj pointer to an object
+ * @param area_p the area to move in absolute coordinates. It will be truncated to the object and its parents
+ * @param x_diff horizontal movement of the content
+ * @param y_diff vertical movement of the content
+ * @return true: the content is moved, false: the content can not be moved (invalidate the area instead)
+ */
+bool lv_obj_move_content(lv_obj_t * obj, const area_t * area_p, cord_t x_diff, cord_t y_diff)
+{
+    lv_obj_refr_cords(obj);
+
+    if(lv_obj_get_scr(obj) != lv_scr_act()) return true;    /*Not visible, nothing to do*/
+
+    /*The drawn content is not on the screen if it comes from a snapshot*/
+    if(obj->hidden != 0 || obj->layer != 0 || obj->cache != 0) return false;
 
-        if(union_ok != false)  lv_inv_area(&area_trunc);
+    /*The parents would be visible on the area*/
+    if(obj->opa != OPA_COVER || LV_SA(obj, lv_objs_t)->transp != 0) return false;
+
+    /*Truncate to the object and its parents*/
+    area_t vis;
+    if(area_union(&vis, area_p, &obj->cords) == false) return true;
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    while(par != NULL) {
+        if(par->hidden != 0) return false;
+        if(area_union(&vis, &vis, &par->cords) == false) return true;
+        par = lv_obj_get_parent(par);
+    }
+
+    /*The children are drawn on the content*/
+    lv_obj_t * child;
+    area_t child_area;
+    LL_READ(obj->child_ll, child) {
+        if(child->hidden != 0) continue;
+        lv_obj_get_cords(child, &child_area);
+        child_area.x1 -= child->ext_size;
+        child_area.y1 -= child->ext_size;
+        child_area.x2 += child->ext_size;
+        child_area.y2 += child->ext_size;
+        if(area_is_on(&vis, &child_area) != false) return false;
     }
+
+    if(obj->design_f(obj, &vis, LV_DESIGN_COVER_CHK) == false) return false;
+    if(lv_obj_is_top(obj, &vis) == false) return false;
+
+    return lv_inv_area_move(&vis, x_diff, y_diff);
+}
+
+/**
+ * Refresh the absolute coordinates of an object (and its parents) if a parent was moved since.
+ * The children are not updated when an object is moved only when they are used.
+ * Call it before reading 'obj->cords' directly.
+ * @param obj pointer to an object
+ */
+void lv_obj_refr_cords(lv_obj_t * obj)
+{
+    lv_obj_t * par = obj->par;
+    if(par == NULL) return;     /*The screens are never moved*/
+
+    lv_obj_refr_cords(par);
+
+    /* Up to date if not calculated before the last move of the parent.
+     * If not the children will be outdated too
+     * because they can't be newer than the parent's movement */
+    if(obj->cords_gen >= par->cords_gen) return;
+
+    cord_t w = area_get_width(&obj->cords);
+    cord_t h = area_get_height(&obj->cords);
+    obj->cords.x1 = par->cords.x1 + obj->rel.x;
+    obj->cords.y1 = par->cords.y1 + obj->rel.y;
+    obj->cords.x2 = obj->cords.x1 + w - 1;
+    obj->cords.y2 = obj->cords.y1 + h - 1;
+    obj->cords_gen = par->cords_gen;
+}
+
+/**
+ * Begin a transaction. Until 'lv_obj_trans_commit' the layout refreshes are deferred
+ * and the invalidated areas are collected into one area. Transactions can be nested.
+ */
+void lv_obj_trans_begin(void)
+{
+    if(trans_cnt == 0) lv_inv_hold();
+    trans_cnt++;
+}
+
+/**
+ * Commit a transaction. Committing the outermost transaction refreshes
+ * every affected layout once (children first) and invalidates the collected area.
+ */
+void lv_obj_trans_commit(void)
+{
+    if(trans_cnt == 0) return;
+    if(trans_cnt > 1) {
+        trans_cnt--;
+        return;
+    }
+
+    /* The transaction is kept open while refreshing, so a layout refresh
+     * which changes a parent only defers the parent's refresh.
+     * The parents are refreshed after their children so every layout runs once.
+     * Repeat if a refresh has marked an already visited object again.*/
+    bool again;
+    do {
+        again = false;
+        lv_obj_t * scr;
+        LL_READ(scr_ll, scr) {
+            if(scr->trans_child != 0) {
+                lv_obj_trans_refr(scr);
+                again = true;
+            }
+        }
+    } while(again != false);
+
+    trans_cnt = 0;
+    lv_inv_release();
+}
+
+/**
+ * Defer the layout refresh of an object to the end of the current transaction.
+ * Used by the object types which refresh their layout on signals.
+ * @param obj pointer to an object
+ * @return true: deferred, a 'LV_SIGNAL_CHILD_CHG' signal will be sent at commit;
+ *         false: there is no transaction, refresh the layout now
+ */
+bool lv_obj_trans_defer(lv_obj_t * obj)
+{
+    if(trans_cnt == 0 || obj == trans_act) return false;
+
+    obj->trans_refr = 1;
+    lv_obj_trans_mark(obj);
+
+    return true;
 }
 
 
@@ -423,9 +644,30 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     old_pos.x = lv_obj_get_x(obj);
     old_pos.y = lv_obj_get_y(obj);
     
-    ll_chg_list(&obj->par->child_ll, &parent->child_ll, obj);
+    lv_obj_t * old_par = obj->par;
+    lv_dispi_hit_inv(old_par);
+    lv_dispi_hit_inv(parent);
+    ll_chg_list(&old_par->child_ll, &parent->child_ll, obj);
     obj->par = parent;
-    lv_obj_set_pos(obj, old_pos.x, old_pos.y);
+
+    /*Take the deferred layout refreshes of the subtree to the new parent*/
+    if(obj->trans_child != 0) {
+        obj->trans_child = 0;
+        lv_obj_trans_mark(obj);
+    }
+
+    /*Keep the relative position on the new parent. The children will follow it.*/
+    area_t ori;
+    lv_obj_get_cords(obj, &ori);
+    lv_obj_refr_cords(parent);
+    obj->cords.x1 = parent->cords.x1 + old_pos.x;
+    obj->cords.y1 = parent->cords.y1 + old_pos.y;
+    obj->cords.x2 = obj->cords.x1 + area_get_width(&ori) - 1;
+    obj->cords.y2 = obj->cords.y1 + area_get_height(&ori) - 1;
+    cords_gen_act++;
+    obj->cords_gen = cords_gen_act;
+
+    obj->signal_f(obj, LV_SIGNAL_CORD_CHG, &ori);
 
     /*Notify the original parent because one of its children is lost*/
     obj->par->signal_f(obj->par, LV_SIGNAL_CHILD_CHG, NULL);
@@ -450,6 +692,7 @@ void lv_obj_set_pos(lv_obj_t * obj, cord_t x, cord_t y)
 {
     /*Convert x and y to absolute coordinates*/
     lv_obj_t * par = obj->par;
+    lv_obj_refr_cords(obj);
     x = x + par->cords.x1;
     y = y + par->cords.y1;
     
@@ -463,8 +706,10 @@ void lv_obj_set_pos(lv_obj_t * obj, cord_t x, cord_t y)
      * occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
         
-    /*Invalidate the original area*/
-    lv_obj_inv(obj);
+    /*Move the drawn content if possible else invalidate the original area*/
+    bool moved = false;
+    if(obj->move_copy != 0) moved = lv_obj_move_drawn(obj, diff.x, diff.y);
+    if(moved == false) lv_obj_inv(obj);
 
     /*Save the original coordinates*/
     area_t ori;
@@ -474,17 +719,22 @@ void lv_obj_set_pos(lv_obj_t * obj, cord_t x, cord_t y)
     obj->cords.y1 += diff.y;
     obj->cords.x2 += diff.x;
     obj->cords.y2 += diff.y;
+    obj->rel.x += diff.x;
+    obj->rel.y += diff.y;
     
-    lv_obj_pos_child_refr(obj, diff.x, diff.y);
+    /*The children are outdated now. They will be refreshed when used.*/
+    cords_gen_act++;
+    obj->cords_gen = cords_gen_act;
     
     /*Inform the object about its new coordinates*/
     obj->signal_f(obj, LV_SIGNAL_CORD_CHG, &ori);
     
     /*Send a signal to the parent too*/
+    lv_dispi_hit_inv(par);
     par->signal_f(par, LV_SIGNAL_CHILD_CHG, obj);
     
     /*Invalidate the new area*/
-    lv_obj_inv(obj);
+    if(moved == false) lv_obj_inv(obj);
 }
 
 /**
@@ -557,7 +807,7 @@ void lv_obj_set_size(lv_obj_t * obj, cord_t w, cord_t h)
 		return;
 	}
 
-    /*Invalidate the original area*/
+    /*Invalidate the original area (it refreshes the coordinates too)*/
     lv_obj_inv(obj);
     
     /*Save the original coordinates*/
@@ -574,7 +824,10 @@ void lv_obj_set_size(lv_obj_t * obj, cord_t w, cord_t h)
     
     /*Send a signal to the parent too*/
     lv_obj_t * par = lv_obj_get_parent(obj);
-    if(par != NULL) par->signal_f(par, LV_SIGNAL_CHILD_CHG, obj);
+    if(par != NULL) {
+        lv_dispi_hit_inv(par);
+        par->signal_f(par, LV_SIGNAL_CHILD_CHG, obj);
+    }
     
     /*Invalidate the new area*/
     lv_obj_inv(obj);
@@ -591,6 +844,33 @@ void lv_obj_set_size_us(lv_obj_t * obj, cord_t w, cord_t h)
 	lv_obj_set_size(obj, w * LV_DOWNSCALE, h * LV_DOWNSCALE);
 }
 
+/**
+ * Set the absolute coordinates of an object without moving its children
+ * and without sending signals. Used when an object fits to its children.
+ * @param obj pointer to an object
+ * @param cords pointer to the new coordinates
+ */
+void lv_obj_set_cords(lv_obj_t * obj, const area_t * cords)
+{
+    lv_obj_refr_cords(obj);
+
+    cord_t dx = cords->x1 - obj->cords.x1;
+    cord_t dy = cords->y1 - obj->cords.y1;
+    area_cpy(&obj->cords, cords);
+    obj->rel.x += dx;
+    obj->rel.y += dy;
+
+    /*Keep the children on their place*/
+    if(dx != 0 || dy != 0) {
+        lv_obj_t * i;
+        LL_READ(obj->child_ll, i) {
+            i->rel.x -= dx;
+            i->rel.y -= dy;
+        }
+        lv_dispi_hit_inv(obj);
+    }
+}
+
 /**
  * Set the width of an object
  * @param obj pointer to an object
@@ -756,6 +1036,8 @@ void lv_obj_align(lv_obj_t * obj,lv_obj_t * base, lv_align_t align, cord_t x_mod
 
     /*Bring together the coordination system of base and obj*/
     lv_obj_t * par = lv_obj_get_parent(obj);
+    lv_obj_refr_cords(base);
+    lv_obj_refr_cords(par);
     cord_t base_abs_x = base->cords.x1;
     cord_t base_abs_y = base->cords.y1;
     cord_t par_abs_x = par->cords.x1;
@@ -807,11 +1089,15 @@ void lv_obj_set_style(lv_obj_t * obj, void * style)
 {
     lv_obj_inv(obj);
 
-	if(obj->style_iso != 0) {
-		dm_free(obj->style_p);
-		obj->style_iso = 0;
-	}
-    obj->style_p = style;
+    /*Keep the registration if the style is not changed*/
+    if(obj->style_p != style) {
+        lv_obj_style_unlink(obj);
+        if(obj->style_iso != 0) {
+            slab_free(obj->style_p);
+            obj->style_iso = 0;
+        }
+        lv_obj_style_link(obj, style);
+    }
 
     /*Send a style change signal to the object*/
     lv_obj_refr_style(obj);
@@ -829,12 +1115,13 @@ void * lv_obj_iso_style(lv_obj_t * obj, uint32_t style_size)
 	if(obj->style_iso != 0) return obj->style_p;
 
 	void * ori_style_p = lv_obj_get_style(obj);
-	void * iso_style = dm_alloc(style_size);
+	void * iso_style = slab_alloc(style_size);
 	dm_assert(iso_style);
 	memcpy(iso_style, ori_style_p, style_size);
 
 	obj->style_iso = 1;
-	obj->style_p = iso_style;
+	lv_obj_style_unlink(obj);
+	lv_obj_style_link(obj, iso_style);
 
 	lv_obj_refr_style(obj);
 
@@ -879,6 +1166,9 @@ void lv_obj_set_opar(lv_obj_t * obj, uint8_t opa)
  */
 void lv_obj_refr_style(lv_obj_t * obj)
 {
+    lv_style_reg_t * reg = lv_style_reg_find(obj->style_p, false);
+    if(reg != NULL) reg->gen = ++style_gen_act;
+
     lv_obj_inv(obj);
     obj->signal_f(obj, LV_SIGNAL_STYLE_CHG, NULL);
     lv_obj_inv(obj);
@@ -893,9 +1183,60 @@ void lv_obj_refr_style(lv_obj_t * obj)
 void lv_style_refr_all(void * style)
 {
     lv_obj_t * i;
-    LL_READ(scr_ll, i) {
-        lv_style_refr_core(style, i);
+
+    /*Refresh every object*/
+    if(style == NULL) {
+        uint16_t slot;
+        lv_style_reg_t * reg;
+        for(slot = 0; slot < LV_STYLE_REG_SLOTS; slot++) {
+            for(reg = style_reg[slot]; reg != NULL; reg = reg->next) {
+                reg->gen = ++style_gen_act;
+            }
+        }
+
+        LL_READ(scr_ll, i) {
+            lv_style_refr_core(i);
+        }
+        return;
     }
+
+    /*Notify only the users of 'style'*/
+    lv_style_reg_t * reg = lv_style_reg_find(style, false);
+    if(reg == NULL) return;
+
+    reg->gen = ++style_gen_act;
+
+    /* Save the users first because the signal functions can change
+     * the styles (and so the user list) of other objects*/
+    uint16_t user_cnt = reg->user_cnt;
+    lv_obj_t ** users = dm_alloc(user_cnt * sizeof(lv_obj_t *));
+    dm_assert(users);
+
+    uint16_t u = 0;
+    for(i = reg->users; i != NULL; i = i->style_next) {
+        users[u] = i;
+        u++;
+    }
+
+    for(u = 0; u < user_cnt; u++) {
+        users[u]->signal_f(users[u], LV_SIGNAL_STYLE_CHG, NULL);
+        lv_obj_inv(users[u]);
+    }
+
+    dm_free(users);
+}
+
+/**
+ * Get the generation of a style. It is changed every time the objects are notified
+ * about the style is modified, so a cached drawing can be validated by saving it.
+ * @param style pointer to a style
+ * @return the generation of the style (0 if no object uses the style)
+ */
+uint32_t lv_style_get_gen(void * style)
+{
+    lv_style_reg_t * reg = lv_style_reg_find(style, false);
+
+    return reg == NULL ? 0 : reg->gen;
 }
 
 
@@ -940,6 +1281,31 @@ void lv_obj_set_top(lv_obj_t * obj, bool en)
     obj->top_en= (en == true ? 1 : 0);
 }
 
+/**
+ * Enable to move the already drawn content of an object instead of redraw it
+ * when the object is moved (e.g. the scrollable part of a page) or its content is shifted (e.g. a chart).
+ * Has effect only if a copy function is set with 'lv_refr_set_copy_f'.
+ * @param obj pointer to an object
+ * @param en true: enable moving the drawn content
+ */
+void lv_obj_set_move_copy(lv_obj_t * obj, bool en)
+{
+    obj->move_copy = (en == true ? 1 : 0);
+}
+
+/**
+ * Cache the drawn object and its children in a snapshot. The snapshot is rendered again
+ * only when the object or its children are changed, not when e.g. an other object
+ * slides over it. Useful for complex, rarely changing objects.
+ * @param obj pointer to an object
+ * @param en true: enable the caching (has no effect without memory for the cache)
+ */
+void lv_obj_set_cache(lv_obj_t * obj, bool en)
+{
+    if(en != false) lv_layer_cache_add(obj);
+    else lv_layer_cache_rem(obj);
+}
+
 /**
  * Enable the dragging of an object
  * @param obj pointer to an object
@@ -1025,7 +1391,7 @@ void lv_obj_set_design_f(lv_obj_t * obj, lv_design_f_t fp)
  */
 void * lv_obj_alloc_ext(lv_obj_t * obj, uint16_t ext_size)
 {
-    obj->ext = dm_realloc(obj->ext, ext_size); 
+    obj->ext = slab_realloc(obj->ext, ext_size);
     
    return (void*)obj->ext;
 }
@@ -1078,6 +1444,12 @@ void lv_obj_anim(lv_obj_t * obj, lv_anim_builtin_t type, uint16_t time, uint16_t
 {
 	lv_obj_t * par = lv_obj_get_parent(obj);
 
+	/*Transform only a snapshot of the object if required and possible*/
+	if((type & ANIM_LAYER) != 0) {
+		type = type & (~ANIM_LAYER);
+		if(lv_layer_anim(obj, type, time, delay, cb) != false) return;
+	}
+
 	/*Get the direction*/
 	bool out = (type & ANIM_DIR_MASK) == ANIM_IN ? false : true;
 	type = type & (~ANIM_DIR_MASK);
@@ -1243,6 +1615,7 @@ uint16_t lv_obj_get_child_num(lv_obj_t * obj)
  */
 void lv_obj_get_cords(lv_obj_t * obj, area_t * cords_p)
 {
+    lv_obj_refr_cords(obj);
     area_cpy(cords_p, &obj->cords);
 }
 
@@ -1254,11 +1627,7 @@ void lv_obj_get_cords(lv_obj_t * obj, area_t * cords_p)
  */
 cord_t lv_obj_get_x(lv_obj_t * obj)
 {
-    cord_t rel_x;
-    lv_obj_t * parent = lv_obj_get_parent(obj);
-    rel_x = obj->cords.x1 - parent->cords.x1;
-    
-    return rel_x;
+    return obj->rel.x;
 }
 
 /**
@@ -1268,11 +1637,7 @@ cord_t lv_obj_get_x(lv_obj_t * obj)
  */
 cord_t lv_obj_get_y(lv_obj_t * obj)
 {
-    cord_t rel_y;
-    lv_obj_t * parent = lv_obj_get_parent(obj);
-    rel_y = obj->cords.y1 - parent->cords.y1;
-    
-    return rel_y;
+    return obj->rel.y;
 }
 
 /**
@@ -1363,6 +1728,26 @@ bool lv_obj_get_top(lv_obj_t * obj)
     return obj->top_en == 0 ? false : true;;
 }
 
+/**
+ * Get the move copy attribute of an object
+ * @param obj pointer to an object
+ * @return true: the drawn content is moved when the object is moved
+ */
+bool lv_obj_get_move_copy(lv_obj_t * obj)
+{
+    return obj->move_copy == 0 ? false : true;
+}
+
+/**
+ * Get the cache attribute of an object
+ * @param obj pointer to an object
+ * @return true: the object is drawn from a cached snapshot
+ */
+bool lv_obj_get_cache(lv_obj_t * obj)
+{
+    return obj->cache == 0 ? false : true;
+}
+
 /**
  * Get the drag enable attribute of an object
  * @param obj pointer to an object
@@ -1487,6 +1872,40 @@ void * lv_obj_get_free_p(lv_obj_t * obj)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Mark an object and its parents as having a deferred layout refresh in the subtree
+ * @param obj pointer to an object
+ */
+static void lv_obj_trans_mark(lv_obj_t * obj)
+{
+    while(obj != NULL && obj->trans_child == 0) {
+        obj->trans_child = 1;
+        obj = lv_obj_get_parent(obj);
+    }
+}
+
+/**
+ * Refresh the deferred layouts in a subtree. The children are refreshed first.
+ * @param obj pointer to an object with 'trans_child' set
+ */
+static void lv_obj_trans_refr(lv_obj_t * obj)
+{
+    obj->trans_child = 0;
+
+    lv_obj_t * i;
+    LL_READ(obj->child_ll, i) {
+        if(i->trans_child != 0) lv_obj_trans_refr(i);
+    }
+
+    if(obj->trans_refr != 0) {
+        obj->trans_refr = 0;
+        lv_obj_t * act_prev = trans_act;
+        trans_act = obj;
+        obj->signal_f(obj, LV_SIGNAL_CHILD_CHG, NULL);
+        trans_act = act_prev;
+    }
+}
+
 /**
  * Handle the drawing related tasks of the base objects.
  * @param obj pointer to an object
@@ -1519,39 +1938,172 @@ static bool lv_obj_design(lv_obj_t * obj, const  area_t * mask_p, lv_design_mode
 }
 
 /**
- * Reposition the children of an object. (Called recursively)
- * @param obj pointer to an object which children will be repositioned
+ * Move the drawn content of an object on the display before the object is moved.
+ * It is possible only if the object covers the same visible area of its parents
+ * before and after the movement and nothing is drawn on it.
+ * @param obj pointer to an object which is being moved (with the original coordinates)
  * @param x_diff x coordinate shift
  * @param y_diff y coordinate shift
+ * @return true: the drawn content is moved, false: the object has to be redrawn
  */
-static void lv_obj_pos_child_refr(lv_obj_t * obj, cord_t x_diff, cord_t y_diff)
+static bool lv_obj_move_drawn(lv_obj_t * obj, cord_t x_diff, cord_t y_diff)
 {
-    lv_obj_t * i;   
-    LL_READ(obj->child_ll, i) {
-        i->cords.x1 += x_diff;
-        i->cords.y1 += y_diff;
-        i->cords.x2 += x_diff;
-        i->cords.y2 += y_diff;
-        
-        lv_obj_pos_child_refr(i, x_diff, y_diff);
+    if(lv_obj_get_scr(obj) != lv_scr_act()) return false;
+
+    /*The visible area is given by the parents*/
+    area_t vis;
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par == NULL) return false;
+    area_cpy(&vis, &par->cords);
+    while(par != NULL) {
+        if(par->hidden != 0) return false;
+        if(area_union(&vis, &vis, &par->cords) == false) return true;   /*Not visible at all*/
+        par = lv_obj_get_parent(par);
+    }
+
+    /*The object has to cover the same visible area before and after the movement*/
+    area_t moved;
+    area_t vis_ori;
+    area_cpy(&moved, &obj->cords);
+    moved.x1 += x_diff;
+    moved.y1 += y_diff;
+    moved.x2 += x_diff;
+    moved.y2 += y_diff;
+    if(area_union(&vis_ori, &vis, &obj->cords) == false) return false;
+    if(area_union(&vis, &vis, &moved) == false) return false;
+    if(vis.x1 != vis_ori.x1 || vis.y1 != vis_ori.y1 ||
+       vis.x2 != vis_ori.x2 || vis.y2 != vis_ori.y2) {
+        return false;
+    }
+
+    if(obj->hidden != 0 || obj->opa != OPA_COVER || LV_SA(obj, lv_objs_t)->transp != 0 ||
+       obj->design_f(obj, &vis, LV_DESIGN_COVER_CHK) == false) {
+        return false;
+    }
+
+    /*The drawn content is not on the screen if it comes from a snapshot*/
+    if(obj->layer != 0) return false;
+
+    if(lv_obj_is_top(obj, &vis) == false) return false;
+
+    return lv_inv_area_move(&vis, x_diff, y_diff);
+}
+
+/**
+ * Tell whether an object is drawn on the top of an area directly on the screen,
+ * i.e. no younger sibling of it or its parents is drawn there and it's not in a snapshot
+ * @param obj pointer to an object
+ * @param area_p an area in absolute coordinates
+ * @return true: only 'obj' (and its parents) are drawn on the area
+ */
+static bool lv_obj_is_top(lv_obj_t * obj, const area_t * area_p)
+{
+    /*The younger siblings of the object and its parents are drawn later (on top of it)*/
+    lv_obj_t * i = obj;
+    lv_obj_t * sibling;
+    area_t sibling_area;
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    while(par != NULL) {
+        /*The snapshot of a parent has to be updated too*/
+        if(par->layer != 0 || par->cache != 0) return false;
+
+        LL_READ(par->child_ll, sibling) {
+            if(sibling == i) break;
+            if(sibling->hidden != 0) continue;
+            if(sibling->layer != 0) return false;   /*Can be drawn anywhere*/
+            lv_obj_get_cords(sibling, &sibling_area);
+            sibling_area.x1 -= sibling->ext_size;
+            sibling_area.y1 -= sibling->ext_size;
+            sibling_area.x2 += sibling->ext_size;
+            sibling_area.y2 += sibling->ext_size;
+            if(area_is_on(area_p, &sibling_area) != false) return false;
+        }
+        i = par;
+        par = lv_obj_get_parent(par);
     }
+
+    return true;
 }
 
 /**
  * Refresh the style of all children of an object. (Called recursively)
- * @param style_p refresh objects only with this style. (ignore is if NULL)
  * @param obj pointer to an object
  */
-static void lv_style_refr_core(void * style_p, lv_obj_t * obj)
+static void lv_style_refr_core(lv_obj_t * obj)
 {
     lv_obj_t * i;
     LL_READ(obj->child_ll, i) {
-        if(i->style_p == style_p || style_p == NULL) {
-            i->signal_f(i, LV_SIGNAL_STYLE_CHG, NULL);
-            lv_obj_inv(i);
-        }
-        
-        lv_style_refr_core(style_p, i);
+        i->signal_f(i, LV_SIGNAL_STYLE_CHG, NULL);
+        lv_obj_inv(i);
+
+        lv_style_refr_core(i);
+    }
+}
+
+/**
+ * Find the registry entry of a style
+ * @param style pointer to a style
+ * @param create true: add a new entry if the style is not registered yet
+ * @return pointer to the entry or NULL if not found
+ */
+static lv_style_reg_t * lv_style_reg_find(void * style, bool create)
+{
+    lv_style_reg_t ** slot = &style_reg[((uintptr_t)style >> 2) % LV_STYLE_REG_SLOTS];
+    lv_style_reg_t * reg;
+    for(reg = *slot; reg != NULL; reg = reg->next) {
+        if(reg->style == style) return reg;
+    }
+
+    if(create == false) return NULL;
+
+    reg = slab_alloc(sizeof(lv_style_reg_t));
+    dm_assert(reg);
+    reg->style = style;
+    reg->users = NULL;
+    reg->user_cnt = 0;
+    reg->gen = ++style_gen_act;
+    reg->next = *slot;
+    *slot = reg;
+
+    return reg;
+}
+
+/**
+ * Set the style of an object and add the object to the users of the style
+ * @param obj pointer to an object (not linked to any style)
+ * @param style pointer to a style
+ */
+static void lv_obj_style_link(lv_obj_t * obj, void * style)
+{
+    lv_style_reg_t * reg = lv_style_reg_find(style, true);
+
+    obj->style_p = style;
+    obj->style_prev = NULL;
+    obj->style_next = reg->users;
+    if(reg->users != NULL) reg->users->style_prev = obj;
+    reg->users = obj;
+    reg->user_cnt++;
+}
+
+/**
+ * Remove an object from the users of its style.
+ * The entry of the style is freed when it has no more users.
+ * @param obj pointer to an object
+ */
+static void lv_obj_style_unlink(lv_obj_t * obj)
+{
+    lv_style_reg_t * reg = lv_style_reg_find(obj->style_p, false);
+
+    if(obj->style_prev != NULL) obj->style_prev->style_next = obj->style_next;
+    else reg->users = obj->style_next;
+    if(obj->style_next != NULL) obj->style_next->style_prev = obj->style_prev;
+    reg->user_cnt--;
+
+    if(reg->user_cnt == 0) {
+        lv_style_reg_t ** i = &style_reg[((uintptr_t)obj->style_p >> 2) % LV_STYLE_REG_SLOTS];
+        while(*i != reg) i = &(*i)->next;
+        *i = reg->next;
+        slab_free(reg);
     }
 }
 
@@ -1577,6 +2129,10 @@ static void lv_obj_del_child(lv_obj_t * obj)
 
    /*Remove the animations from this object*/
    anim_del(obj, NULL);
+   if(obj->layer != 0) lv_layer_del(obj);
+   if(obj->cache != 0) lv_layer_cache_rem(obj);
+   lv_cmd_rem_obj(obj);
+   lv_dispi_hit_inv(obj);
 
    /*Remove the object from parent's children list*/
    lv_obj_t * par = lv_obj_get_parent(obj);
@@ -1588,8 +2144,9 @@ static void lv_obj_del_child(lv_obj_t * obj)
    obj->signal_f(obj, LV_SIGNAL_CLEANUP, NULL);
 
    /*Delete the base objects*/
-   if(obj->ext != NULL)  dm_free(obj->ext);
-   if(obj->style_iso != 0) dm_free(obj->style_p);
+   slab_free(obj->ext);
+   lv_obj_style_unlink(obj);
+   if(obj->style_iso != 0) slab_free(obj->style_p);
    dm_free(obj); /*Free the object itself*/
 
 }
@@ -39,6 +39,7 @@
 #define ANIM_IN					0x00	/*Animation to show an object. 'OR' it with lv_anim_builtin_t*/
 #define ANIM_OUT				0x80    /*Animation to hide an object. 'OR' it with lv_anim_builtin_t*/
 #define ANIM_DIR_MASK			0x80	/*ANIM_IN/ANIM_OUT mask*/
+#define ANIM_LAYER				0x40	/*Animate a snapshot of the object (see lv_layer.h). 'OR' it with lv_anim_builtin_t*/
 
 /**********************
  *      TYPEDEFS
@@ -79,13 +80,17 @@ typedef struct __LV_OBJ_T
     struct __LV_OBJ_T * par;
     ll_dsc_t child_ll;
     
-    area_t cords;
+    area_t cords;               /*Absolute coordinates. Use 'lv_obj_refr_cords' before reading them directly*/
+    point_t rel;                /*Position relative to the parent*/
+    uint32_t cords_gen;         /*'cords' are up to date if it's not less than the parent's 'cords_gen'*/
 
     lv_signal_f_t signal_f;
     lv_design_f_t design_f;
     
     void * ext;           /*The object attributes can be extended here*/
     void * style_p;       /*Object specific style*/
+    struct __LV_OBJ_T * style_next; /*Next object with the same style*/
+    struct __LV_OBJ_T * style_prev; /*Previous object with the same style*/
 
 #if LV_OBJ_FREE_P != 0
     void * free_p;        /*Application specific pointer (set it freely)*/
@@ -99,7 +104,11 @@ typedef struct __LV_OBJ_T
     uint8_t style_iso	 :1;	/*1: The object has got an own style*/
     uint8_t hidden       :1;    /*1: Object is hidden*/
     uint8_t top_en       :1;    /*1: If the object or its children  is clicked it goes to the foreground*/
-    uint8_t reserved     :1;
+    uint8_t move_copy    :1;    /*1: Move the drawn content instead of redraw it when the object is moved (e.g. scrolling)*/
+    uint8_t trans_refr   :1;    /*1: Refresh the layout when the transaction is committed*/
+    uint8_t trans_child  :1;    /*1: The object or one of its children has a deferred layout refresh*/
+    uint8_t layer        :1;    /*1: The object is drawn from a snapshot (see lv_layer.h)*/
+    uint8_t cache        :1;    /*1: The object is drawn from a cached snapshot (see lv_obj_set_cache)*/
 
     uint8_t protect;            /*Automatically happening actions can be prevented. 'OR'ed values from lv_obj_prot_t*/
 
@@ -187,6 +196,55 @@ void lv_init(void);
  */
 void lv_obj_inv(lv_obj_t * obj);
 
+/**
+ * Mark only a part of an object as invalid. Useful when only a small part
+ * of a big object is changed (e.g. some lines of a label)
+ * @param obj pointer to an object
+ * @param area the area to redraw in absolute coordinates.
+ *             It will be truncated to the object and its parents
+ */
+void lv_obj_inv_area(lv_obj_t * obj, const area_t * area);
+
+/**
+ * Move the drawn content of a part of an object on the display (e.g. to scroll the data of a chart)
+ * and invalidate only the exposed part. Possible only if nothing else is drawn on the area.
+ * @param obj pointer to an object
+ * @param area_p the area to move in absolute coordinates. It will be truncated to the object and its parents
+ * @param x_diff horizontal movement of the content
+ * @param y_diff vertical movement of the content
+ * @return true: the content is moved, false: the content can not be moved (invalidate the area instead)
+ */
+bool lv_obj_move_content(lv_obj_t * obj, const area_t * area_p, cord_t x_diff, cord_t y_diff);
+
+/**
+ * Refresh the absolute coordinates of an object (and its parents) if a parent was moved since.
+ * The children are not updated when an object is moved only when they are used.
+ * Call it before reading 'obj->cords' directly.
+ * @param obj pointer to an object
+ */
+void lv_obj_refr_cords(lv_obj_t * obj);
+
+/**
+ * Begin a transaction. Until 'lv_obj_trans_commit' the layout refreshes are deferred
+ * and the invalidated areas are collected into one area. Transactions can be nested.
+ */
+void lv_obj_trans_begin(void);
+
+/**
+ * Commit a transaction. Committing the outermost transaction refreshes
+ * every affected layout once (children first) and invalidates the collected area.
+ */
+void lv_obj_trans_commit(void);
+
+/**
+ * Defer the layout refresh of an object to the end of the current transaction.
+ * Used by the object types which refresh their layout on signals.
+ * @param obj pointer to an object
+ * @return true: deferred, a 'LV_SIGNAL_CHILD_CHG' signal will be sent at commit;
+ *         false: there is no transaction, refresh the layout now
+ */
+bool lv_obj_trans_defer(lv_obj_t * obj);
+
 /**
  * Notify an object about its style is modified
  * @param obj pointer to an object
@@ -200,6 +258,14 @@ void lv_obj_refr_style(lv_obj_t * obj);
  */
 void lv_style_refr_all(void * style);
 
+/**
+ * Get the generation of a style. It is changed every time the objects are notified
+ * about the style is modified, so a cached drawing can be validated by saving it.
+ * @param style pointer to a style
+ * @return the generation of the style (0 if no object uses the style)
+ */
+uint32_t lv_style_get_gen(void * style);
+
 /**
  * Create a basic object
  * @param parent pointer to a parent object.
@@ -308,6 +374,14 @@ void lv_obj_set_size(lv_obj_t * obj, cord_t w, cord_t h);
  */
 void lv_obj_set_size_us(lv_obj_t * obj, cord_t w, cord_t h);
 
+/**
+ * Set the absolute coordinates of an object without moving its children
+ * and without sending signals. Used when an object fits to its children.
+ * @param obj pointer to an object
+ * @param cords pointer to the new coordinates
+ */
+void lv_obj_set_cords(lv_obj_t * obj, const area_t * cords);
+
 /**
  * Set the width of an object
  * @param obj pointer to an object
@@ -413,6 +487,24 @@ void lv_obj_set_click(lv_obj_t * obj, bool en);
  */
 void lv_obj_set_top(lv_obj_t * obj, bool en);
 
+/**
+ * Enable to move the already drawn content of an object instead of redraw it
+ * when the object is moved (e.g. the scrollable part of a page) or its content is shifted (e.g. a chart).
+ * Has effect only if a copy function is set with 'lv_refr_set_copy_f'.
+ * @param obj pointer to an object
+ * @param en true: enable moving the drawn content
+ */
+void lv_obj_set_move_copy(lv_obj_t * obj, bool en);
+
+/**
+ * Cache the drawn object and its children in a snapshot. The snapshot is rendered again
+ * only when the object or its children are changed, not when e.g. an other object
+ * slides over it. Useful for complex, rarely changing objects.
+ * @param obj pointer to an object
+ * @param en true: enable the caching (has no effect without memory for the cache)
+ */
+void lv_obj_set_cache(lv_obj_t * obj, bool en);
+
 /**
  * Enable the dragging of an object
  * @param obj pointer to an object
@@ -617,6 +709,20 @@ bool lv_obj_get_click(lv_obj_t * obj);
  */
 bool lv_obj_get_top(lv_obj_t * obj);
 
+/**
+ * Get the move copy attribute of an object
+ * @param obj pointer to an object
+ * @return true: the drawn content is moved when the object is moved
+ */
+bool lv_obj_get_move_copy(lv_obj_t * obj);
+
+/**
+ * Get the cache attribute of an object
+ * @param obj pointer to an object
+ * @return true: the object is drawn from a cached snapshot
+ */
+bool lv_obj_get_cache(lv_obj_t * obj);
+
 /**
  * Get the drag enable attribute of an object
  * @param obj pointer to an object
@@ -10,8 +10,14 @@
 #include "lv_conf.h"
 #include "misc/os/ptask.h"
 #include "misc/mem/fifo.h"
+#include "misc/math/math_base.h"
 #include "lv_refr.h"
 #include "lv_vdb.h"
+#include "lv_layer.h"
+#include "lv_dispi.h"
+#include "lv_cmd.h"
+#include "hal/systick/systick.h"
+#include "lvgl/lv_misc/anim.h"
 
 /*********************
  *      DEFINES
@@ -41,12 +47,19 @@ static void lv_refr_area_part_vdb(const area_t * area_p);
 static lv_obj_t * lv_refr_get_top_obj(const area_t * area_p, lv_obj_t * obj);
 static void lv_refr_make(lv_obj_t * top_p, const area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p);
+static void lv_refr_get_ext_area(lv_obj_t * obj, area_t * area_p);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 lv_join_t inv_buf[LV_INV_FIFO_SIZE];
 uint16_t inv_buf_p;
+static lv_refr_copy_f_t refr_copy_f;
+static ptask_t * refr_task;
+static uint32_t refr_last_run;  /*Time of the last refresh (tracked here because 'ptask_t' is private to misc)*/
+static bool inv_hold;           /*Collect the invalidated areas into 'inv_hold_area'*/
+static bool inv_hold_valid;     /*'inv_hold_area' contains an area*/
+static area_t inv_hold_area;
 
 /**********************
  *      MACROS
@@ -64,10 +77,9 @@ void lv_refr_init(void)
     inv_buf_p = 0;
     memset(inv_buf, 0, sizeof(inv_buf));
 
-    ptask_t* task;
-    task = ptask_create(lv_refr_task, LV_REFR_PERIOD, PTASK_PRIO_MID, NULL);
-    dm_assert(task);
-    
+    refr_last_run = systick_get();
+    refr_task = ptask_create(lv_refr_task, LV_REFR_PERIOD, PTASK_PRIO_MID, NULL);
+    dm_assert(refr_task);
 }
 
 /**
@@ -98,6 +110,14 @@ void lv_inv_area(const area_t * area_p)
     	com_area.y2 = com_area.y2 | 0x1;
 #endif
 
+    	/*Only collect the area while held*/
+    	if(inv_hold != false) {
+    	    if(inv_hold_valid != false) area_join(&inv_hold_area, &inv_hold_area, &com_area);
+    	    else area_cpy(&inv_hold_area, &com_area);
+    	    inv_hold_valid = true;
+    	    return;
+    	}
+
     	/*Save only if this area is not in one of the saved areas*/
     	uint16_t i;
     	for(i = 0; i < inv_buf_p; i++) {
@@ -116,6 +136,173 @@ void lv_inv_area(const area_t * area_p)
     }
 }
 
+/**
+ * Collect the invalidated areas into one area instead of saving them one by one.
+ * Useful when many objects are changed at once.
+ */
+void lv_inv_hold(void)
+{
+    inv_hold = true;
+}
+
+/**
+ * Stop collecting the invalidated areas and invalidate the collected area
+ */
+void lv_inv_release(void)
+{
+    if(inv_hold == false) return;
+
+    inv_hold = false;
+    if(inv_hold_valid != false) {
+        inv_hold_valid = false;
+        lv_inv_area(&inv_hold_area);
+    }
+}
+
+/**
+ * Get the time until the GUI has to be handled again ('ptask_handler' has to be called).
+ * Meanwhile the CPU can sleep (even the tick can be stopped) if the tick is corrected after it.
+ * Invalidating, creating an animation, posting a command or 'lv_dispi_wake' (e.g. from an interrupt)
+ * shorten the time.
+ * @return time in milliseconds or UINT32_MAX if the GUI waits for an event
+ */
+uint32_t lv_refr_get_sleep_time(void)
+{
+    uint32_t t = lv_dispi_get_sleep_time();
+
+    /*Nothing to refresh until the first animation delay ends*/
+    uint32_t refr_t = inv_buf_p != 0 || lv_cmd_is_pending() ? 0 : anim_get_sleep_time();
+    if(refr_t != UINT32_MAX) {
+        /*Keep the refresh period*/
+        uint32_t elaps = systick_elaps(refr_last_run);
+        if(elaps < LV_REFR_PERIOD) refr_t = MATH_MAX(refr_t, LV_REFR_PERIOD - elaps);
+    }
+
+    return MATH_MIN(t, refr_t);
+}
+
+/**
+ * Set a function which can move an area of the display (e.g. copy the frame buffer with DMA).
+ * With it the scrolled content is moved instead of redrawn.
+ * @param copy_f pointer to a copy function or NULL to always redraw the scrolled content
+ */
+void lv_refr_set_copy_f(lv_refr_copy_f_t copy_f)
+{
+    refr_copy_f = copy_f;
+}
+
+/**
+ * Move the drawn content of an area and invalidate only the newly exposed parts
+ * @param area_p pointer to the area whose content is moved. It remains at the same place.
+ * @param dx horizontal movement of the content
+ * @param dy vertical movement of the content
+ * @return true: the content is moved, false: the content can not be moved (invalidate the area instead)
+ */
+bool lv_inv_area_move(const area_t * area_p, cord_t dx, cord_t dy)
+{
+    if(refr_copy_f == NULL || inv_hold != false) return false;
+
+    area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = LV_HOR_RES - 1;
+    scr_area.y2 = LV_VER_RES - 1;
+
+    area_t area;
+    if(area_union(&area, area_p, &scr_area) == false) return true;  /*Not visible, nothing to do*/
+
+    /*Nothing remains visible on a big movement*/
+    if(MATH_ABS(dx) >= area_get_width(&area) || MATH_ABS(dy) >= area_get_height(&area)) return false;
+
+#if LV_DOWNSCALE == 2
+    /*Only whole display pixels can be moved*/
+    if((dx & 0x1) != 0 || (dy & 0x1) != 0 ||
+       (area.x1 & 0x1) != 0 || (area.y1 & 0x1) != 0 ||
+       (area.x2 & 0x1) == 0 || (area.y2 & 0x1) == 0) {
+        return false;
+    }
+#endif
+
+    /*The part of the area where the content will be still visible*/
+    area_t dest;
+    dest.x1 = MATH_MAX(area.x1, area.x1 + dx);
+    dest.y1 = MATH_MAX(area.y1, area.y1 + dy);
+    dest.x2 = MATH_MIN(area.x2, area.x2 + dx);
+    dest.y2 = MATH_MIN(area.y2, area.y2 + dy);
+
+    area_t src;
+    src.x1 = dest.x1 - dx;
+    src.y1 = dest.y1 - dy;
+    src.x2 = dest.x2 - dx;
+    src.y2 = dest.y2 - dy;
+
+#if LV_ANTIALIAS != 0 && LV_VDB_SIZE != 0
+    src.x1 = src.x1 >> 1;
+    src.y1 = src.y1 >> 1;
+    src.x2 = src.x2 >> 1;
+    src.y2 = src.y2 >> 1;
+    if(refr_copy_f(&src, dx >> 1, dy >> 1) == false) return false;
+#else
+    if(refr_copy_f(&src, dx, dy) == false) return false;
+#endif
+
+    /* The not yet refreshed areas are moved with the content too.
+     * (They remain invalid on the original place as well)*/
+    uint16_t inv_num = inv_buf_p;
+    uint16_t i;
+    area_t moved;
+    for(i = 0; i < inv_num; i++) {
+        moved.x1 = inv_buf[i].area.x1 + dx;
+        moved.y1 = inv_buf[i].area.y1 + dy;
+        moved.x2 = inv_buf[i].area.x2 + dx;
+        moved.y2 = inv_buf[i].area.y2 + dy;
+        if(area_union(&moved, &moved, &dest) != false) lv_inv_area(&moved);
+    }
+
+    /*Invalidate the newly exposed stripes*/
+    area_t stripe;
+    if(dy != 0) {
+        area_cpy(&stripe, &area);
+        if(dy > 0) stripe.y2 = dest.y1 - 1;
+        else stripe.y1 = dest.y2 + 1;
+        lv_inv_area(&stripe);
+    }
+
+    if(dx != 0) {
+        area_cpy(&stripe, &area);
+        if(dx > 0) stripe.x2 = dest.x1 - 1;
+        else stripe.x1 = dest.x2 + 1;
+        lv_inv_area(&stripe);
+    }
+
+    return true;
+}
+
+#if LV_VDB_SIZE != 0
+/**
+ * Draw an object and its children into a buffer instead of the screen
+ * @param obj pointer to an object
+ * @param buf pointer to a buffer with 'area_get_size(area_p)' pixels
+ * @param area_p the area of 'buf' on the screen. Only this part of 'obj' is drawn.
+ * @param design_f NULL: draw the object and its children normally,
+ *                 else draw only the object with this design function (in LV_DESIGN_DRAW_MAIN mode)
+ */
+void lv_refr_snapshot(lv_obj_t * obj, color_t * buf, const area_t * area_p, lv_design_f_t design_f)
+{
+    /*Redirect the drawing into 'buf'. Snapshots can be taken while drawing an other one too.*/
+    lv_vdb_t * vdb_p = lv_vdb_get();
+    lv_vdb_t vdb_save;
+    memcpy(&vdb_save, vdb_p, sizeof(lv_vdb_t));
+    vdb_p->buf = buf;
+    area_cpy(&vdb_p->vdb_area, area_p);
+
+    if(design_f == NULL) lv_refr_obj(obj, area_p);
+    else design_f(obj, area_p, LV_DESIGN_DRAW_MAIN);
+
+    memcpy(vdb_p, &vdb_save, sizeof(lv_vdb_t));
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -126,6 +313,18 @@ void lv_inv_area(const area_t * area_p)
  */
 static void lv_refr_task(void * param)
 {
+    refr_last_run = systick_get();
+
+    /*Apply the commands posted by the other threads first*/
+    lv_cmd_handler();
+
+    /*Sleep if nothing is invalid and no animation is running*/
+    if(inv_buf_p == 0 && anim_get_sleep_time() != 0) return;
+
+    /* Step the animations right before the redrawing
+     * so all of their changes are drawn in this frame together*/
+    anim_handler();
+
     lv_refr_join_area();
     
     lv_refr_areas();
@@ -297,14 +496,19 @@ static lv_obj_t * lv_refr_get_top_obj(const area_t * area_p, lv_obj_t * obj)
     lv_obj_t * found_p = NULL;
     
     /*If this object is fully cover the draw area check the children too */
-    if(area_is_in(area_p, &obj->cords) && obj->hidden == 0)
+    /*An object drawn from a layer is not on its place*/
+    lv_obj_refr_cords(obj);
+    if(area_is_in(area_p, &obj->cords) && obj->hidden == 0 && obj->layer == 0)
     {
-        LL_READ(obj->child_ll, i)        {
-            found_p = lv_refr_get_top_obj(area_p, i);
-            
-            /*If a children is ok then break*/
-            if(found_p != NULL) {
-                break;
+        /*A cached object is drawn with its children together*/
+        if(obj->cache == 0) {
+            LL_READ(obj->child_ll, i)        {
+                found_p = lv_refr_get_top_obj(area_p, i);
+
+                /*If a children is ok then break*/
+                if(found_p != NULL) {
+                    break;
+                }
             }
         }
         
@@ -378,6 +582,17 @@ static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p)
 {
     /*Do not refresh hidden objects*/
     if(obj->hidden != 0) return;
+
+    /*Draw the snapshot instead of the object if it has a layer*/
+    if(obj->layer != 0) {
+        lv_layer_draw(obj, mask_ori_p);
+        return;
+    }
+
+    /*Draw the cached snapshot if possible*/
+    if(obj->cache != 0) {
+        if(lv_layer_cache_draw(obj, mask_ori_p) != false) return;
+    }
     
     bool union_ok;  /* Store the return value of area_union */
     /* Truncate the original mask to the coordinates of the parent
@@ -411,12 +626,7 @@ static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p)
 			area_t child_area;
 			LL_READ_BACK(obj->child_ll, child_p)
 			{
-				lv_obj_get_cords(child_p, &child_area);
-				ext_size = child_p->ext_size;
-				child_area.x1 -= ext_size;
-				child_area.y1 -= ext_size;
-				child_area.x2 += ext_size;
-				child_area.y2 += ext_size;
+				lv_refr_get_ext_area(child_p, &child_area);
 				/* Get the union (common parts) of original mask (from obj)
 				 * and its child */
 				union_ok = area_union(&mask_child, &obj_mask, &child_area);
@@ -435,3 +645,23 @@ static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p)
 		}
     }
 }
+
+/**
+ * Get the area where an object is drawn (its coordinates with the ext. size or its layer)
+ * @param obj pointer to an object
+ * @param area_p store the area here
+ */
+static void lv_refr_get_ext_area(lv_obj_t * obj, area_t * area_p)
+{
+    if(obj->layer != 0) {
+        lv_layer_get_area(obj, area_p);
+        return;
+    }
+
+    cord_t ext_size = obj->ext_size;
+    lv_obj_get_cords(obj, area_p);
+    area_p->x1 -= ext_size;
+    area_p->y1 -= ext_size;
+    area_p->x2 += ext_size;
+    area_p->y2 += ext_size;
+}
@@ -16,6 +16,9 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/* Move the content of an area (the source) of the display with 'dx' and 'dy' (in display coordinates).
+ * Return false if the move is not possible*/
+typedef bool (*lv_refr_copy_f_t)(const area_t * area_p, cord_t dx, cord_t dy);
 
 /**********************
  *  STATIC PROTOTYPES
@@ -44,6 +47,54 @@ void lv_refr_init(void);
  */
 void lv_inv_area(const area_t * area_p);
 
+/**
+ * Collect the invalidated areas into one area instead of saving them one by one.
+ * Useful when many objects are changed at once.
+ */
+void lv_inv_hold(void);
+
+/**
+ * Stop collecting the invalidated areas and invalidate the collected area
+ */
+void lv_inv_release(void);
+
+/**
+ * Get the time until the GUI has to be handled again ('ptask_handler' has to be called).
+ * Meanwhile the CPU can sleep (even the tick can be stopped) if the tick is corrected after it.
+ * Invalidating, creating an animation, posting a command or 'lv_dispi_wake' (e.g. from an interrupt)
+ * shorten the time.
+ * @return time in milliseconds or UINT32_MAX if the GUI waits for an event
+ */
+uint32_t lv_refr_get_sleep_time(void);
+
+/**
+ * Set a function which can move an area of the display (e.g. copy the frame buffer with DMA).
+ * With it the scrolled content is moved instead of redrawn.
+ * @param copy_f pointer to a copy function or NULL to always redraw the scrolled content
+ */
+void lv_refr_set_copy_f(lv_refr_copy_f_t copy_f);
+
+/**
+ * Move the drawn content of an area and invalidate only the newly exposed parts
+ * @param area_p pointer to the area whose content is moved. It remains at the same place.
+ * @param dx horizontal movement of the content
+ * @param dy vertical movement of the content
+ * @return true: the content is moved, false: the content can not be moved (invalidate the area instead)
+ */
+bool lv_inv_area_move(const area_t * area_p, cord_t dx, cord_t dy);
+
+#if LV_VDB_SIZE != 0
+/**
+ * Draw an object and its children into a buffer instead of the screen
+ * @param obj pointer to an object
+ * @param buf pointer to a buffer with 'area_get_size(area_p)' pixels
+ * @param area_p the area of 'buf' on the screen. Only this part of 'obj' is drawn.
+ * @param design_f NULL: draw the object and its children normally,
+ *                 else draw only the object with this design function (in LV_DESIGN_DRAW_MAIN mode)
+ */
+void lv_refr_snapshot(lv_obj_t * obj, color_t * buf, const area_t * area_p, lv_design_f_t design_f);
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -0,0 +1,575 @@
+/**
+ * @file lv_scrd.c
+ * Screen descriptions: build object trees from a compact binary (or text) description
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_scrd.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../lv_objx/lv_rect.h"
+#include "../lv_objx/lv_label.h"
+#include "../lv_objx/lv_btn.h"
+#include "../lv_objx/lv_img.h"
+#include "../lv_objx/lv_line.h"
+#include "../lv_objx/lv_page.h"
+#include "../lv_objx/lv_list.h"
+#include "../lv_objx/lv_cb.h"
+#include "../lv_objx/lv_pb.h"
+#include "../lv_objx/lv_led.h"
+#include "../lv_objx/lv_chart.h"
+#include "../lv_objx/lv_ta.h"
+#include "../lv_objx/lv_btnm.h"
+#include "../lv_objx/lv_win.h"
+#include "../lv_objx/lv_mbox.h"
+#include "../lv_objx/lv_gauge.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Test configurations*/
+#ifndef LV_SCRD_MAX_DEPTH
+#define LV_SCRD_MAX_DEPTH   8       /*Max. depth of the object trees in the descriptions*/
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*Functions of an object type*/
+typedef struct
+{
+    lv_obj_t * (*create)(lv_obj_t * par, lv_obj_t * copy);  /*NULL if the type is disabled in lv_conf.h*/
+    void (*set_txt)(lv_obj_t * obj, const char * txt);      /*Apply the 'txt' of the description (NULL if unused)*/
+    uint8_t rect :1;                                        /*1: based on lv_rect (has layout and fit)*/
+}lv_scrd_type_dsc_t;
+
+/*State of the compiling*/
+typedef struct
+{
+    lv_scrd_obj_t * objs;               /*The compiled objects (NULL in the counting pass)*/
+    char * txts;                        /*The compiled texts (NULL in the counting pass)*/
+    uint32_t obj_num;                   /*Number of objects so far*/
+    uint32_t txt_size;                  /*Size of the texts so far*/
+    uint16_t ind[LV_SCRD_MAX_DEPTH];    /*Indentation of the last object on each depth*/
+    uint8_t depth;                      /*Depth of the last object*/
+}lv_scrd_comp_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool lv_scrd_check(const lv_scrd_head_t * head, uint32_t size, const lv_scrd_res_t * res);
+static void lv_scrd_apply(lv_obj_t * obj, const lv_scrd_obj_t * dsc, const char * txts, const lv_scrd_res_t * res);
+static bool lv_scrd_comp_pass(const char * txt, lv_scrd_comp_t * c);
+static const char * lv_scrd_comp_obj(const char * txt, uint16_t ind, lv_scrd_comp_t * c);
+static const char * lv_scrd_comp_txt(const char * txt, lv_scrd_comp_t * c, uint16_t * ofs);
+static const char * lv_scrd_comp_num(const char * txt, int32_t min, int32_t max, int32_t * num);
+static int16_t lv_scrd_find_word(const char * txt, uint16_t len, const char * const * words, uint16_t num);
+static uint16_t lv_scrd_word_len(const char * txt);
+#if USE_LV_LABEL != 0
+static void lv_scrd_label_set_text(lv_obj_t * label, const char * txt);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const lv_scrd_type_dsc_t scrd_types[LV_SCRD_TYPE_NUM] =
+{
+    [LV_SCRD_OBJ] = {lv_obj_create, NULL, 0},
+#if USE_LV_RECT != 0
+    [LV_SCRD_RECT] = {lv_rect_create, NULL, 1},
+#endif
+#if USE_LV_LABEL != 0
+    [LV_SCRD_LABEL] = {lv_label_create, lv_scrd_label_set_text, 0},
+#endif
+#if USE_LV_BTN != 0
+    [LV_SCRD_BTN] = {lv_btn_create, NULL, 1},
+#endif
+#if USE_LV_IMG != 0
+    [LV_SCRD_IMG] = {lv_img_create, lv_img_set_file, 0},
+#endif
+#if USE_LV_LINE != 0
+    [LV_SCRD_LINE] = {lv_line_create, NULL, 0},
+#endif
+#if USE_LV_PAGE != 0
+    [LV_SCRD_PAGE] = {lv_page_create, NULL, 1},
+#endif
+#if USE_LV_LIST != 0
+    [LV_SCRD_LIST] = {lv_list_create, NULL, 1},
+#endif
+#if USE_LV_CB != 0
+    [LV_SCRD_CB] = {lv_cb_create, lv_cb_set_text, 1},
+#endif
+#if USE_LV_PB != 0
+    [LV_SCRD_PB] = {lv_pb_create, NULL, 1},
+#endif
+#if USE_LV_LED != 0
+    [LV_SCRD_LED] = {lv_led_create, NULL, 1},
+#endif
+#if USE_LV_CHART != 0
+    [LV_SCRD_CHART] = {lv_chart_create, NULL, 1},
+#endif
+#if USE_LV_TA != 0
+    [LV_SCRD_TA] = {lv_ta_create, lv_ta_set_text, 1},
+#endif
+#if USE_LV_BTNM != 0
+    [LV_SCRD_BTNM] = {lv_btnm_create, NULL, 1},
+#endif
+#if USE_LV_WIN != 0
+    [LV_SCRD_WIN] = {lv_win_create, lv_win_set_title, 1},
+#endif
+#if USE_LV_MBOX != 0
+    [LV_SCRD_MBOX] = {lv_mbox_create, lv_mbox_set_text, 1},
+#endif
+#if USE_LV_GAUGE != 0
+    [LV_SCRD_GAUGE] = {lv_gauge_create, NULL, 1},
+#endif
+};
+
+/*Names of the types in the text descriptions (in the order of 'lv_scrd_type_t')*/
+static const char * const scrd_type_names[LV_SCRD_TYPE_NUM] =
+{
+    "obj", "rect", "label", "btn", "img", "line", "page", "list", "cb",
+    "pb", "led", "chart", "ta", "btnm", "win", "mbox", "gauge",
+};
+
+/*Names of the layouts in the text descriptions (in the order of 'lv_rect_layout_t')*/
+static const char * const scrd_layout_names[] =
+{
+    "off", "center", "col_l", "col_m", "col_r", "row_t", "row_m", "row_b", "pretty", "grid",
+};
+
+/*Names of the flags in the text descriptions (bit 'i' is 'scrd_flag_names[i]')*/
+static const char * const scrd_flag_names[] =
+{
+    "hidden", "click", "no_click", "drag", "hfit", "vfit",
+};
+
+static bool scrd_static_txt;    /*Use the texts of the labels from the description without copy*/
+
+/**********************
+ *      MACROS
+ **********************/
+#define LV_SCRD_ARRAY_LEN(a)    (sizeof(a) / sizeof((a)[0]))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Build the objects of a binary description in one transaction (see 'lv_obj_trans_begin')
+ * so the layouts are refreshed only once at the end. The description is used in place (it can be in ROM).
+ * @param par pointer to the parent of the objects with depth 0 (NULL: they are new screens)
+ * @param scrd pointer to a binary description (see 'lv_scrd_compile'). Has to be aligned to 4 bytes.
+ * @param size size of the binary description [bytes]. Nothing is read beyond it even if the description is corrupt.
+ * @param res pointer to the styles and the object table of the loading (NULL if unused)
+ * @return pointer to the first object with depth 0 or NULL if the description is invalid
+ */
+lv_obj_t * lv_scrd_load(lv_obj_t * par, const void * scrd, uint32_t size, const lv_scrd_res_t * res)
+{
+    const lv_scrd_head_t * head = scrd;
+
+    /*Check everything before creating the first object to not leave a half tree*/
+    if(lv_scrd_check(head, size, res) == false) return NULL;
+
+    const lv_scrd_obj_t * dsc = (const lv_scrd_obj_t *)(head + 1);
+    const char * txts = (const char *)(dsc + head->obj_num);
+    lv_obj_t * pars[LV_SCRD_MAX_DEPTH];     /*pars[d]: parent of the objects with depth 'd'*/
+    lv_obj_t * first = NULL;
+    uint16_t i;
+
+    pars[0] = par;
+    scrd_static_txt = res != NULL && res->static_txt != 0 ? true : false;
+
+    lv_obj_trans_begin();
+
+    for(i = 0; i < head->obj_num; i++, dsc++) {
+        lv_obj_t * obj = scrd_types[dsc->type].create(pars[dsc->depth], NULL);
+        dm_assert(obj);
+
+        if(dsc->depth + 1 < LV_SCRD_MAX_DEPTH) pars[dsc->depth + 1] = obj;
+        if(first == NULL) first = obj;
+
+        lv_scrd_apply(obj, dsc, txts, res);
+    }
+
+    lv_obj_trans_commit();
+
+    return first;
+}
+
+/**
+ * Compile a text description to binary description.
+ * A line describes an object: the type then the properties, e.g.
+ *     btn x=10 y=20 w=100 h=40 style=1 id=0 layout=center
+ *       label txt="Ok"
+ * The indentation of the lines gives the parent-child relations.
+ * Types: obj, rect, label, btn, img, line, page, list, cb, pb, led, chart, ta, btnm, win, mbox, gauge
+ * Properties: x, y, w, h, style, id, opa, txt, layout (off, center, col_l, col_m, col_r, row_t, row_m,
+ *             row_b, pretty, grid) and the flags: hidden, click, no_click, drag, hfit, vfit
+ * Texts can contain \n, \" and \\. The rest of a line after '#' is a comment.
+ * @param txt the text description ('\0' terminated)
+ * @param buf buffer for the binary description (aligned to 4 bytes) or NULL to get the required buffer size
+ * @param buf_size size of 'buf' [bytes]
+ * @return size of the binary description (same texts are stored once so it can be less than
+ *         the required buffer size) [bytes] or 0 on error (invalid text or too small buffer)
+ */
+uint32_t lv_scrd_compile(const char * txt, void * buf, uint32_t buf_size)
+{
+    lv_scrd_comp_t c;
+
+    /*Check the syntax and count the objects and the texts*/
+    memset(&c, 0, sizeof(c));
+    if(lv_scrd_comp_pass(txt, &c) == false) return 0;
+
+    /*The offset of the texts has to be less than LV_SCRD_TXT_NONE*/
+    if(c.obj_num > UINT16_MAX || c.txt_size > UINT16_MAX) return 0;
+
+    uint32_t size = sizeof(lv_scrd_head_t) + c.obj_num * sizeof(lv_scrd_obj_t) + c.txt_size;
+    if(buf == NULL) return size;
+    if(size > buf_size) return 0;
+
+    /*Write the objects and the texts*/
+    lv_scrd_head_t * head = buf;
+    uint32_t obj_num = c.obj_num;
+    memset(&c, 0, sizeof(c));
+    c.objs = (lv_scrd_obj_t *)(head + 1);
+    c.txts = (char *)(c.objs + obj_num);
+    lv_scrd_comp_pass(txt, &c);
+
+    head->magic = LV_SCRD_MAGIC;
+    head->obj_num = c.obj_num;
+    head->txt_size = c.txt_size;
+
+    return sizeof(lv_scrd_head_t) + c.obj_num * sizeof(lv_scrd_obj_t) + c.txt_size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Check a binary description and the resources of its loading
+ * @param head pointer to a binary description
+ * @param size size of the binary description [bytes]
+ * @param res pointer to the resources of the loading or NULL
+ * @return true: the description can be loaded
+ */
+static bool lv_scrd_check(const lv_scrd_head_t * head, uint32_t size, const lv_scrd_res_t * res)
+{
+    if(head == NULL || size < sizeof(lv_scrd_head_t) || head->magic != LV_SCRD_MAGIC) return false;
+
+    /*The objects and the texts have to be in the description*/
+    if(size < sizeof(lv_scrd_head_t) + (uint32_t)head->obj_num * sizeof(lv_scrd_obj_t) + head->txt_size) return false;
+
+    const lv_scrd_obj_t * dsc = (const lv_scrd_obj_t *)(head + 1);
+    const char * txts = (const char *)(dsc + head->obj_num);
+    uint8_t style_num = res != NULL && res->styles != NULL ? res->style_num : 0;
+    uint8_t obj_num = res != NULL && res->objs != NULL ? res->obj_num : 0;
+    uint8_t depth = 0;
+    uint16_t i;
+
+    /*The last text has to be closed*/
+    if(head->txt_size != 0 && txts[head->txt_size - 1] != '\0') return false;
+
+    for(i = 0; i < head->obj_num; i++, dsc++) {
+        if(dsc->type >= LV_SCRD_TYPE_NUM || scrd_types[dsc->type].create == NULL) return false;
+
+        /*An object can be only the child of the previous one or on a lower depth*/
+        if(i == 0 && dsc->depth != 0) return false;
+        if(dsc->depth > depth + 1 || dsc->depth >= LV_SCRD_MAX_DEPTH) return false;
+        depth = dsc->depth;
+
+        if(dsc->style != LV_SCRD_NONE && dsc->style >= style_num) return false;
+        if(dsc->id != LV_SCRD_NONE && dsc->id >= obj_num) return false;
+        if(dsc->txt != LV_SCRD_TXT_NONE && dsc->txt >= head->txt_size) return false;
+
+        /*Unknown layouts and flags*/
+        if(dsc->layout > LV_SCRD_ARRAY_LEN(scrd_layout_names)) return false;
+        if(dsc->flags >= (1 << LV_SCRD_ARRAY_LEN(scrd_flag_names))) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Apply the properties of a description on a new object
+ * @param obj pointer to the new object
+ * @param dsc pointer to the description of the object
+ * @param txts pointer to the texts of the description
+ * @param res pointer to the resources of the loading or NULL
+ */
+static void lv_scrd_apply(lv_obj_t * obj, const lv_scrd_obj_t * dsc, const char * txts, const lv_scrd_res_t * res)
+{
+    const lv_scrd_type_dsc_t * type = &scrd_types[dsc->type];
+
+    /*The style can change the size (e.g. of labels) so set it first*/
+    if(dsc->style != LV_SCRD_NONE) lv_obj_set_style(obj, res->styles[dsc->style]);
+    if(dsc->txt != LV_SCRD_TXT_NONE && type->set_txt != NULL) type->set_txt(obj, &txts[dsc->txt]);
+
+    if(dsc->w != 0 || dsc->h != 0) {
+        cord_t w = dsc->w != 0 ? dsc->w : lv_obj_get_width(obj);
+        cord_t h = dsc->h != 0 ? dsc->h : lv_obj_get_height(obj);
+        lv_obj_set_size(obj, w, h);
+    }
+    if(dsc->x != 0 || dsc->y != 0) lv_obj_set_pos(obj, dsc->x, dsc->y);
+
+#if USE_LV_RECT != 0
+    if(type->rect != 0) {
+        if(dsc->layout != 0) lv_rect_set_layout(obj, dsc->layout - 1);
+        if(dsc->flags & (LV_SCRD_HFIT | LV_SCRD_VFIT)) {
+            lv_rect_set_fit(obj, (dsc->flags & LV_SCRD_HFIT) != 0 || lv_rect_get_hfit(obj),
+                                 (dsc->flags & LV_SCRD_VFIT) != 0 || lv_rect_get_vfit(obj));
+        }
+    }
+#endif
+
+    if(dsc->opa != 0) lv_obj_set_opa(obj, dsc->opa);
+    if(dsc->flags & LV_SCRD_CLICK) lv_obj_set_click(obj, true);
+    if(dsc->flags & LV_SCRD_NO_CLICK) lv_obj_set_click(obj, false);
+    if(dsc->flags & LV_SCRD_DRAG) lv_obj_set_drag(obj, true);
+    if(dsc->flags & LV_SCRD_HIDDEN) lv_obj_set_hidden(obj, true);
+
+    if(dsc->id != LV_SCRD_NONE) res->objs[dsc->id] = obj;
+}
+
+/**
+ * Compile the lines of a text description
+ * @param txt the text description
+ * @param c pointer to the state of the compiling (with 'objs' and 'txts' NULL to only count them)
+ * @return true: no error
+ */
+static bool lv_scrd_comp_pass(const char * txt, lv_scrd_comp_t * c)
+{
+    while(*txt != '\0') {
+        uint16_t ind = 0;
+        while(*txt == ' ' || *txt == '\t') {
+            ind++;
+            txt++;
+        }
+
+        /*Compile the not empty lines*/
+        if(*txt != '\0' && *txt != '\n' && *txt != '\r' && *txt != '#') {
+            txt = lv_scrd_comp_obj(txt, ind, c);
+            if(txt == NULL) return false;
+        }
+
+        /*Skip the comment and go to the next line*/
+        while(*txt != '\0' && *txt != '\n') txt++;
+        if(*txt == '\n') txt++;
+    }
+
+    return true;
+}
+
+/**
+ * Compile a line of a text description
+ * @param txt pointer to the type of the object on the line
+ * @param ind indentation of the line
+ * @param c pointer to the state of the compiling
+ * @return pointer to the end of the line (or to the comment) or NULL on error
+ */
+static const char * lv_scrd_comp_obj(const char * txt, uint16_t ind, lv_scrd_comp_t * c)
+{
+    lv_scrd_obj_t obj;
+    memset(&obj, 0, sizeof(obj));
+    obj.style = LV_SCRD_NONE;
+    obj.id = LV_SCRD_NONE;
+    obj.txt = LV_SCRD_TXT_NONE;
+
+    /*Get the depth from the indentation*/
+    if(c->obj_num == 0) {
+        obj.depth = 0;
+    } else if(ind > c->ind[c->depth]) {
+        obj.depth = c->depth + 1;
+        if(obj.depth >= LV_SCRD_MAX_DEPTH) return NULL;
+    } else {
+        obj.depth = c->depth;
+        while(obj.depth > 0 && c->ind[obj.depth] > ind) obj.depth--;
+        if(c->ind[obj.depth] != ind) return NULL;      /*Not aligned to any parent*/
+    }
+    c->ind[obj.depth] = ind;
+    c->depth = obj.depth;
+
+    uint16_t len = lv_scrd_word_len(txt);
+    int16_t type = lv_scrd_find_word(txt, len, scrd_type_names, LV_SCRD_TYPE_NUM);
+    if(type < 0) return NULL;
+    obj.type = type;
+    txt += len;
+
+    /*Process the properties*/
+    while(1) {
+        while(*txt == ' ' || *txt == '\t') txt++;
+        if(*txt == '\0' || *txt == '\n' || *txt == '\r' || *txt == '#') break;
+
+        len = lv_scrd_word_len(txt);
+        if(len == 0) return NULL;
+
+        int16_t flag = lv_scrd_find_word(txt, len, scrd_flag_names, LV_SCRD_ARRAY_LEN(scrd_flag_names));
+        if(flag >= 0) {
+            obj.flags |= 1 << flag;
+            txt += len;
+            continue;
+        }
+
+        const char * key = txt;
+        txt += len;
+        if(*txt != '=') return NULL;
+        txt++;
+
+        int32_t num;
+        if(len == 1 && (key[0] == 'x' || key[0] == 'y' || key[0] == 'w' || key[0] == 'h')) {
+            txt = lv_scrd_comp_num(txt, INT16_MIN, INT16_MAX, &num);
+            if(key[0] == 'x') obj.x = num;
+            else if(key[0] == 'y') obj.y = num;
+            else if(key[0] == 'w') obj.w = num;
+            else obj.h = num;
+        } else if(len == 5 && strncmp(key, "style", len) == 0) {
+            txt = lv_scrd_comp_num(txt, 0, LV_SCRD_NONE - 1, &num);
+            obj.style = num;
+        } else if(len == 2 && strncmp(key, "id", len) == 0) {
+            txt = lv_scrd_comp_num(txt, 0, LV_SCRD_NONE - 1, &num);
+            obj.id = num;
+        } else if(len == 3 && strncmp(key, "opa", len) == 0) {
+            txt = lv_scrd_comp_num(txt, 0, OPA_COVER, &num);
+            obj.opa = num;
+        } else if(len == 6 && strncmp(key, "layout", len) == 0) {
+            len = lv_scrd_word_len(txt);
+            int16_t layout = lv_scrd_find_word(txt, len, scrd_layout_names, LV_SCRD_ARRAY_LEN(scrd_layout_names));
+            if(layout < 0) return NULL;
+            obj.layout = layout + 1;
+            txt += len;
+        } else if(len == 3 && strncmp(key, "txt", len) == 0) {
+            txt = lv_scrd_comp_txt(txt, c, &obj.txt);
+        } else {
+            return NULL;
+        }
+
+        if(txt == NULL) return NULL;
+    }
+
+    if(c->objs != NULL) memcpy(&c->objs[c->obj_num], &obj, sizeof(lv_scrd_obj_t));
+    c->obj_num++;
+
+    return txt;
+}
+
+/**
+ * Compile a quoted text of a text description. Store the same texts only once.
+ * @param txt pointer to the opening '"'
+ * @param c pointer to the state of the compiling
+ * @param ofs store the offset of the text here
+ * @return pointer after the closing '"' or NULL on error
+ */
+static const char * lv_scrd_comp_txt(const char * txt, lv_scrd_comp_t * c, uint16_t * ofs)
+{
+    if(*txt != '"') return NULL;
+    txt++;
+
+    /*In the counting pass only reserve place for the text with the escape characters*/
+    char * dst = c->txts != NULL ? &c->txts[c->txt_size] : NULL;
+    uint32_t len = 0;
+    while(*txt != '"') {
+        char letter = *txt;
+        if(letter == '\0' || letter == '\n') return NULL;
+        if(letter == '\\') {
+            txt++;
+            if(*txt == 'n') letter = '\n';
+            else if(*txt == '"' || *txt == '\\') letter = *txt;
+            else return NULL;
+            if(dst == NULL) len++;
+        }
+        if(dst != NULL) dst[len] = letter;
+        len++;
+        txt++;
+    }
+
+    *ofs = c->txt_size;
+    if(dst == NULL) {
+        c->txt_size += len + 1;
+        return txt + 1;
+    }
+
+    dst[len] = '\0';
+
+    /*Use a same earlier text if any*/
+    uint32_t i = 0;
+    while(i < c->txt_size) {
+        if(strcmp(&c->txts[i], dst) == 0) {
+            *ofs = i;
+            return txt + 1;
+        }
+        i += strlen(&c->txts[i]) + 1;
+    }
+
+    c->txt_size += len + 1;
+
+    return txt + 1;
+}
+
+/**
+ * Read a number of a text description
+ * @param txt pointer to the number
+ * @param min the min. valid value
+ * @param max the max. valid value
+ * @param num store the number here
+ * @return pointer after the number or NULL on error
+ */
+static const char * lv_scrd_comp_num(const char * txt, int32_t min, int32_t max, int32_t * num)
+{
+    char * end;
+    *num = strtol(txt, &end, 0);
+    if(end == txt || *num < min || *num > max) return NULL;
+
+    return end;
+}
+
+/**
+ * Find a word in a list of words
+ * @param txt pointer to the word (not '\0' terminated)
+ * @param len length of the word
+ * @param words list of words
+ * @param num number of words in 'words'
+ * @return index of the word in 'words' or -1 if not found
+ */
+static int16_t lv_scrd_find_word(const char * txt, uint16_t len, const char * const * words, uint16_t num)
+{
+    uint16_t i;
+    for(i = 0; i < num; i++) {
+        if(strncmp(txt, words[i], len) == 0 && words[i][len] == '\0') return i;
+    }
+
+    return -1;
+}
+
+/**
+ * Get the length of a word of a text description (consists of letters, digits and '_')
+ * @param txt pointer to the word
+ * @return number of the characters of the word
+ */
+static uint16_t lv_scrd_word_len(const char * txt)
+{
+    uint16_t len = 0;
+    while((txt[len] >= 'a' && txt[len] <= 'z') || (txt[len] >= 'A' && txt[len] <= 'Z') ||
+          (txt[len] >= '0' && txt[len] <= '9') || txt[len] == '_') {
+        len++;
+    }
+
+    return len;
+}
+
+#if USE_LV_LABEL != 0
+/**
+ * Set the text of a label from a description
+ * @param label pointer to a label object
+ * @param txt pointer to a text in the description
+ */
+static void lv_scrd_label_set_text(lv_obj_t * label, const char * txt)
+{
+    if(scrd_static_txt != false) lv_label_set_text_static(label, txt);
+    else lv_label_set_text(label, txt);
+}
+#endif
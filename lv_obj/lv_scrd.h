@@ -0,0 +1,135 @@
+/**
+ * @file lv_scrd.h
+ * Screen descriptions: build object trees from a compact binary (or text) description
+ */
+
+#ifndef LV_SCRD_H
+#define LV_SCRD_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_SCRD_MAGIC       0x4453564C  /*"LVSD" at the beginning of the binary descriptions*/
+#define LV_SCRD_NONE        0xFF        /*No style or id in 'lv_scrd_obj_t'*/
+#define LV_SCRD_TXT_NONE    0xFFFF      /*No text in 'lv_scrd_obj_t'*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*Object types in the descriptions. Don't change the order (it is stored in the binary descriptions).*/
+typedef enum
+{
+    LV_SCRD_OBJ = 0,
+    LV_SCRD_RECT,
+    LV_SCRD_LABEL,
+    LV_SCRD_BTN,
+    LV_SCRD_IMG,
+    LV_SCRD_LINE,
+    LV_SCRD_PAGE,
+    LV_SCRD_LIST,
+    LV_SCRD_CB,
+    LV_SCRD_PB,
+    LV_SCRD_LED,
+    LV_SCRD_CHART,
+    LV_SCRD_TA,
+    LV_SCRD_BTNM,
+    LV_SCRD_WIN,
+    LV_SCRD_MBOX,
+    LV_SCRD_GAUGE,
+    LV_SCRD_TYPE_NUM,
+}lv_scrd_type_t;
+
+/*Flags of the objects in the descriptions*/
+typedef enum
+{
+    LV_SCRD_HIDDEN   = 0x01,    /*lv_obj_set_hidden(obj, true)*/
+    LV_SCRD_CLICK    = 0x02,    /*lv_obj_set_click(obj, true)*/
+    LV_SCRD_NO_CLICK = 0x04,    /*lv_obj_set_click(obj, false)*/
+    LV_SCRD_DRAG     = 0x08,    /*lv_obj_set_drag(obj, true)*/
+    LV_SCRD_HFIT     = 0x10,    /*Horizontal fit of lv_rect based objects*/
+    LV_SCRD_VFIT     = 0x20,    /*Vertical fit of lv_rect based objects*/
+}lv_scrd_flag_t;
+
+/*Header of a binary description. It is followed by 'obj_num' 'lv_scrd_obj_t' and 'txt_size' bytes of texts.*/
+typedef struct
+{
+    uint32_t magic;     /*LV_SCRD_MAGIC*/
+    uint16_t obj_num;   /*Number of objects*/
+    uint16_t txt_size;  /*Size of the '\0' terminated texts after the objects [bytes]*/
+}lv_scrd_head_t;
+
+/*An object in a binary description. The objects are stored in pre-order (parents before their children).*/
+typedef struct
+{
+    uint8_t type;       /*From 'lv_scrd_type_t'*/
+    uint8_t depth;      /*0: child of the parent of the loading, 1: child of the last object with depth 0, ...*/
+    uint8_t style;      /*Index in the style table of the loading or LV_SCRD_NONE to keep the default style*/
+    uint8_t id;         /*Save the object to this index of the object table of the loading (LV_SCRD_NONE: don't save)*/
+    uint8_t flags;      /*OR-ed 'lv_scrd_flag_t' values*/
+    uint8_t layout;     /*'lv_rect_layout_t' + 1 for lv_rect based objects (0: keep the default layout)*/
+    uint8_t opa;        /*Opacity of the object (0: keep the default opacity)*/
+    uint8_t reserved;
+    int16_t x;          /*Position on the parent*/
+    int16_t y;
+    int16_t w;          /*Size of the object (0: keep the default size)*/
+    int16_t h;
+    uint16_t txt;       /*Offset of the text in the texts or LV_SCRD_TXT_NONE.
+                          Used as the text of labels, check boxes, text areas and message boxes,
+                          the title of windows and the file of images.*/
+}lv_scrd_obj_t;
+
+/*Resources of the loading which can't be stored in the descriptions*/
+typedef struct
+{
+    void * const * styles;  /*Styles to refer with the 'style' of the objects (can be NULL)*/
+    uint8_t style_num;      /*Number of elements in 'styles'*/
+    lv_obj_t ** objs;       /*The objects with an 'id' are saved here (e.g. to set their actions) (can be NULL)*/
+    uint8_t obj_num;        /*Number of elements in 'objs'*/
+    uint8_t static_txt :1;  /*1: the labels use their texts from the description without copy.
+                              The description has to be valid while the labels exist (e.g. in ROM).*/
+}lv_scrd_res_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Build the objects of a binary description in one transaction (see 'lv_obj_trans_begin')
+ * so the layouts are refreshed only once at the end. The description is used in place (it can be in ROM).
+ * @param par pointer to the parent of the objects with depth 0 (NULL: they are new screens)
+ * @param scrd pointer to a binary description (see 'lv_scrd_compile'). Has to be aligned to 4 bytes.
+ * @param size size of the binary description [bytes]. Nothing is read beyond it even if the description is corrupt.
+ * @param res pointer to the styles and the object table of the loading (NULL if unused)
+ * @return pointer to the first object with depth 0 or NULL if the description is invalid
+ */
+lv_obj_t * lv_scrd_load(lv_obj_t * par, const void * scrd, uint32_t size, const lv_scrd_res_t * res);
+
+/**
+ * Compile a text description to binary description.
+ * A line describes an object: the type then the properties, e.g.
+ *     btn x=10 y=20 w=100 h=40 style=1 id=0 layout=center
+ *       label txt="Ok"
+ * The indentation of the lines gives the parent-child relations.
+ * Types: obj, rect, label, btn, img, line, page, list, cb, pb, led, chart, ta, btnm, win, mbox, gauge
+ * Properties: x, y, w, h, style, id, opa, txt, layout (off, center, col_l, col_m, col_r, row_t, row_m,
+ *             row_b, pretty, grid) and the flags: hidden, click, no_click, drag, hfit, vfit
+ * Texts can contain \n, \" and \\. The rest of a line after '#' is a comment.
+ * @param txt the text description ('\0' terminated)
+ * @param buf buffer for the binary description (aligned to 4 bytes) or NULL to get the required buffer size
+ * @param buf_size size of 'buf' [bytes]
+ * @return size of the binary description (same texts are stored once so it can be less than
+ *         the required buffer size) [bytes] or 0 on error (invalid text or too small buffer)
+ */
+uint32_t lv_scrd_compile(const char * txt, void * buf, uint32_t buf_size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif
@@ -28,7 +28,8 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
-static lv_vdb_t vdb;
+static color_t vdb_buf[LV_VDB_SIZE];
+static lv_vdb_t vdb = {{0, 0, 0, 0}, vdb_buf};
 
 /**********************
  *      MACROS
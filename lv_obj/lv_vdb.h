@@ -28,7 +28,7 @@
 typedef struct
 {
     area_t vdb_area;
-    color_t buf[LV_VDB_SIZE];
+    color_t * buf;      /*The drawing buffer. Normally it has LV_VDB_SIZE pixels (see 'lv_refr_snapshot')*/
 }lv_vdb_t;
 
 
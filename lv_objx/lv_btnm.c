@@ -30,6 +30,7 @@
 static bool lv_btnm_design(lv_obj_t * btnm, const area_t * mask, lv_design_mode_t mode);
 static uint8_t lv_btnm_get_width_unit(const char * btn_str);
 static uint16_t lv_btnm_get_btn_from_point(lv_obj_t * btnm, point_t * p);
+static void lv_btnm_inv_btn(lv_obj_t * btnm, uint16_t btn_i);
 static void lv_btnm_create_btns(lv_obj_t * btnm, const char ** map);
 static void lv_btnms_init(void);
 
@@ -71,8 +72,10 @@ lv_obj_t * lv_btnm_create(lv_obj_t * par, lv_obj_t * copy)
     lv_btnm_ext_t * ext = lv_obj_alloc_ext(new_btnm, sizeof(lv_btnm_ext_t));
     dm_assert(ext);
     ext->btn_cnt = 0;
+    ext->row_cnt = 0;
     ext->btn_pr = LV_BTNM_BTN_PR_INVALID;
-    ext->btn_areas = NULL;
+    ext->btns = NULL;
+    ext->row_first = NULL;
     ext->cb = NULL;
     ext->map_p = NULL;
 
@@ -115,12 +118,11 @@ bool lv_btnm_signal(lv_obj_t * btnm, lv_signal_t sign, void * param)
     if(valid != false) {
     	lv_btnm_ext_t * ext = lv_obj_get_ext(btnm);
     	uint16_t new_btn;
-    	area_t btnm_area;
-        area_t btn_area;
     	point_t p;
     	switch(sign) {
     		case LV_SIGNAL_CLEANUP:
-    			dm_free(ext->btn_areas);
+    			dm_free(ext->btns);
+    			dm_free(ext->row_first);
     			break;
     		case LV_SIGNAL_STYLE_CHG:
     		case LV_SIGNAL_CORD_CHG:
@@ -131,54 +133,27 @@ bool lv_btnm_signal(lv_obj_t * btnm, lv_signal_t sign, void * param)
     		    lv_dispi_get_point(param, &p);
     		    new_btn = lv_btnm_get_btn_from_point(btnm, &p);
     			/*Invalidate to old and the new areas*/;
-                lv_obj_get_cords(btnm, &btnm_area);
     		    if(new_btn != ext->btn_pr) {
     		        lv_dispi_reset_lpr(param);
-    			    if(ext->btn_pr != LV_BTNM_BTN_PR_INVALID) {
-    			        area_cpy(&btn_area, &ext->btn_areas[ext->btn_pr]);
-    			        btn_area.x1 += btnm_area.x1;
-                        btn_area.y1 += btnm_area.y1;
-                        btn_area.x2 += btnm_area.x1;
-                        btn_area.y2 += btnm_area.y1;
-    			        lv_inv_area(&btn_area);
-    			    }
-                    if(new_btn != LV_BTNM_BTN_PR_INVALID) {
-                        area_cpy(&btn_area, &ext->btn_areas[new_btn]);
-                        btn_area.x1 += btnm_area.x1;
-                        btn_area.y1 += btnm_area.y1;
-                        btn_area.x2 += btnm_area.x1;
-                        btn_area.y2 += btnm_area.y1;
-                        lv_inv_area(&btn_area);
-                    }
+    		        lv_btnm_inv_btn(btnm, ext->btn_pr);
+    		        lv_btnm_inv_btn(btnm, new_btn);
     			}
 
     		    ext->btn_pr = new_btn;
     			break;
+    		case LV_SIGNAL_PRESS_LOST:
+    		    lv_btnm_inv_btn(btnm, ext->btn_pr);
+    		    ext->btn_pr = LV_BTNM_BTN_PR_INVALID;
+    		    break;
     		case LV_SIGNAL_RELEASED:
             case LV_SIGNAL_LONG_PRESS_REP:
     			if(ext->cb != NULL &&
     			   ext->btn_pr != LV_BTNM_BTN_PR_INVALID) {
-    				uint16_t txt_i = 0;
-    				uint16_t btn_i = 0;
-    				/*Search the next valid text in the map*/
-    				while(btn_i != ext->btn_pr) {
-    					btn_i ++;
-    					txt_i ++;
-    					if(strcmp(ext->map_p[txt_i], "\n") == 0) txt_i ++;
-    				}
-
-    				ext->cb(btnm, txt_i);
+    				ext->cb(btnm, ext->btns[ext->btn_pr].txt_i);
     			}
     			if(sign == LV_SIGNAL_RELEASED && ext->btn_pr != LV_BTNM_BTN_PR_INVALID) {
     			    /*Invalidate to old area*/;
-                    lv_obj_get_cords(btnm, &btnm_area);
-                    area_cpy(&btn_area, &ext->btn_areas[ext->btn_pr]);
-                    btn_area.x1 += btnm_area.x1;
-                    btn_area.y1 += btnm_area.y1;
-                    btn_area.x2 += btnm_area.x1;
-                    btn_area.y2 += btnm_area.y1;
-                    lv_inv_area(&btn_area);
-
+    			    lv_btnm_inv_btn(btnm, ext->btn_pr);
                     ext->btn_pr = LV_BTNM_BTN_PR_INVALID;
     			}
 				break;
@@ -236,8 +211,10 @@ void lv_btnm_set_map(lv_obj_t * btnm, const char ** map)
 	uint16_t btn_cnt;		/*Number of buttons in a row*/
 	uint16_t i_tot = 0;		/*Act. index in the str map*/
 	uint16_t btn_i = 0;		/*Act. index of button areas*/
+	uint16_t row_i = 0;		/*Act. index of the rows with buttons*/
 	const char  ** map_p_tmp = map;
 	lv_btnm_ext_t * ext = lv_obj_get_ext(btnm);
+	const font_t * font = font_get(btnms->labels.font);
 
 	/*Count the units and the buttons in a line*/
 	while(1) {
@@ -252,6 +229,9 @@ void lv_btnm_set_map(lv_obj_t * btnm, const char ** map)
 
 		/*Only deal with the non empty lines*/
 		if(btn_cnt != 0) {
+			ext->row_first[row_i] = btn_i;
+			row_i ++;
+
 			/*Calculate the width of all units*/
 			cord_t all_unit_w = max_w - ((btn_cnt-1) * btnms->rects.opad);
 
@@ -269,10 +249,16 @@ void lv_btnm_set_map(lv_obj_t * btnm, const char ** map)
 				/*Always recalculate act_x because of rounding errors */
 				act_x = (unit_act_cnt * all_unit_w) / unit_cnt + i * btnms->rects.opad + btnms->rects.hpad;
 
-				area_set(&ext->btn_areas[btn_i], act_x,
-						                         act_y,
-						                         act_x + act_unit_w,
-				                                 act_y + btn_h);
+				lv_btnm_btn_t * btn = &ext->btns[btn_i];
+				area_set(&btn->area, act_x,
+						             act_y,
+						             act_x + act_unit_w,
+				                     act_y + btn_h);
+
+				/*Measure the label only here to not do it on every redraw*/
+				btn->txt_i = i_tot;
+				txt_get_size(&btn->txt_size, map_p_tmp[i], font,
+				             btnms->labels.letter_space, btnms->labels.line_space, lv_obj_get_width(btnm));
 
 				unit_act_cnt += lv_btnm_get_width_unit(map_p_tmp[i]);
 
@@ -390,53 +376,57 @@ static bool lv_btnm_design(lv_obj_t * btnm, const area_t * mask, lv_design_mode_
     	cord_t btn_w;
     	cord_t btn_h;
 
-    	uint16_t btn_i = 0;
-    	uint16_t txt_i = 0;
-    	for(btn_i = 0; btn_i < ext->btn_cnt; btn_i ++) {
-			lv_obj_get_cords(btnm, &area_btnm);
-
-			area_cpy(&area_tmp, &ext->btn_areas[btn_i]);
-			area_tmp.x1 += area_btnm.x1;
-			area_tmp.y1 += area_btnm.y1;
-			area_tmp.x2 += area_btnm.x1;
-			area_tmp.y2 += area_btnm.y1;
-
-			btn_w = area_get_width(&area_tmp);
-			btn_h = area_get_height(&area_tmp);
-
-			/*Load the style*/
-			lv_rects_t new_rects;
-			lv_btn_state_t state;
-			state = ext->btn_pr == btn_i ? LV_BTN_STATE_PR : LV_BTN_STATE_REL;
-			memcpy(&new_rects, &style->btns, sizeof(lv_rects_t));
-			new_rects.objs.color = style->btns.mcolor[state];
-			new_rects.gcolor = style->btns.gcolor[state];
-			new_rects.bcolor = style->btns.bcolor[state];
-			new_rects.lcolor = style->btns.lcolor[state];
-			new_rects.empty = style->btns.flags[state].empty;
-			new_rects.objs.transp = style->btns.flags[state].transp;
-
-			if(style->btns.flags[state].light_en != 0) new_rects.light = style->rects.light;
-			else new_rects.light = 0;
-
-			lv_draw_rect(&area_tmp, mask, &new_rects, OPA_COVER);
-
-			/*Search the next valid text in the map*/
-			while(strcmp(ext->map_p[txt_i], "\n") == 0) txt_i ++;
-
-			/*Calculate the size of the text*/
-			const font_t * font = font_get(style->labels.font);
-			point_t txt_size;
-			txt_get_size(&txt_size, ext->map_p[txt_i], font,
-					     style->labels.letter_space, style->labels.line_space, area_get_width(&area_btnm));
-
-			area_tmp.x1 += (btn_w - txt_size.x) / 2;
-			area_tmp.y1 += (btn_h - txt_size.y) / 2;
-			area_tmp.x2 = area_tmp.x1 + txt_size.x;
-			area_tmp.y2 = area_tmp.y1 + txt_size.y;
-
-			lv_draw_label(&area_tmp, mask, &style->labels, OPA_COVER, ext->map_p[txt_i]);
-			txt_i ++;
+    	lv_obj_get_cords(btnm, &area_btnm);
+
+    	/*Load the style of the released and pressed buttons*/
+    	lv_rects_t state_rects[LV_BTN_STATE_REL + 1];
+    	lv_btn_state_t state;
+    	for(state = LV_BTN_STATE_PR; state <= LV_BTN_STATE_REL; state++) {
+    	    lv_rects_t * new_rects = &state_rects[state];
+			memcpy(new_rects, &style->btns, sizeof(lv_rects_t));
+			new_rects->objs.color = style->btns.mcolor[state];
+			new_rects->gcolor = style->btns.gcolor[state];
+			new_rects->bcolor = style->btns.bcolor[state];
+			new_rects->lcolor = style->btns.lcolor[state];
+			new_rects->empty = style->btns.flags[state].empty;
+			new_rects->objs.transp = style->btns.flags[state].transp;
+
+			if(style->btns.flags[state].light_en != 0) new_rects->light = style->rects.light;
+			else new_rects->light = 0;
+    	}
+
+    	/*Draw only the buttons on the mask (typically only the pressed and released ones)*/
+    	uint16_t row_i;
+    	uint16_t btn_i;
+    	for(row_i = 0; row_i < ext->row_cnt; row_i ++) {
+    	    uint16_t row_end = row_i + 1 < ext->row_cnt ? ext->row_first[row_i + 1] : ext->btn_cnt;
+    	    area_t * row_a = &ext->btns[ext->row_first[row_i]].area;
+    	    if(row_a->y1 + area_btnm.y1 > mask->y2) break;
+    	    if(row_a->y2 + area_btnm.y1 < mask->y1) continue;
+
+    	    for(btn_i = ext->row_first[row_i]; btn_i < row_end; btn_i ++) {
+    	        lv_btnm_btn_t * btn = &ext->btns[btn_i];
+    	        area_cpy(&area_tmp, &btn->area);
+    	        area_tmp.x1 += area_btnm.x1;
+    	        area_tmp.y1 += area_btnm.y1;
+    	        area_tmp.x2 += area_btnm.x1;
+    	        area_tmp.y2 += area_btnm.y1;
+
+    	        if(area_tmp.x1 > mask->x2) break;
+    	        if(area_tmp.x2 < mask->x1) continue;
+
+    	        btn_w = area_get_width(&area_tmp);
+    	        btn_h = area_get_height(&area_tmp);
+
+    	        lv_draw_rect(&area_tmp, mask, &state_rects[ext->btn_pr == btn_i ? LV_BTN_STATE_PR : LV_BTN_STATE_REL], OPA_COVER);
+
+    	        area_tmp.x1 += (btn_w - btn->txt_size.x) / 2;
+    	        area_tmp.y1 += (btn_h - btn->txt_size.y) / 2;
+    	        area_tmp.x2 = area_tmp.x1 + btn->txt_size.x;
+    	        area_tmp.y2 = area_tmp.y1 + btn->txt_size.y;
+
+    	        lv_draw_label(&area_tmp, mask, &style->labels, OPA_COVER, ext->map_p[btn->txt_i]);
+    	    }
     	}
     }
 
@@ -463,24 +453,32 @@ static void lv_btnms_init(void)
  */
 static void lv_btnm_create_btns(lv_obj_t * btnm, const char ** map)
 {
-	/*Count the buttons in the map*/
+	/*Count the buttons and the not empty rows in the map*/
 	uint16_t btn_cnt = 0;
+	uint16_t row_cnt = 0;
+	bool row_empty = true;
 	uint16_t i = 0;
 	while(strlen(map[i]) != 0) {
-			if(strcmp(map[i], "\n") != 0) { /*Do not count line breaks*/
+		if(strcmp(map[i], "\n") != 0) { /*Do not count line breaks*/
 			btn_cnt ++;
+			if(row_empty != false) row_cnt ++;
+			row_empty = false;
+		} else {
+			row_empty = true;
 		}
 		i++;
 	}
 
 	lv_btnm_ext_t * ext = lv_obj_get_ext(btnm);
 
-	if(ext->btn_areas != NULL) {
-		dm_free(ext->btn_areas);
-	}
+	if(ext->btns != NULL) dm_free(ext->btns);
+	if(ext->row_first != NULL) dm_free(ext->row_first);
 
-	ext->btn_areas = dm_alloc(sizeof(area_t) * btn_cnt);
+	ext->btns = dm_alloc(sizeof(lv_btnm_btn_t) * btn_cnt);
+	ext->row_first = dm_alloc(sizeof(uint16_t) * row_cnt);
 	ext->btn_cnt = btn_cnt;
+	ext->row_cnt = row_cnt;
+	if(ext->btn_pr >= btn_cnt) ext->btn_pr = LV_BTNM_BTN_PR_INVALID;
 }
 
 /**
@@ -496,28 +494,63 @@ static uint8_t lv_btnm_get_width_unit(const char * btn_str)
 
 }
 
+/**
+ * Get the button on a point
+ * @param btnm pointer to button matrix object
+ * @param p an absolute point
+ * @return index of the button on 'p' or LV_BTNM_BTN_PR_INVALID
+ */
 static uint16_t lv_btnm_get_btn_from_point(lv_obj_t * btnm, point_t * p)
 {
     area_t btnm_cords;
-    area_t btn_area;
     lv_btnm_ext_t * ext = lv_obj_get_ext(btnm);
-    uint16_t i;
     lv_obj_get_cords(btnm, &btnm_cords);
 
-    for(i = 0; i < ext->btn_cnt; i++) {
-        area_cpy(&btn_area, &ext->btn_areas[i]);
-        btn_area.x1 += btnm_cords.x1;
-        btn_area.y1 += btnm_cords.y1;
-        btn_area.x2 += btnm_cords.x1;
-        btn_area.y2 += btnm_cords.y1;
-        if(area_is_point_on(&btn_area, p) != false) {
-            break;
-        }
+    cord_t x = p->x - btnm_cords.x1;
+    cord_t y = p->y - btnm_cords.y1;
+
+    /*Find the last row which starts above the point (the rows are sorted vertically)*/
+    uint16_t row_min = 0;
+    uint16_t row_max = ext->row_cnt;
+    while(row_min < row_max) {
+        uint16_t row_mid = (row_min + row_max) / 2;
+        if(ext->btns[ext->row_first[row_mid]].area.y1 <= y) row_min = row_mid + 1;
+        else row_max = row_mid;
     }
+    if(row_min == 0) return LV_BTNM_BTN_PR_INVALID;
 
-    if(i == ext->btn_cnt) i = LV_BTNM_BTN_PR_INVALID;
+    uint16_t row_i = row_min - 1;
+    uint16_t row_end = row_i + 1 < ext->row_cnt ? ext->row_first[row_i + 1] : ext->btn_cnt;
+    uint16_t i;
+    for(i = ext->row_first[row_i]; i < row_end; i++) {
+        area_t * btn_area = &ext->btns[i].area;
+        if(x < btn_area->x1) break;
+        if(x <= btn_area->x2 && y <= btn_area->y2) return i;
+    }
+
+    return LV_BTNM_BTN_PR_INVALID;
+}
 
-    return i;
+/**
+ * Invalidate the area of a button
+ * @param btnm pointer to button matrix object
+ * @param btn_i index of a button (LV_BTNM_BTN_PR_INVALID: nothing to do)
+ */
+static void lv_btnm_inv_btn(lv_obj_t * btnm, uint16_t btn_i)
+{
+    lv_btnm_ext_t * ext = lv_obj_get_ext(btnm);
+    if(btn_i >= ext->btn_cnt) return;
+
+    area_t btnm_area;
+    area_t btn_area;
+    lv_obj_get_cords(btnm, &btnm_area);
+    area_cpy(&btn_area, &ext->btns[btn_i].area);
+    btn_area.x1 += btnm_area.x1;
+    btn_area.y1 += btnm_area.y1;
+    btn_area.x2 += btnm_area.x1;
+    btn_area.y2 += btnm_area.y1;
+
+    lv_obj_inv_area(btnm, &btn_area);
 }
 
 
@@ -40,14 +40,24 @@
  * return LV_ACTION_RES_INV:  the button matrix is deleted else LV_ACTION_RES_OK*/
 typedef lv_action_res_t (*lv_btnm_callback_t) (lv_obj_t *, uint16_t);
 
+/*A button of a button matrix (laid out by 'lv_btnm_set_map')*/
+typedef struct
+{
+    area_t area;            /*Area of the button relative to the button matrix*/
+    point_t txt_size;       /*Size of the label*/
+    uint16_t txt_i;         /*Index of the label in the map*/
+}lv_btnm_btn_t;
+
 /*Data of button matrix*/
 typedef struct
 {
     lv_rect_ext_t rect; /*Ext. of ancestor*/
     /*New data for this type */
     const char ** map_p;    /*Pointer to the current map*/
-    area_t * btn_areas;
+    lv_btnm_btn_t * btns;   /*The buttons row by row*/
+    uint16_t * row_first;   /*Index of the first button of every row*/
     uint16_t btn_cnt;
+    uint16_t row_cnt;       /*Number of rows with buttons*/
     uint16_t btn_pr;
     lv_btnm_callback_t cb;
 }lv_btnm_ext_t;
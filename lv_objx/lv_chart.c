@@ -11,6 +11,7 @@
 
 #include "lv_chart.h"
 #include "../lv_draw/lv_draw.h"
+#include "misc/math/math_base.h"
 
 /*********************
  *      DEFINES
@@ -21,6 +22,13 @@
 #define LV_CHART_VDIV_DEF	5
 #define LV_CHART_PNUM_DEF	10
 
+/*Test configurations*/
+#ifndef LV_CHART_LOD_SHIFT
+#define LV_CHART_LOD_SHIFT	2	/*A level of the min/max pyramids merges 2^LV_CHART_LOD_SHIFT elements*/
+#endif
+
+#define LV_CHART_LOD_N		(1 << LV_CHART_LOD_SHIFT)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,6 +42,19 @@ static void lv_chart_draw_div(lv_obj_t * chart, const area_t * mask);
 static void lv_chart_draw_lines(lv_obj_t * chart, const area_t * mask);
 static void lv_chart_draw_points(lv_obj_t * chart, const area_t * mask);
 static void lv_chart_draw_cols(lv_obj_t * chart, const area_t * mask);
+static void lv_chart_draw_lod(lv_obj_t * chart, const lv_chart_dl_t * dl, const area_t * mask, color_t color);
+static void lv_chart_lod_update(lv_chart_dl_t * dl, uint32_t first, uint32_t last);
+static void lv_chart_lod_minmax(const lv_chart_dl_t * dl, uint32_t a, uint32_t b, cord_t * min_p, cord_t * max_p);
+static cord_t lv_chart_get_y(lv_obj_t * chart, int32_t v);
+static void lv_chart_get_vis_range(lv_obj_t * chart, const area_t * mask, cord_t pad, uint16_t div,
+                                   uint16_t * first, uint16_t * last);
+static lv_chart_dl_t * lv_chart_get_dl(lv_obj_t * chart, cord_t * points);
+static int32_t lv_chart_dl_get(const lv_chart_dl_t * dl, uint32_t i);
+static void lv_chart_dl_set(lv_chart_dl_t * dl, uint32_t i, cord_t y);
+static bool lv_chart_has_all_dl(lv_obj_t * chart, cord_t ** dl, uint8_t dl_num);
+static void lv_chart_dl_rotate(cord_t * points, uint16_t pnum, uint16_t start);
+static void lv_chart_inv_points(lv_obj_t * chart, uint16_t first, uint16_t num);
+static void lv_chart_inv_shift(lv_obj_t * chart, uint16_t num);
 
 
 /**********************
@@ -70,7 +91,7 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, lv_obj_t * copy)
     /*Allocate the object type specific extended data*/
     lv_chart_ext_t * ext = lv_obj_alloc_ext(new_chart, sizeof(lv_chart_ext_t));
     dm_assert(ext);
-    ll_init(&ext->dl_ll, sizeof(cord_t *));
+    ll_init(&ext->dl_ll, sizeof(lv_chart_dl_t));
     ext->dl_num = 0;
     ext->ymin = LV_CHART_YMIN_DEF;
     ext->ymax = LV_CHART_YMAX_DEF;
@@ -78,6 +99,9 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, lv_obj_t * copy)
     ext->vdiv_num = LV_CHART_VDIV_DEF;
     ext->pnum = LV_CHART_PNUM_DEF;
     ext->type = LV_CHART_LINE;
+    ext->mode = LV_CHART_MODE_SHIFT;
+    ext->view_start = 0;
+    ext->view_num = 0;
 
     if(ancestor_design_f == NULL) ancestor_design_f = lv_obj_get_design_f(new_chart);
 
@@ -95,6 +119,9 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, lv_obj_t * copy)
 		ext->hdiv_num = ext_copy->hdiv_num;
 		ext->vdiv_num = ext_copy->vdiv_num;
         ext->pnum = ext_copy->pnum;
+        ext->mode = ext_copy->mode;
+        ext->view_start = ext_copy->view_start;
+        ext->view_num = ext_copy->view_num;
 
         /*Refresh the style with new signal function*/
         lv_obj_refr_style(new_chart);
@@ -119,12 +146,13 @@ bool lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param)
     /* The object can be deleted so check its validity and then
      * make the object specific signal handling */
     if(valid != false) {
-    	cord_t ** datal;
+    	lv_chart_dl_t * datal;
     	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
     	switch(sign) {
     		case LV_SIGNAL_CLEANUP:
     			LL_READ(ext->dl_ll, datal) {
-    				dm_free(*datal);
+    				if(datal->ext_buf == 0) dm_free(datal->points);
+    				if(datal->lod != NULL) dm_free(datal->lod);
     			}
 
     			ll_clear(&ext->dl_ll);
@@ -146,15 +174,23 @@ bool lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param)
 cord_t * lv_chart_add_dataline(lv_obj_t * chart)
 {
 	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
-	cord_t ** dl = ll_ins_head(&ext->dl_ll);
+	lv_chart_dl_t * dl = ll_ins_head(&ext->dl_ll);
 	cord_t def = (ext->ymax - ext->ymin) >> 2;	/*1/4 range as default value*/
 
 	if(dl == NULL) return NULL;
 
-	*dl = dm_alloc(sizeof(cord_t) * ext->pnum);
+	dl->points = dm_alloc(sizeof(cord_t) * ext->pnum);
+	dl->start = 0;
+	dl->lod = NULL;
+	dl->num = 0;
+	dl->lod_lvl = 0;
+	dl->stride = sizeof(cord_t);
+	dl->data_type = LV_CHART_DATA_CORD;
+	dl->ext_buf = 0;
+	dl->lod_en = 0;
 
 	uint16_t i;
-	cord_t * p_tmp = *dl;
+	cord_t * p_tmp = dl->points;
 	for(i = 0; i < ext->pnum; i++) {
 		*p_tmp = def;
 		p_tmp++;
@@ -162,7 +198,136 @@ cord_t * lv_chart_add_dataline(lv_obj_t * chart)
 
 	ext->dl_num++;
 
-	return *dl;
+	return dl->points;
+}
+
+/**
+ * Allocate and add a data line with many points (even much more than the width of the chart).
+ * It is drawn from a min/max pyramid of its points so the drawing time depends only on the width.
+ * It is drawn as a line independently from the type of the chart.
+ * @param chart pointer to a chart object
+ * @param pnum number of points of the data line
+ * @return pointer to the allocated data line (an array for the data points) or NULL if out of memory.
+ *         Call 'lv_chart_refr_points' after the points are changed directly.
+ */
+cord_t * lv_chart_add_dataline_lod(lv_obj_t * chart, uint32_t pnum)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	cord_t def = (ext->ymax - ext->ymin) >> 2;	/*1/4 range as default value*/
+
+	if(pnum < 1) pnum = 1;
+
+	/*Every level has 1/LV_CHART_LOD_N as many min/max pairs as the level below it*/
+	uint8_t lvl = 0;
+	uint32_t lod_size = 0;
+	uint32_t n = pnum;
+	while(n > LV_CHART_LOD_N) {
+		n = (n + LV_CHART_LOD_N - 1) >> LV_CHART_LOD_SHIFT;
+		lod_size += 2 * n;
+		lvl++;
+	}
+
+	cord_t * points = dm_alloc(sizeof(cord_t) * pnum);
+	cord_t * lod = NULL;
+	if(lod_size != 0) lod = dm_alloc(sizeof(cord_t) * lod_size);
+	if(points == NULL || (lod_size != 0 && lod == NULL)) {
+		if(points != NULL) dm_free(points);
+		if(lod != NULL) dm_free(lod);
+		return NULL;
+	}
+
+	lv_chart_dl_t * dl = ll_ins_head(&ext->dl_ll);
+	if(dl == NULL) {
+		dm_free(points);
+		if(lod != NULL) dm_free(lod);
+		return NULL;
+	}
+
+	uint32_t i;
+	for(i = 0; i < pnum; i++) points[i] = def;
+
+	dl->points = points;
+	dl->start = 0;
+	dl->lod = lod;
+	dl->num = pnum;
+	dl->lod_lvl = lvl;
+	dl->stride = sizeof(cord_t);
+	dl->data_type = LV_CHART_DATA_CORD;
+	dl->ext_buf = 0;
+	dl->lod_en = 1;
+	lv_chart_lod_update(dl, 0, pnum - 1);
+
+	ext->dl_num++;
+
+	return dl->points;
+}
+
+/**
+ * Add a data line which reads its points directly from a buffer of the application (no copy).
+ * The buffer is used as a ring buffer of 'pnum' points (see 'lv_chart_set_pnum') from 'lv_chart_get_start'.
+ * The values out of the range of 'cord_t' are limited.
+ * @param chart pointer to a chart object
+ * @param buf pointer to the first point. It has to be valid while the data line exists.
+ * @param buf_pnum number of points in 'buf'. It can't be less than 'lv_chart_get_pnum'
+ *                 and 'lv_chart_set_pnum' can't set more points later.
+ * @param type type of the points (from 'lv_chart_data_t')
+ * @param stride distance of the points in bytes (e.g. to use a field of an array of structures)
+ *               0: size of 'type'
+ * @return 'buf' as a data line of 'chart' (to use with the other functions) or NULL if
+ *         'buf_pnum' is too small or out of memory.
+ *         Call 'lv_chart_shift' after new points are written to the buffer directly.
+ */
+cord_t * lv_chart_add_dataline_ext(lv_obj_t * chart, void * buf, uint32_t buf_pnum, lv_chart_data_t type, uint16_t stride)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+
+	if(buf == NULL || buf_pnum < ext->pnum) return NULL;
+
+	if(stride == 0) {
+		switch(type) {
+			case LV_CHART_DATA_INT16: stride = sizeof(int16_t); break;
+			case LV_CHART_DATA_INT32: stride = sizeof(int32_t); break;
+			case LV_CHART_DATA_FLOAT: stride = sizeof(float); break;
+			default: stride = sizeof(cord_t); break;
+		}
+	}
+
+	lv_chart_dl_t * dl = ll_ins_head(&ext->dl_ll);
+	if(dl == NULL) return NULL;
+
+	dl->points = buf;
+	dl->start = 0;
+	dl->lod = NULL;
+	dl->num = buf_pnum;
+	dl->lod_lvl = 0;
+	dl->stride = stride;
+	dl->data_type = type;
+	dl->ext_buf = 1;
+	dl->lod_en = 0;
+
+	ext->dl_num++;
+	lv_chart_refr(chart);
+
+	return dl->points;
+}
+
+/**
+ * Update the min/max pyramid of a data line after its points are changed directly and redraw the chart
+ * @param chart pointer to a chart object
+ * @param dl pointer to a data line on 'chart' (a return value of 'lv_chart_add_dataline_lod')
+ * @param first index of the first changed point
+ * @param num number of changed points
+ */
+void lv_chart_refr_points(lv_obj_t * chart, cord_t * dl, uint32_t first, uint32_t num)
+{
+	lv_chart_dl_t * dl_p = lv_chart_get_dl(chart, dl);
+	if(dl_p == NULL || dl_p->lod_en == 0 || num == 0 || first >= dl_p->num) return;
+
+	uint32_t last = first + num - 1;
+	if(last >= dl_p->num) last = dl_p->num - 1;
+	lv_chart_lod_update(dl_p, first, last);
+
+	lv_chart_refr(chart);
 }
 
 /**
@@ -228,16 +393,42 @@ void lv_chart_set_type(lv_obj_t * chart, lv_chart_type_t type)
  * Set the number of points on a data line on a chart
  * @param chart pointer r to chart object
  * @param pnum new number of points on the data lines
+ *             (limited to the size of the buffers of 'lv_chart_add_dataline_ext')
  */
 void lv_chart_set_pnum(lv_obj_t * chart, uint16_t pnum)
 {
 	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
-	cord_t ** y_data;
+	lv_chart_dl_t * y_data;
+	cord_t def = (ext->ymax - ext->ymin) >> 2;	/*1/4 range as default value*/
 
 	if(pnum < 1) pnum = 1;
 
+	/*The buffers of the application can't be reallocated so don't read beyond them*/
+	LL_READ(ext->dl_ll, y_data) {
+		if(y_data->ext_buf != 0 && pnum > y_data->num) pnum = y_data->num;
+	}
+
 	LL_READ_BACK(ext->dl_ll, y_data) {
-		*y_data = dm_realloc(*y_data, sizeof(cord_t) * pnum);
+		if(y_data->lod_en != 0) continue;	/*Has its own point number*/
+
+		/*The buffer of the application is not reallocated*/
+		if(y_data->ext_buf != 0) {
+			if(y_data->start >= pnum) y_data->start = 0;
+			continue;
+		}
+
+		/*In shift mode store the points from the oldest again to keep their order*/
+		if(ext->mode == LV_CHART_MODE_SHIFT) {
+			lv_chart_dl_rotate(y_data->points, ext->pnum, y_data->start);
+			y_data->start = 0;
+		} else if(y_data->start >= pnum) {
+			y_data->start = 0;
+		}
+
+		y_data->points = dm_realloc(y_data->points, sizeof(cord_t) * pnum);
+
+		uint16_t i;
+		for(i = ext->pnum; i < pnum; i++) y_data->points[i] = def;
 	}
 
 	ext->pnum = pnum;
@@ -245,23 +436,128 @@ void lv_chart_set_pnum(lv_obj_t * chart, uint16_t pnum)
 }
 
 /**
- * Shift all data right and set the most right data on a data line
+ * Set how 'lv_chart_set_next' adds the new points
+ * @param chart pointer to a chart object
+ * @param mode LV_CHART_MODE_SHIFT or LV_CHART_MODE_SWEEP
+ */
+void lv_chart_set_mode(lv_obj_t * chart, lv_chart_mode_t mode)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	if(ext->mode == mode) return;
+
+	ext->mode = mode;
+	lv_chart_refr(chart);
+}
+
+/**
+ * Show only a part of the data lines with min/max pyramid (to zoom and pan them)
+ * @param chart pointer to a chart object
+ * @param start index of the first shown point (from the oldest one)
+ * @param num number of shown points (0: all)
+ */
+void lv_chart_set_view(lv_obj_t * chart, uint32_t start, uint32_t num)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	if(ext->view_start == start && ext->view_num == num) return;
+
+	ext->view_start = start;
+	ext->view_num = num;
+	lv_chart_refr(chart);
+}
+
+/**
+ * Add a new point to a data line. The oldest point is overwritten (no data is moved in the memory).
+ * In LV_CHART_MODE_SHIFT the new point is the most right and the others are shifted left
+ * (the drawn points are moved if enabled with 'lv_obj_set_move_copy').
+ * In LV_CHART_MODE_SWEEP only the columns of the overwritten point are redrawn.
  * @param chart pointer to chart object
  * @param dl pointer to a data line on 'chart'
- * @param y the new value of the most right data
+ * @param y the new value
  */
 void lv_chart_set_next(lv_obj_t * chart, cord_t * dl, cord_t y)
 {
-	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	lv_chart_set_next_array(chart, &dl, 1, &y, 1);
+}
 
-	uint16_t i;
-	for(i = 0; i < ext->pnum - 1; i++) {
-		dl[i] = dl[i + 1];
+/**
+ * Add more new points to more data lines at once. The chart is refreshed only once.
+ * If all data lines of the chart are given their drawn points are moved in LV_CHART_MODE_SHIFT
+ * (see 'lv_chart_set_next').
+ * @param chart pointer to chart object
+ * @param dl array of data lines on 'chart'
+ * @param dl_num number of data lines in 'dl'
+ * @param y the new values after each other for every data line:
+ *          y[0]: 1st point of dl[0], y[1]: 1st point of dl[1], ... y[dl_num]: 2nd point of dl[0] ...
+ * @param num number of new points per data line
+ */
+void lv_chart_set_next_array(lv_obj_t * chart, cord_t ** dl, uint8_t dl_num, const cord_t * y, uint16_t num)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	uint8_t d;
+
+	for(d = 0; d < dl_num; d++) {
+		lv_chart_dl_t * dl_p = lv_chart_get_dl(chart, dl[d]);
+		if(dl_p == NULL) continue;
+
+		uint32_t n = dl_p->lod_en != 0 ? dl_p->num : ext->pnum;
+		uint32_t p_i = dl_p->start;
+		uint16_t i;
+		for(i = 0; i < num; i++) {
+			lv_chart_dl_set(dl_p, p_i, y[(uint32_t)i * dl_num + d]);
+			p_i++;
+			if(p_i >= n) p_i = 0;
+		}
 	}
 
-	dl[ext->pnum - 1] = y;
-	lv_chart_refr(chart);
+	lv_chart_shift(chart, dl, dl_num, num);
+}
+
+/**
+ * Add the points to data lines which are already written after the newest ones
+ * (from 'lv_chart_get_start' in the ring buffer). Used mainly with external buffers.
+ * @param chart pointer to chart object
+ * @param dl array of data lines on 'chart'
+ * @param dl_num number of data lines in 'dl'
+ * @param num number of new points per data line
+ */
+void lv_chart_shift(lv_obj_t * chart, cord_t ** dl, uint8_t dl_num, uint16_t num)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	bool refr = false;
+	uint8_t d;
+
+	if(num == 0) return;
+
+	for(d = 0; d < dl_num; d++) {
+		lv_chart_dl_t * dl_p = lv_chart_get_dl(chart, dl[d]);
+		if(dl_p == NULL) continue;
+
+		if(dl_p->lod_en != 0) {
+			uint32_t first = dl_p->start;
+			if(num >= dl_p->num) {
+				lv_chart_lod_update(dl_p, 0, dl_p->num - 1);
+			} else if(first + num <= dl_p->num) {
+				lv_chart_lod_update(dl_p, first, first + num - 1);
+			} else {
+				lv_chart_lod_update(dl_p, first, dl_p->num - 1);
+				lv_chart_lod_update(dl_p, 0, first + num - dl_p->num - 1);
+			}
+			dl_p->start = (first + num) % dl_p->num;
+			refr = true;
+			continue;
+		}
+
+		if(ext->mode == LV_CHART_MODE_SWEEP) lv_chart_inv_points(chart, dl_p->start, num);
+		dl_p->start = (dl_p->start + num) % ext->pnum;
+	}
 
+	if(refr != false) {
+		lv_chart_refr(chart);
+	} else if(ext->mode == LV_CHART_MODE_SHIFT) {
+		/*The drawn points can be moved only if every data line is shifted*/
+		if(lv_chart_has_all_dl(chart, dl, dl_num) != false) lv_chart_inv_shift(chart, num);
+		else lv_chart_refr(chart);
+	}
 }
 
 /*=====================
@@ -292,6 +588,32 @@ uint16_t lv_chart_get_pnum(lv_obj_t * chart)
     return ext->pnum;
 }
 
+/**
+ * Get how 'lv_chart_set_next' adds the new points
+ * @param chart pointer to chart object
+ * @return LV_CHART_MODE_SHIFT or LV_CHART_MODE_SWEEP
+ */
+lv_chart_mode_t lv_chart_get_mode(lv_obj_t * chart)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+
+    return ext->mode;
+}
+
+/**
+ * Get the index of the oldest point of a data line. In LV_CHART_MODE_SHIFT it is drawn
+ * as the most left point, in LV_CHART_MODE_SWEEP it is the next to overwrite.
+ * @param chart pointer to chart object
+ * @param dl pointer to a data line on 'chart'
+ * @return index of the oldest point in 'dl'
+ */
+uint32_t lv_chart_get_start(lv_obj_t * chart, cord_t * dl)
+{
+    lv_chart_dl_t * dl_p = lv_chart_get_dl(chart, dl);
+
+    return dl_p != NULL ? dl_p->start : 0;
+}
+
 /**
  * Return with a pointer to a built-in style and/or copy it to a variable
  * @param style a style name from lv_charts_builtin_t enum
@@ -424,7 +746,7 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const area_t * mask)
 	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
 	lv_charts_t * style_p = lv_obj_get_style(chart);
 
-	uint8_t i;
+	uint16_t i;
 	point_t p1;
 	point_t p2;
 	cord_t w = lv_obj_get_width(chart);
@@ -433,33 +755,59 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const area_t * mask)
     cord_t x_ofs = chart->cords.x1;
     cord_t y_ofs = chart->cords.y1;
 	int32_t y_tmp;
-	cord_t ** y_data;
+	lv_chart_dl_t * y_data;
 	uint8_t dl_cnt = 0;
 	lv_lines_t lines;
 	lv_lines_get(LV_LINES_CHART, &lines);
 
+	/*Draw only the lines on the mask (the line 'i' ends in the point 'i')*/
+	uint16_t first;
+	uint16_t last;
+	lv_chart_get_vis_range(chart, mask, style_p->width + 1, ext->pnum - 1, &first, &last);
+	if(first == 0) first = 1;
+
 	/*Go through all data lines*/
 	LL_READ_BACK(ext->dl_ll, y_data) {
+		if(y_data->lod_en != 0) {
+			lv_chart_draw_lod(chart, y_data, mask, style_p->color[dl_cnt]);
+			dl_cnt++;
+			continue;
+		}
+
+		if(ext->pnum < 2 || first > last) {
+			dl_cnt++;
+			continue;
+		}
+
 		lines.objs.color = style_p->color[dl_cnt];
 		lines.width = style_p->width;
 
-		p1.x = 0 + x_ofs;
-		p2.x = 0 + x_ofs;
-		y_tmp = (int32_t)((int32_t) (*y_data)[0] - ext->ymin) * h;
+		/* In shift mode the most left point is the oldest ('start').
+		 * In sweep mode the points don't move but there is no line from the newest to the oldest*/
+		uint16_t p_ofs = ext->mode == LV_CHART_MODE_SHIFT ? y_data->start : 0;
+		uint16_t gap = ext->mode == LV_CHART_MODE_SWEEP ? y_data->start : 0;
+		uint16_t p_i = first - 1 + p_ofs;
+		if(p_i >= ext->pnum) p_i -= ext->pnum;
+
+		p2.x = ((w * (first - 1)) / (ext->pnum - 1)) + x_ofs;
+		y_tmp = (int32_t)(lv_chart_dl_get(y_data, p_i) - ext->ymin) * h;
 		y_tmp = y_tmp / (ext->ymax - ext->ymin);
 		p2.y = h - y_tmp + y_ofs;
 
-		for(i = 1; i < ext->pnum; i ++) {
+		for(i = first; i <= last; i ++) {
 			p1.x = p2.x;
 			p1.y = p2.y;
 
+			p_i++;
+			if(p_i >= ext->pnum) p_i = 0;
+
 			p2.x = ((w * i) / (ext->pnum - 1)) + x_ofs;
 
-			y_tmp = (int32_t)((int32_t) (*y_data)[i] - ext->ymin) * h;
+			y_tmp = (int32_t)(lv_chart_dl_get(y_data, p_i) - ext->ymin) * h;
 			y_tmp = y_tmp / (ext->ymax - ext->ymin);
 			p2.y = h - y_tmp + y_ofs;
 
-			lv_draw_line(&p1, &p2, mask, &lines, opa);
+			if(i != gap) lv_draw_line(&p1, &p2, mask, &lines, opa);
 		}
 		dl_cnt++;
 	}
@@ -475,7 +823,7 @@ static void lv_chart_draw_points(lv_obj_t * chart, const area_t * mask)
 	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
 	lv_charts_t * style_p = lv_obj_get_style(chart);
 
-	uint8_t i;
+	uint16_t i;
 	area_t cir_a;
 	cord_t w = lv_obj_get_width(chart);
 	cord_t h = lv_obj_get_height(chart);
@@ -483,7 +831,7 @@ static void lv_chart_draw_points(lv_obj_t * chart, const area_t * mask)
     cord_t x_ofs = chart->cords.x1;
     cord_t y_ofs = chart->cords.y1;
 	int32_t y_tmp;
-	cord_t ** y_data;
+	lv_chart_dl_t * y_data;
 	uint8_t dl_cnt = 0;
 	lv_rects_t rects;
 	cord_t rad = style_p->width;
@@ -493,23 +841,45 @@ static void lv_chart_draw_points(lv_obj_t * chart, const area_t * mask)
 	rects.empty = 0;
 	rects.round = LV_RECT_CIRCLE;
 
+	/*Draw only the points on the mask*/
+	uint16_t first;
+	uint16_t last;
+	lv_chart_get_vis_range(chart, mask, rad + 1, ext->pnum - 1, &first, &last);
+
 	/*Go through all data lines*/
 	LL_READ_BACK(ext->dl_ll, y_data) {
+		if(y_data->lod_en != 0) {
+			lv_chart_draw_lod(chart, y_data, mask, style_p->color[dl_cnt]);
+			dl_cnt++;
+			continue;
+		}
+
+		if(ext->pnum < 2) {
+			dl_cnt++;
+			continue;
+		}
+
 		rects.objs.color = style_p->color[dl_cnt];
 		rects.gcolor = color_mix(COLOR_BLACK, style_p->color[dl_cnt], style_p->dark_eff);
 
-		for(i = 0; i < ext->pnum; i ++) {
+		uint16_t p_i = first + (ext->mode == LV_CHART_MODE_SHIFT ? y_data->start : 0);
+		if(p_i >= ext->pnum) p_i -= ext->pnum;
+
+		for(i = first; i <= last; i ++) {
 			cir_a.x1 = ((w * i) / (ext->pnum - 1)) + x_ofs;
 			cir_a.x2 = cir_a.x1 + rad;
 			cir_a.x1 -= rad;
 
-			y_tmp = (int32_t)((int32_t) (*y_data)[i] - ext->ymin) * h;
+			y_tmp = (int32_t)(lv_chart_dl_get(y_data, p_i) - ext->ymin) * h;
 			y_tmp = y_tmp / (ext->ymax - ext->ymin);
 			cir_a.y1 = h - y_tmp + y_ofs;
 			cir_a.y2 = cir_a.y1 + rad;
 			cir_a.y1 -= rad;
 
 			lv_draw_rect(&cir_a, mask, &rects, opa);
+
+			p_i++;
+			if(p_i >= ext->pnum) p_i = 0;
 		}
 		dl_cnt++;
 	}
@@ -525,7 +895,7 @@ static void lv_chart_draw_cols(lv_obj_t * chart, const area_t * mask)
 	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
 	lv_charts_t * style_p = lv_obj_get_style(chart);
 
-	uint8_t i;
+	uint16_t i;
 	area_t col_a;
 	area_t col_mask;
 	bool mask_ret;
@@ -533,9 +903,10 @@ static void lv_chart_draw_cols(lv_obj_t * chart, const area_t * mask)
 	cord_t h = lv_obj_get_height(chart);
 	opa_t opa = (uint16_t)lv_obj_get_opa(chart) * style_p->data_opa / 100;
 	int32_t y_tmp;
-	cord_t ** y_data;
+	lv_chart_dl_t * y_data;
 	uint8_t dl_cnt = 0;
 	lv_rects_t rects;
+	if(ext->dl_num == 0) return;
 	cord_t col_w = w / (2 * ext->dl_num * ext->pnum); /* Suppose (2 * dl_num) * pnum columns*/
 	cord_t x_ofs = col_w / 2; /*Shift with a half col.*/
 	lv_rects_get(LV_RECTS_DEF, &rects);
@@ -545,12 +916,26 @@ static void lv_chart_draw_cols(lv_obj_t * chart, const area_t * mask)
 
 	col_a.y2 = chart->cords.y2;
 
+	/*Draw only the columns on the mask (the columns of a point are in its 1/pnum slot)*/
+	uint16_t first;
+	uint16_t last;
+	lv_chart_get_vis_range(chart, mask, w / ext->pnum + 1, ext->pnum, &first, &last);
+
 	/*Go through all data lines*/
 	LL_READ_BACK(ext->dl_ll, y_data) {
+		if(y_data->lod_en != 0) {
+			lv_chart_draw_lod(chart, y_data, mask, style_p->color[dl_cnt]);
+			dl_cnt++;
+			continue;
+		}
+
 		rects.objs.color = style_p->color[dl_cnt];
 		rects.gcolor = color_mix(COLOR_BLACK, style_p->color[dl_cnt], style_p->dark_eff);
 
-		for(i = 0; i < ext->pnum; i ++) {
+		uint16_t p_i = first + (ext->mode == LV_CHART_MODE_SHIFT ? y_data->start : 0);
+		if(p_i >= ext->pnum) p_i -= ext->pnum;
+
+		for(i = first; i <= last; i ++) {
 			/* Calculate the x coordinates. Suppose (2 * dl_num) * pnum columns and draw to every second
 			 * the other columns will be spaces.
 			 * col_w =  w / (2 * ext->dl_num * ext->pnum)
@@ -565,7 +950,7 @@ static void lv_chart_draw_cols(lv_obj_t * chart, const area_t * mask)
 			col_a.x2 += x_ofs;
 
 
-			y_tmp = (int32_t)((int32_t) (*y_data)[i] - ext->ymin) * h;
+			y_tmp = (int32_t)(lv_chart_dl_get(y_data, p_i) - ext->ymin) * h;
 			y_tmp = y_tmp / (ext->ymax - ext->ymin);
 			col_a.y1 = h - y_tmp + chart->cords.y1;
 
@@ -573,11 +958,527 @@ static void lv_chart_draw_cols(lv_obj_t * chart, const area_t * mask)
 			if(mask_ret != false) {
 				lv_draw_rect(&chart->cords, &col_mask, &rects, opa);
 			}
+
+			p_i++;
+			if(p_i >= ext->pnum) p_i = 0;
 		}
 		dl_cnt++;
 	}
 }
 
+/**
+ * Draw a data line with min/max pyramid. Every pixel column is drawn from the min. and max.
+ * of its points or lines are drawn between the points if there are less points than columns.
+ * @param chart pointer to chart object
+ * @param dl pointer to a data line with min/max pyramid
+ * @param mask mask, inherited from the design function
+ * @param color color of the data line
+ */
+static void lv_chart_draw_lod(lv_obj_t * chart, const lv_chart_dl_t * dl, const area_t * mask, color_t color)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	lv_charts_t * style_p = lv_obj_get_style(chart);
+	opa_t opa = (uint16_t)lv_obj_get_opa(chart) * style_p->data_opa / 100;
+	int32_t w = lv_obj_get_width(chart);
+	cord_t x_ofs = chart->cords.x1;
+
+	/*The shown points (from the oldest)*/
+	uint32_t view_start = ext->view_start;
+	uint32_t view_num = ext->view_num;
+	if(view_start >= dl->num) return;
+	if(view_num == 0 || view_num > dl->num - view_start) view_num = dl->num - view_start;
+	if(view_num < 2) return;
+
+	/*In shift mode the oldest point is the first*/
+	uint32_t p_ofs = ext->mode == LV_CHART_MODE_SHIFT ? dl->start : 0;
+
+	/*Less points than columns: draw lines between them*/
+	if(view_num - 1 <= w / LV_DOWNSCALE) {
+		lv_lines_t lines;
+		lv_lines_get(LV_LINES_CHART, &lines);
+		lines.objs.color = color;
+		lines.width = style_p->width;
+
+		int32_t pad = style_p->width + 1;
+		int32_t first = ((int32_t)mask->x1 - pad - x_ofs) * (int32_t)(view_num - 1) / w;
+		int32_t last = ((int32_t)mask->x2 + pad - x_ofs) * (int32_t)(view_num - 1) / w + 1;
+		if(first < 1) first = 1;
+		if(last > (int32_t)view_num - 1) last = view_num - 1;
+
+		point_t p1;
+		point_t p2;
+		uint32_t p_i = (view_start + first - 1 + p_ofs) % dl->num;
+		p2.x = (w * (first - 1)) / (int32_t)(view_num - 1) + x_ofs;
+		p2.y = lv_chart_get_y(chart, dl->points[p_i]);
+
+		int32_t i;
+		for(i = first; i <= last; i++) {
+			p1 = p2;
+			p_i++;
+			if(p_i >= dl->num) p_i = 0;
+			p2.x = (w * i) / (int32_t)(view_num - 1) + x_ofs;
+			p2.y = lv_chart_get_y(chart, dl->points[p_i]);
+			lv_draw_line(&p1, &p2, mask, &lines, opa);
+		}
+		return;
+	}
+
+	lv_rects_t rects;
+	lv_rects_get(LV_RECTS_DEF, &rects);
+	rects.bwidth = 0;
+	rects.empty = 0;
+	rects.round = 0;
+	rects.objs.color = color;
+	rects.gcolor = color;
+
+	cord_t half = style_p->width / 2;
+	cord_t x = MATH_MAX(mask->x1, chart->cords.x1);
+	x -= (x - chart->cords.x1) % LV_DOWNSCALE;	/*Start from a whole display pixel*/
+	cord_t x_end = MATH_MIN(mask->x2, chart->cords.x2);
+	area_t col_a;
+
+	for(; x <= x_end; x += LV_DOWNSCALE) {
+		/* The points of a column. The first point of the next column is included
+		 * to connect the columns.*/
+		uint32_t a = ((uint64_t)(x - x_ofs) * (view_num - 1)) / w;
+		uint32_t b = ((uint64_t)(x - x_ofs + LV_DOWNSCALE) * (view_num - 1)) / w;
+		if(b > view_num - 1) b = view_num - 1;
+		a = (a + view_start + p_ofs) % dl->num;
+		b = (b + view_start + p_ofs) % dl->num;
+
+		cord_t min;
+		cord_t max;
+		if(a <= b) {
+			lv_chart_lod_minmax(dl, a, b, &min, &max);
+		} else {
+			/*The column is on the end and the start of the ring buffer*/
+			cord_t min2;
+			cord_t max2;
+			lv_chart_lod_minmax(dl, a, dl->num - 1, &min, &max);
+			lv_chart_lod_minmax(dl, 0, b, &min2, &max2);
+			min = MATH_MIN(min, min2);
+			max = MATH_MAX(max, max2);
+		}
+
+		col_a.x1 = x;
+		col_a.x2 = x + LV_DOWNSCALE - 1;
+		col_a.y1 = lv_chart_get_y(chart, max) - half;
+		col_a.y2 = lv_chart_get_y(chart, min) + half;
+		lv_draw_rect(&col_a, mask, &rects, opa);
+	}
+}
+
+/**
+ * Update the min/max pyramid of a data line
+ * @param dl pointer to a data line with min/max pyramid
+ * @param first index of the first changed point
+ * @param last index of the last changed point
+ */
+static void lv_chart_lod_update(lv_chart_dl_t * dl, uint32_t first, uint32_t last)
+{
+	const cord_t * src = dl->points;	/*The level below (the points for the first level)*/
+	uint32_t src_num = dl->num;
+	cord_t * lvl = dl->lod;
+	uint8_t l;
+
+	for(l = 0; l < dl->lod_lvl; l++) {
+		uint32_t n = (src_num + LV_CHART_LOD_N - 1) >> LV_CHART_LOD_SHIFT;
+		first = first >> LV_CHART_LOD_SHIFT;
+		last = last >> LV_CHART_LOD_SHIFT;
+
+		uint32_t b;
+		for(b = first; b <= last; b++) {
+			uint32_t i = b << LV_CHART_LOD_SHIFT;
+			uint32_t e = MATH_MIN(i + LV_CHART_LOD_N, src_num);
+			cord_t min;
+			cord_t max;
+			if(l == 0) {
+				min = src[i];
+				max = src[i];
+				for(i++; i < e; i++) {
+					if(src[i] < min) min = src[i];
+					if(src[i] > max) max = src[i];
+				}
+			} else {
+				min = src[2 * i];
+				max = src[2 * i + 1];
+				for(i++; i < e; i++) {
+					if(src[2 * i] < min) min = src[2 * i];
+					if(src[2 * i + 1] > max) max = src[2 * i + 1];
+				}
+			}
+			lvl[2 * b] = min;
+			lvl[2 * b + 1] = max;
+		}
+
+		src = lvl;
+		src_num = n;
+		lvl += 2 * n;
+	}
+}
+
+/**
+ * Get the min. and max. of a range of points using the min/max pyramid.
+ * The not aligned ends are taken from the lower levels, the middle from the highest possible level.
+ * @param dl pointer to a data line with min/max pyramid
+ * @param a index of the first point
+ * @param b index of the last point (>= 'a')
+ * @param min_p store the minimum here
+ * @param max_p store the maximum here
+ */
+static void lv_chart_lod_minmax(const lv_chart_dl_t * dl, uint32_t a, uint32_t b, cord_t * min_p, cord_t * max_p)
+{
+	const cord_t * lvl = dl->points;
+	uint32_t n = dl->num;
+	cord_t min = dl->points[a];
+	cord_t max = min;
+	uint8_t l = 0;
+
+	while(1) {
+		uint32_t i;
+		/*Scan the rest on this level if it's short or there are no more levels*/
+		if(l == dl->lod_lvl || b - a < 2 * LV_CHART_LOD_N) {
+			for(i = a; i <= b; i++) {
+				cord_t v_min = l == 0 ? lvl[i] : lvl[2 * i];
+				cord_t v_max = l == 0 ? lvl[i] : lvl[2 * i + 1];
+				if(v_min < min) min = v_min;
+				if(v_max > max) max = v_max;
+			}
+			break;
+		}
+
+		/*Scan the not aligned ends and go to the next level*/
+		while((a & (LV_CHART_LOD_N - 1)) != 0) {
+			cord_t v_min = l == 0 ? lvl[a] : lvl[2 * a];
+			cord_t v_max = l == 0 ? lvl[a] : lvl[2 * a + 1];
+			if(v_min < min) min = v_min;
+			if(v_max > max) max = v_max;
+			a++;
+		}
+		while(((b + 1) & (LV_CHART_LOD_N - 1)) != 0) {
+			cord_t v_min = l == 0 ? lvl[b] : lvl[2 * b];
+			cord_t v_max = l == 0 ? lvl[b] : lvl[2 * b + 1];
+			if(v_min < min) min = v_min;
+			if(v_max > max) max = v_max;
+			b--;
+		}
+
+		if(l == 0) lvl = dl->lod;
+		else lvl += 2 * n;
+		n = (n + LV_CHART_LOD_N - 1) >> LV_CHART_LOD_SHIFT;
+		a = a >> LV_CHART_LOD_SHIFT;
+		b = ((b + 1) >> LV_CHART_LOD_SHIFT) - 1;
+		l++;
+	}
+
+	*min_p = min;
+	*max_p = max;
+}
+
+/**
+ * Get the y coordinate of a value on a chart
+ * @param chart pointer to chart object
+ * @param v a value
+ * @return the absolute y coordinate of 'v'
+ */
+static cord_t lv_chart_get_y(lv_obj_t * chart, int32_t v)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	int32_t h = lv_obj_get_height(chart);
+	int32_t y_tmp = (v - ext->ymin) * h;
+	y_tmp = y_tmp / (ext->ymax - ext->ymin);
+
+	return h - y_tmp + chart->cords.y1;
+}
+
+/**
+ * Get the range of point positions which can be drawn on a mask
+ * @param chart pointer to chart object
+ * @param mask the drawn area
+ * @param pad the points are drawn at most this far from their x coordinate
+ * @param div the width of the chart is divided into this many parts between the points
+ * @param first store the first position here
+ * @param last store the last position here (smaller then 'first' if nothing is on the mask)
+ */
+static void lv_chart_get_vis_range(lv_obj_t * chart, const area_t * mask, cord_t pad, uint16_t div,
+                                   uint16_t * first, uint16_t * last)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	int32_t w = lv_obj_get_width(chart);
+	int32_t x1 = (int32_t)mask->x1 - pad - chart->cords.x1;
+	int32_t x2 = (int32_t)mask->x2 + pad - chart->cords.x1;
+
+	*first = 1;
+	*last = 0;
+	if(x2 < 0) return;
+
+	x1 = x1 > 0 ? (x1 * div) / w : 0;
+	x2 = (x2 * div) / w + 1;
+	if(x2 > ext->pnum - 1) x2 = ext->pnum - 1;
+
+	*first = x1;
+	*last = x2;
+}
+
+/**
+ * Get the descriptor of a data line
+ * @param chart pointer to chart object
+ * @param points pointer to the points of a data line (return value of 'lv_chart_add_dataline')
+ * @return pointer to the descriptor or NULL if 'points' is not on 'chart'
+ */
+static lv_chart_dl_t * lv_chart_get_dl(lv_obj_t * chart, cord_t * points)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	lv_chart_dl_t * dl;
+
+	LL_READ(ext->dl_ll, dl) {
+		if(dl->points == points) return dl;
+	}
+
+	return NULL;
+}
+
+/**
+ * Get a point of a data line
+ * @param dl pointer to a data line
+ * @param i index of the point in the buffer
+ * @return the value of the point limited to the range of 'cord_t'
+ */
+static int32_t lv_chart_dl_get(const lv_chart_dl_t * dl, uint32_t i)
+{
+	if(dl->ext_buf == 0) return dl->points[i];
+
+	/*Copy the value because the buffer of the application might be not aligned*/
+	const uint8_t * p = (const uint8_t *)dl->points + i * dl->stride;
+	int32_t v;
+	switch(dl->data_type) {
+		case LV_CHART_DATA_INT16: {
+			int16_t tmp;
+			memcpy(&tmp, p, sizeof(tmp));
+			v = tmp;
+			break;
+		}
+		case LV_CHART_DATA_INT32:
+			memcpy(&v, p, sizeof(v));
+			break;
+		case LV_CHART_DATA_FLOAT: {
+			float tmp;
+			memcpy(&tmp, p, sizeof(tmp));
+			if(tmp >= LV_CORD_MIN && tmp <= LV_CORD_MAX) v = (int32_t)tmp;
+			else v = tmp > 0 ? LV_CORD_MAX : LV_CORD_MIN;	/*NaN goes to the minimum*/
+			break;
+		}
+		default: {
+			cord_t tmp;
+			memcpy(&tmp, p, sizeof(tmp));
+			v = tmp;
+			break;
+		}
+	}
+
+	if(v > LV_CORD_MAX) v = LV_CORD_MAX;
+	else if(v < LV_CORD_MIN) v = LV_CORD_MIN;
+
+	return v;
+}
+
+/**
+ * Set a point of a data line
+ * @param dl pointer to a data line
+ * @param i index of the point in the buffer
+ * @param y the new value
+ */
+static void lv_chart_dl_set(lv_chart_dl_t * dl, uint32_t i, cord_t y)
+{
+	if(dl->ext_buf == 0) {
+		dl->points[i] = y;
+		return;
+	}
+
+	uint8_t * p = (uint8_t *)dl->points + i * dl->stride;
+	switch(dl->data_type) {
+		case LV_CHART_DATA_INT16: {
+			int16_t tmp = y;
+			memcpy(p, &tmp, sizeof(tmp));
+			break;
+		}
+		case LV_CHART_DATA_INT32: {
+			int32_t tmp = y;
+			memcpy(p, &tmp, sizeof(tmp));
+			break;
+		}
+		case LV_CHART_DATA_FLOAT: {
+			float tmp = y;
+			memcpy(p, &tmp, sizeof(tmp));
+			break;
+		}
+		default:
+			memcpy(p, &y, sizeof(y));
+			break;
+	}
+}
+
+/**
+ * Check if every data line of a chart is in an array
+ * @param chart pointer to chart object
+ * @param dl array of data lines
+ * @param dl_num number of data lines in 'dl'
+ * @return true: every data line of 'chart' is in 'dl'
+ */
+static bool lv_chart_has_all_dl(lv_obj_t * chart, cord_t ** dl, uint8_t dl_num)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	lv_chart_dl_t * dl_p;
+	uint8_t d;
+
+	LL_READ(ext->dl_ll, dl_p) {
+		for(d = 0; d < dl_num; d++) {
+			if(dl[d] == dl_p->points) break;
+		}
+		if(d == dl_num) return false;
+	}
+
+	return true;
+}
+
+/**
+ * Rotate the points of a data line in place to make 'start' the first
+ * @param points pointer to the points
+ * @param pnum number of points
+ * @param start index of the new first point
+ */
+static void lv_chart_dl_rotate(cord_t * points, uint16_t pnum, uint16_t start)
+{
+	if(start == 0) return;
+
+	/*Reverse the two parts and then the whole array*/
+	uint16_t part[3][2] = {{0, start - 1}, {start, pnum - 1}, {0, pnum - 1}};
+	uint8_t p;
+	for(p = 0; p < 3; p++) {
+		uint16_t i = part[p][0];
+		uint16_t j = part[p][1];
+		while(i < j) {
+			cord_t tmp = points[i];
+			points[i] = points[j];
+			points[j] = tmp;
+			i++;
+			j--;
+		}
+	}
+}
+
+/**
+ * Invalidate the columns of a chart where some points and their lines are drawn
+ * @param chart pointer to chart object
+ * @param first position of the first point (0: most left)
+ * @param num number of points from 'first' (continued from the left after the most right)
+ */
+static void lv_chart_inv_points(lv_obj_t * chart, uint16_t first, uint16_t num)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	lv_charts_t * style_p = lv_obj_get_style(chart);
+
+	if(ext->pnum < 2 || num >= ext->pnum) {
+		lv_chart_refr(chart);
+		return;
+	}
+
+	if(num == 0) return;
+
+	/*Invalidate the two parts separately if the points are continued from the left*/
+	uint32_t last = (uint32_t)first + num - 1;
+	if(last >= ext->pnum) {
+		lv_chart_inv_points(chart, 0, last - ext->pnum + 1);
+		last = ext->pnum - 1;
+	}
+
+	lv_obj_refr_cords(chart);
+	int32_t w = lv_obj_get_width(chart);
+	area_t inv;
+	area_cpy(&inv, &chart->cords);
+
+	if(ext->type == LV_CHART_COL) {
+		cord_t slot_w = w / ext->pnum;
+		inv.x1 = chart->cords.x1 + (w * first) / ext->pnum;
+		inv.x2 = chart->cords.x1 + (w * (last + 1)) / ext->pnum + slot_w + 1;
+	} else {
+		/*The lines to the previous and to the next points are changed*/
+		uint16_t prev = first > 0 ? first - 1 : 0;
+		uint16_t next = last < ext->pnum - 1 ? last + 1 : last;
+		inv.x1 = chart->cords.x1 + (w * prev) / (ext->pnum - 1) - style_p->width - 1;
+		inv.x2 = chart->cords.x1 + (w * next) / (ext->pnum - 1) + style_p->width + 1;
+	}
+
+	lv_obj_inv_area(chart, &inv);
+}
+
+/**
+ * Refresh a chart after every point of every data line is shifted left.
+ * Move the drawn points if possible and redraw only the edges and the division lines.
+ * @param chart pointer to chart object
+ * @param num number of positions the points are shifted with
+ */
+static void lv_chart_inv_shift(lv_obj_t * chart, uint16_t num)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext(chart);
+	lv_charts_t * style_p = lv_obj_get_style(chart);
+
+	lv_obj_refr_cords(chart);
+	cord_t w = lv_obj_get_width(chart);
+
+	/* The drawn points can be moved only if it's enabled and the distance
+	 * of the points is a whole number of pixels*/
+	uint16_t div = ext->type == LV_CHART_COL ? ext->pnum : ext->pnum - 1;
+	if(chart->move_copy == 0 || div == 0 || (w % div) != 0 || num >= div) {
+		lv_chart_refr(chart);
+		return;
+	}
+	cord_t step = (w / div) * num;
+
+	/*Move only where the background is the same in every column (no border and rounded corners)*/
+	area_t area;
+	area_cpy(&area, &chart->cords);
+	cord_t edge = MATH_MAX(style_p->bg_rects.bwidth, style_p->bg_rects.round);
+	if(edge > w / 4) {
+		lv_chart_refr(chart);
+		return;
+	}
+	area.x1 += edge;
+	area.x2 -= edge;
+
+	if(lv_obj_move_content(chart, &area, -step, 0) == false) {
+		lv_chart_refr(chart);
+		return;
+	}
+
+	/*The vertical division lines have to remain at their place*/
+	area_t inv;
+	area_cpy(&inv, &chart->cords);
+	cord_t div_w = style_p->div_lines.width + 1;
+	uint8_t div_i;
+	if(style_p->div_lines.objs.transp == 0) {
+		for(div_i = 1; div_i <= ext->vdiv_num; div_i ++) {
+			cord_t x = (int32_t)((int32_t)w * div_i) / (ext->vdiv_num + 1) + chart->cords.x1;
+			inv.x1 = x - step - div_w;
+			inv.x2 = x - step + div_w;
+			lv_obj_inv_area(chart, &inv);
+			inv.x1 = x - div_w;
+			inv.x2 = x + div_w;
+			lv_obj_inv_area(chart, &inv);
+		}
+	}
+
+	/*The removed oldest points might be visible on the left and the newest points are drawn on the right*/
+	cord_t pad = ext->type == LV_CHART_COL ? step : style_p->width + 1;
+	inv.x1 = chart->cords.x1;
+	inv.x2 = area.x1 + pad;
+	lv_obj_inv_area(chart, &inv);
+
+	inv.x1 = area.x2 - step - pad;
+	inv.x2 = chart->cords.x2;
+	lv_obj_inv_area(chart, &inv);
+}
+
 /**
  * Initialize the chart styles
  */
@@ -33,6 +33,20 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*A data line of a chart*/
+typedef struct
+{
+    cord_t * points;      /*The points in a ring buffer*/
+    uint32_t start;       /*Index of the oldest point (the next 'lv_chart_set_next' overwrites it)*/
+    cord_t * lod;         /*Min/max pyramid of the points or NULL (short lines have no levels)*/
+    uint32_t num;         /*Number of points if 'lod_en' is set, size of the buffer if 'ext_buf' is set*/
+    uint8_t lod_lvl;      /*Number of levels in 'lod'*/
+    uint16_t stride;      /*Distance of the points in bytes*/
+    uint8_t data_type :2; /*Type of the points (from 'lv_chart_data_t')*/
+    uint8_t ext_buf   :1; /*1: 'points' is a buffer of the application (see 'lv_chart_add_dataline_ext')*/
+    uint8_t lod_en    :1; /*1: the data line has its own point number and pyramid (see 'lv_chart_add_dataline_lod')*/
+}lv_chart_dl_t;
+
 /*Data of chart background*/
 typedef struct
 {
@@ -42,9 +56,12 @@ typedef struct
     cord_t ymax;
     uint8_t hdiv_num;     /*Number of horizontal division lines*/
     uint8_t vdiv_num;     /*Number of vertical division lines*/
-    ll_dsc_t dl_ll;       /*Linked list for the data line pointers (stores cord_t * )*/
+    ll_dsc_t dl_ll;       /*Linked list for the data lines (stores lv_chart_dl_t)*/
     uint16_t pnum;        /*Point number in a data line*/
+    uint32_t view_start;  /*First shown point of the data lines with min/max pyramid*/
+    uint32_t view_num;    /*Number of shown points of them (0: all)*/
     uint8_t type    :2;   /*Line, column or point chart (from 'lv_chart_type_t')*/
+    uint8_t mode    :1;   /*Shift or sweep the points (from 'lv_chart_mode_t')*/
     uint8_t dl_num;       /*Data line number in dl_ll*/
 }lv_chart_ext_t;
 
@@ -56,6 +73,22 @@ typedef enum
 	LV_CHART_POINT,
 }lv_chart_type_t;
 
+/*How 'lv_chart_set_next' adds the new points*/
+typedef enum
+{
+	LV_CHART_MODE_SHIFT,	/*Add the new point to the right and shift the others to the left*/
+	LV_CHART_MODE_SWEEP,	/*Overwrite the oldest point. The points don't move, only the changed columns are redrawn.*/
+}lv_chart_mode_t;
+
+/*Type of the points in an external buffer of a data line*/
+typedef enum
+{
+	LV_CHART_DATA_CORD,		/*cord_t*/
+	LV_CHART_DATA_INT16,	/*int16_t*/
+	LV_CHART_DATA_INT32,	/*int32_t*/
+	LV_CHART_DATA_FLOAT,	/*float*/
+}lv_chart_data_t;
+
 /*Style of chart background*/
 typedef struct
 {
@@ -99,10 +132,48 @@ bool lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param);
 /**
  * Allocate and add a data line to the chart
  * @param chart pointer to a chart object
- * @return pointer to the allocated data lie (an array for the data points)
+ * @return pointer to the allocated data lie (an array for the data points).
+ *         The points are stored in a ring buffer from the index 'lv_chart_get_start'.
  */
 cord_t * lv_chart_add_dataline(lv_obj_t * chart);
 
+/**
+ * Allocate and add a data line with many points (even much more than the width of the chart).
+ * It is drawn from a min/max pyramid of its points so the drawing time depends only on the width.
+ * It is drawn as a line independently from the type of the chart.
+ * @param chart pointer to a chart object
+ * @param pnum number of points of the data line
+ * @return pointer to the allocated data line (an array for the data points) or NULL if out of memory.
+ *         Call 'lv_chart_refr_points' after the points are changed directly.
+ */
+cord_t * lv_chart_add_dataline_lod(lv_obj_t * chart, uint32_t pnum);
+
+/**
+ * Add a data line which reads its points directly from a buffer of the application (no copy).
+ * The buffer is used as a ring buffer of 'pnum' points (see 'lv_chart_set_pnum') from 'lv_chart_get_start'.
+ * The values out of the range of 'cord_t' are limited.
+ * @param chart pointer to a chart object
+ * @param buf pointer to the first point. It has to be valid while the data line exists.
+ * @param buf_pnum number of points in 'buf'. It can't be less than 'lv_chart_get_pnum'
+ *                 and 'lv_chart_set_pnum' can't set more points later.
+ * @param type type of the points (from 'lv_chart_data_t')
+ * @param stride distance of the points in bytes (e.g. to use a field of an array of structures)
+ *               0: size of 'type'
+ * @return 'buf' as a data line of 'chart' (to use with the other functions) or NULL if
+ *         'buf_pnum' is too small or out of memory.
+ *         Call 'lv_chart_shift' after new points are written to the buffer directly.
+ */
+cord_t * lv_chart_add_dataline_ext(lv_obj_t * chart, void * buf, uint32_t buf_pnum, lv_chart_data_t type, uint16_t stride);
+
+/**
+ * Update the min/max pyramid of a data line after its points are changed directly and redraw the chart
+ * @param chart pointer to a chart object
+ * @param dl pointer to a data line on 'chart' (a return value of 'lv_chart_add_dataline_lod')
+ * @param first index of the first changed point
+ * @param num number of changed points
+ */
+void lv_chart_refr_points(lv_obj_t * chart, cord_t * dl, uint32_t first, uint32_t num);
+
 /**
  * Refresh a chart if its data line has changed
  * @param chart pointer to chart object
@@ -138,17 +209,59 @@ void lv_chart_set_type(lv_obj_t * chart, lv_chart_type_t type);
  * Set the number of points on a data line on a chart
  * @param chart pointer r to chart object
  * @param pnum new number of points on the data lines
+ *             (limited to the size of the buffers of 'lv_chart_add_dataline_ext')
  */
 void lv_chart_set_pnum(lv_obj_t * chart, uint16_t pnum);
 
 /**
- * Shift all data right and set the most right data on a data line
+ * Set how 'lv_chart_set_next' adds the new points
+ * @param chart pointer to a chart object
+ * @param mode LV_CHART_MODE_SHIFT or LV_CHART_MODE_SWEEP
+ */
+void lv_chart_set_mode(lv_obj_t * chart, lv_chart_mode_t mode);
+
+/**
+ * Show only a part of the data lines with min/max pyramid (to zoom and pan them)
+ * @param chart pointer to a chart object
+ * @param start index of the first shown point (from the oldest one)
+ * @param num number of shown points (0: all)
+ */
+void lv_chart_set_view(lv_obj_t * chart, uint32_t start, uint32_t num);
+
+/**
+ * Add a new point to a data line. The oldest point is overwritten (no data is moved in the memory).
+ * In LV_CHART_MODE_SHIFT the new point is the most right and the others are shifted left
+ * (the drawn points are moved if enabled with 'lv_obj_set_move_copy').
+ * In LV_CHART_MODE_SWEEP only the columns of the overwritten point are redrawn.
  * @param chart pointer to chart object
  * @param dl pointer to a data line on 'chart'
- * @param y the new value of the most right data
+ * @param y the new value
  */
 void lv_chart_set_next(lv_obj_t * chart, cord_t * dl, cord_t y);
 
+/**
+ * Add more new points to more data lines at once. The chart is refreshed only once.
+ * If all data lines of the chart are given their drawn points are moved in LV_CHART_MODE_SHIFT
+ * (see 'lv_chart_set_next').
+ * @param chart pointer to chart object
+ * @param dl array of data lines on 'chart'
+ * @param dl_num number of data lines in 'dl'
+ * @param y the new values after each other for every data line:
+ *          y[0]: 1st point of dl[0], y[1]: 1st point of dl[1], ... y[dl_num]: 2nd point of dl[0] ...
+ * @param num number of new points per data line
+ */
+void lv_chart_set_next_array(lv_obj_t * chart, cord_t ** dl, uint8_t dl_num, const cord_t * y, uint16_t num);
+
+/**
+ * Add the points to data lines which are already written after the newest ones
+ * (from 'lv_chart_get_start' in the ring buffer). Used mainly with external buffers.
+ * @param chart pointer to chart object
+ * @param dl array of data lines on 'chart'
+ * @param dl_num number of data lines in 'dl'
+ * @param num number of new points per data line
+ */
+void lv_chart_shift(lv_obj_t * chart, cord_t ** dl, uint8_t dl_num, uint16_t num);
+
 /**
  * Get the type of a chart
  * @param chart pointer to chart object
@@ -163,6 +276,22 @@ lv_chart_type_t lv_chart_get_type(lv_obj_t * chart);
  */
 uint16_t lv_chart_get_pnum(lv_obj_t * chart);
 
+/**
+ * Get how 'lv_chart_set_next' adds the new points
+ * @param chart pointer to chart object
+ * @return LV_CHART_MODE_SHIFT or LV_CHART_MODE_SWEEP
+ */
+lv_chart_mode_t lv_chart_get_mode(lv_obj_t * chart);
+
+/**
+ * Get the index of the oldest point of a data line. In LV_CHART_MODE_SHIFT it is drawn
+ * as the most left point, in LV_CHART_MODE_SWEEP it is the next to overwrite.
+ * @param chart pointer to chart object
+ * @param dl pointer to a data line on 'chart'
+ * @return index of the oldest point in 'dl'
+ */
+uint32_t lv_chart_get_start(lv_obj_t * chart, cord_t * dl);
+
 /**
  * Return with a pointer to a built-in style and/or copy it to a variable
  * @param style a style name from lv_charts_builtin_t enum
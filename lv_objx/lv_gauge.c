@@ -14,6 +14,8 @@
 #include <stdio.h>
 #include <string.h>
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_vbasic.h"
+#include "../lv_obj/lv_refr.h"
 #include "../lv_misc/text.h"
 #include "misc/math/trigo.h"
 #include "misc/math/math_base.h"
@@ -24,6 +26,13 @@
 #define LV_GAUGE_DEF_WIDTH  (150 * LV_DOWNSCALE)
 #define LV_GAUGE_DEF_HEIGHT  (150 * LV_DOWNSCALE)
 
+/*Test configurations*/
+#ifndef LV_GAUGE_CACHE_SIZE
+#define LV_GAUGE_CACHE_SIZE (256 * 1024)
+#endif
+
+#define LV_GAUGE_CACHE_EN   (LV_GAUGE_CACHE_SIZE != 0 && LV_VDB_SIZE != 0)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -32,8 +41,20 @@
  *  STATIC PROTOTYPES
  **********************/
 static bool lv_gauge_design(lv_obj_t * gauge, const area_t * mask, lv_design_mode_t mode);
+static bool lv_gauge_draw_dial_cache(lv_obj_t * gauge, const area_t * mask, color_t mcolor, color_t gcolor);
+static void lv_gauge_draw_dial(lv_obj_t * gauge, const area_t * mask, color_t mcolor, color_t gcolor);
+#if LV_GAUGE_CACHE_EN != 0
+static bool lv_gauge_design_dial(lv_obj_t * gauge, const area_t * mask, lv_design_mode_t mode);
+#endif
+static void lv_gauge_free_dial(lv_obj_t * gauge);
 static void lv_gauge_draw_scale(lv_obj_t * gauge, const area_t * mask);
+static void lv_gauge_draw_value(lv_obj_t * gauge, const area_t * mask);
 static void lv_gauge_draw_needle(lv_obj_t * gauge, const area_t * mask);
+static int16_t lv_gauge_get_critical(lv_obj_t * gauge);
+static void lv_gauge_get_bg_color(lv_obj_t * gauge, color_t * mcolor, color_t * gcolor);
+static void lv_gauge_get_needle_end(lv_obj_t * gauge, int16_t value, point_t * p_end);
+static void lv_gauge_get_value_area(lv_obj_t * gauge, int16_t value, area_t * area_p);
+static void lv_gauge_inv_needle(lv_obj_t * gauge, int16_t value);
 static void lv_gauges_init(void);
 
 /**********************
@@ -41,6 +62,9 @@ static void lv_gauges_init(void);
  **********************/
 static lv_gauges_t lv_gauges_def;	/*Default gauge style*/
 static lv_design_f_t ancestor_design_f = NULL;
+#if LV_GAUGE_CACHE_EN != 0
+static uint32_t dial_mem;           /*Memory used by the cached dials of all gauges [bytes]*/
+#endif
 /**********************
  *      MACROS
  **********************/
@@ -76,6 +100,11 @@ lv_obj_t * lv_gauge_create(lv_obj_t * par, lv_obj_t * copy)
     ext->low_critical = 0;
     ext->values = NULL;
     ext->txt = NULL;
+    ext->dial_buf = NULL;
+    ext->dial_w = 0;
+    ext->dial_h = 0;
+    ext->dial_valid = 0;
+    ext->dial_fail = 0;
 
     if(ancestor_design_f == NULL) ancestor_design_f = lv_obj_get_design_f(new_gauge);
 
@@ -133,7 +162,11 @@ bool lv_gauge_signal(lv_obj_t * gauge, lv_signal_t sign, void * param)
     		case LV_SIGNAL_CLEANUP:
     		    dm_free(ext->values);
     		    ext->values = NULL;
+    		    lv_gauge_free_dial(gauge);
     			break;
+    		case LV_SIGNAL_STYLE_CHG:
+    		    ext->dial_valid = 0;
+    		    break;
     		default:
     			break;
     	}
@@ -158,6 +191,9 @@ void lv_gauge_set_needle_num(lv_obj_t * gauge, uint8_t num)
 
     ext->values = dm_alloc(num * sizeof(int16_t));
 
+    uint8_t i;
+    for(i = 0; i < num; i++) ext->values[i] = ext->min;
+
     ext->needle_num = num;
     lv_obj_inv(gauge);
 }
@@ -176,11 +212,14 @@ void lv_gauge_set_range(lv_obj_t * gauge, int16_t min, int16_t max)
     ext->min = MATH_MIN(min, max);
     ext->max = MATH_MAX(min, max);
 
+    ext->dial_valid = 0;    /*The scale labels are changed*/
     lv_obj_inv(gauge);
 }
 
 /**
- * Set the value of a needle
+ * Set the value of a needle.
+ * Only the old and new place of the needle and the value text are redrawn
+ * if the background color is not changed by the critical value.
  * @param gauge pointer to gauge
  * @param needle the id of the needle
  * @param value the new value
@@ -194,9 +233,38 @@ void lv_gauge_set_value(lv_obj_t * gauge, uint8_t needle, int16_t value)
     if(value > ext->max) value = ext->max;
     if(value < ext->min) value = ext->min;
 
+    int16_t old_value = ext->values[needle];
+    if(old_value == value) return;
+
+    int16_t old_critical = lv_gauge_get_critical(gauge);
+    color_t old_mcolor;
+    color_t old_gcolor;
+    lv_gauge_get_bg_color(gauge, &old_mcolor, &old_gcolor);
+
     ext->values[needle] = value;
 
-    lv_obj_inv(gauge);
+    int16_t critical = lv_gauge_get_critical(gauge);
+    color_t mcolor;
+    color_t gcolor;
+    lv_gauge_get_bg_color(gauge, &mcolor, &gcolor);
+
+    /*Redraw everything if the background is re-colored*/
+    if(mcolor.full != old_mcolor.full || gcolor.full != old_gcolor.full) {
+        lv_obj_inv(gauge);
+        return;
+    }
+
+    lv_obj_refr_cords(gauge);
+    lv_gauge_inv_needle(gauge, old_value);
+    lv_gauge_inv_needle(gauge, value);
+
+    if(critical != old_critical && ext->txt[0] != '\0') {
+        area_t value_a;
+        lv_gauge_get_value_area(gauge, old_critical, &value_a);
+        lv_obj_inv_area(gauge, &value_a);
+        lv_gauge_get_value_area(gauge, critical, &value_a);
+        lv_obj_inv_area(gauge, &value_a);
+    }
 }
 
 /**
@@ -342,32 +410,15 @@ static bool lv_gauge_design(lv_obj_t * gauge, const area_t * mask, lv_design_mod
     }
     /*Draw the object*/
     else if(mode == LV_DESIGN_DRAW_MAIN) {
-        lv_gauges_t * style = lv_obj_get_style(gauge);
-        lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
-
-        /* Draw the background
-         * Re-color the gauge according to the critical value*/
-        color_t mcolor_min = style->rects.objs.color;
-        color_t gcolor_min = style->rects.gcolor;
-
-        int16_t critical_val = ext->low_critical == 0 ? ext->min : ext->max;
-        uint8_t i;
-
-        for(i = 0; i < ext->needle_num; i++) {
-            critical_val = ext->low_critical == 0 ? MATH_MAX(critical_val, ext->values[i]) : MATH_MIN(critical_val, ext->values[i]);
+        /*Draw the background and the scale (from the cache if possible)*/
+        color_t mcolor;
+        color_t gcolor;
+        lv_gauge_get_bg_color(gauge, &mcolor, &gcolor);
+        if(lv_gauge_draw_dial_cache(gauge, mask, mcolor, gcolor) == false) {
+            lv_gauge_draw_dial(gauge, mask, mcolor, gcolor);
         }
 
-        opa_t ratio = ((critical_val - ext->min) * OPA_COVER) / (ext->max - ext->min);
-
-        if(ext->low_critical != 0) ratio = OPA_COVER - ratio;
-
-        style->rects.objs.color= color_mix(style->mcolor_critical, mcolor_min, ratio);
-        style->rects.gcolor = color_mix(style->gcolor_critical, gcolor_min, ratio);
-        ancestor_design_f(gauge, mask, mode);
-        style->rects.objs.color= mcolor_min;
-        style->rects.gcolor = gcolor_min;
-
-        lv_gauge_draw_scale(gauge, mask);
+        lv_gauge_draw_value(gauge, mask);
 
         lv_gauge_draw_needle(gauge, mask);
     }
@@ -379,6 +430,129 @@ static bool lv_gauge_design(lv_obj_t * gauge, const area_t * mask, lv_design_mod
     return true;
 }
 
+/**
+ * Draw the dial of a gauge from its cached snapshot. Render the snapshot first if it's invalid.
+ * @param gauge pointer to gauge object
+ * @param mask mask of drawing
+ * @param mcolor top color of the background
+ * @param gcolor bottom color of the background
+ * @return true: the dial is drawn, false: the cache can't be used (draw the dial normally)
+ */
+static bool lv_gauge_draw_dial_cache(lv_obj_t * gauge, const area_t * mask, color_t mcolor, color_t gcolor)
+{
+#if LV_GAUGE_CACHE_EN != 0
+    lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
+
+    /*The snapshot has no background so only an opaque gauge can be drawn from it*/
+    if(lv_obj_get_opa(gauge) != OPA_COVER || gauge->ext_size != 0) return false;
+
+    area_t dial_a;
+    lv_obj_get_cords(gauge, &dial_a);
+    cord_t w = area_get_width(&dial_a);
+    cord_t h = area_get_height(&dial_a);
+    if(w <= 0 || h <= 0) return false;
+
+    /*Allocate a new buffer if there is no snapshot or the size is changed.
+     *Don't try it again on every redraw if it failed with this size.*/
+    if(ext->dial_buf == NULL || ext->dial_w != w || ext->dial_h != h) {
+        if(ext->dial_fail != 0 && ext->dial_w == w && ext->dial_h == h) return false;
+
+        lv_gauge_free_dial(gauge);
+        ext->dial_w = w;
+        ext->dial_h = h;
+        ext->dial_valid = 0;
+        ext->dial_fail = 1;
+
+        /*The dials of all gauges share LV_GAUGE_CACHE_SIZE memory*/
+        uint32_t buf_size = (uint32_t)w * h * sizeof(color_t);
+        if(dial_mem + buf_size > LV_GAUGE_CACHE_SIZE) return false;
+        ext->dial_buf = dm_alloc(buf_size);
+        if(ext->dial_buf == NULL) return false;
+
+        dial_mem += buf_size;
+        ext->dial_fail = 0;
+    }
+
+    /*Render the dial again if it's invalid or re-colored*/
+    if(ext->dial_valid == 0 || ext->dial_mcolor.full != mcolor.full || ext->dial_gcolor.full != gcolor.full) {
+        uint32_t px_num = (uint32_t)w * h;
+        color_t transp_color = LV_COLOR_TRANSP;
+        uint32_t px;
+        for(px = 0; px < px_num; px++) ext->dial_buf[px] = transp_color;
+
+        lv_refr_snapshot(gauge, ext->dial_buf, &dial_a, lv_gauge_design_dial);
+
+        ext->dial_mcolor = mcolor;
+        ext->dial_gcolor = gcolor;
+        ext->dial_valid = 1;
+    }
+
+    lv_vmap(&dial_a, mask, ext->dial_buf, OPA_COVER, true, false, COLOR_BLACK, OPA_TRANSP);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if LV_GAUGE_CACHE_EN != 0
+/**
+ * Design function to render only the dial of a gauge into its snapshot (see 'lv_refr_snapshot')
+ * @param gauge pointer to gauge object
+ * @param mask mask of drawing
+ * @param mode only LV_DESIGN_DRAW_MAIN is used
+ * @return always true
+ */
+static bool lv_gauge_design_dial(lv_obj_t * gauge, const area_t * mask, lv_design_mode_t mode)
+{
+    color_t mcolor;
+    color_t gcolor;
+    lv_gauge_get_bg_color(gauge, &mcolor, &gcolor);
+    lv_gauge_draw_dial(gauge, mask, mcolor, gcolor);
+
+    return true;
+}
+#endif
+
+/**
+ * Free the cached dial of a gauge and give back its memory to the other gauges
+ * @param gauge pointer to gauge object
+ */
+static void lv_gauge_free_dial(lv_obj_t * gauge)
+{
+#if LV_GAUGE_CACHE_EN != 0
+    lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
+    if(ext->dial_buf == NULL) return;
+
+    dm_free(ext->dial_buf);
+    ext->dial_buf = NULL;
+    dial_mem -= (uint32_t)ext->dial_w * ext->dial_h * sizeof(color_t);
+#endif
+}
+
+/**
+ * Draw the background and the scale of a gauge
+ * @param gauge pointer to gauge object
+ * @param mask mask of drawing
+ * @param mcolor top color of the background
+ * @param gcolor bottom color of the background
+ */
+static void lv_gauge_draw_dial(lv_obj_t * gauge, const area_t * mask, color_t mcolor, color_t gcolor)
+{
+    lv_gauges_t * style = lv_obj_get_style(gauge);
+
+    /*Draw the background with the colors re-colored according to the critical value*/
+    color_t mcolor_min = style->rects.objs.color;
+    color_t gcolor_min = style->rects.gcolor;
+    style->rects.objs.color = mcolor;
+    style->rects.gcolor = gcolor;
+    ancestor_design_f(gauge, mask, LV_DESIGN_DRAW_MAIN);
+    style->rects.objs.color = mcolor_min;
+    style->rects.gcolor = gcolor_min;
+
+    lv_gauge_draw_scale(gauge, mask);
+}
+
 /**
  * Draw the scale on a gauge
  * @param gauge pointer to gauge object
@@ -424,36 +598,30 @@ static void lv_gauge_draw_scale(lv_obj_t * gauge, const area_t * mask)
 
         lv_draw_label(&label_cord, mask, &style->scale_labels, OPA_COVER, scale_txt);
     }
+}
 
-    /*Calculate the critical value*/
-    int16_t critical_value = ext->low_critical == 0 ? ext->min : ext->max;;
-    for(i = 0; i < ext->needle_num; i++) {
-        critical_value = ext->low_critical == 0 ?
-                MATH_MAX(critical_value, ext->values[i]) : MATH_MIN(critical_value, ext->values[i]);
-    }
-
-    /*Write the critical value if enabled*/
-    if(ext->txt[0] != '\0') {
-        char value_txt[16];
-        sprintf(value_txt, ext->txt, critical_value);
-
-        area_t label_cord;
-        point_t label_size;
-        txt_get_size(&label_size, value_txt, font_get(style->value_labels.font),
-                style->value_labels.letter_space, style->value_labels.line_space, LV_CORD_MAX);
+/**
+ * Write the critical value on a gauge if enabled
+ * @param gauge pointer to gauge object
+ * @param mask mask of drawing
+ */
+static void lv_gauge_draw_value(lv_obj_t * gauge, const area_t * mask)
+{
+    lv_gauges_t * style = lv_obj_get_style(gauge);
+    lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
 
-        /*Draw the label*/
-        label_cord.x1 = gauge->cords.x1 + lv_obj_get_width(gauge) / 2 - label_size.x / 2;
-        label_cord.y1 = gauge->cords.y1 +
-                        (cord_t)style->value_pos * lv_obj_get_height(gauge) / 100 - label_size.y / 2;
+    if(ext->txt[0] == '\0') return;
 
-        label_cord.x2 = label_cord.x1 + label_size.x;
-        label_cord.y2 = label_cord.y1 + label_size.y;
+    int16_t critical_value = lv_gauge_get_critical(gauge);
+    char value_txt[16];
+    sprintf(value_txt, ext->txt, critical_value);
 
-        lv_draw_label(&label_cord, mask, &style->value_labels, OPA_COVER, value_txt);
-    }
+    area_t label_cord;
+    lv_gauge_get_value_area(gauge, critical_value, &label_cord);
 
+    lv_draw_label(&label_cord, mask, &style->value_labels, OPA_COVER, value_txt);
 }
+
 /**
  * Draw the needles of a gauge
  * @param gauge pointer to gauge object
@@ -464,10 +632,8 @@ static void lv_gauge_draw_needle(lv_obj_t * gauge, const area_t * mask)
     lv_gauges_t * style = lv_obj_get_style(gauge);
     lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
 
-    cord_t r = lv_obj_get_width(gauge) / 2 - style->scale_pad;
     cord_t x_ofs = lv_obj_get_width(gauge) / 2 + gauge->cords.x1;
     cord_t y_ofs = lv_obj_get_height(gauge) / 2 + gauge->cords.y1;
-    int16_t angle_ofs = 90 + (360 - style->scale_angle) / 2;
     point_t p_mid;
     point_t p_end;
     uint8_t i;
@@ -476,10 +642,7 @@ static void lv_gauge_draw_needle(lv_obj_t * gauge, const area_t * mask)
     p_mid.y = y_ofs;
     for(i = 0; i < ext->needle_num; i++) {
         /*Calculate the end point of a needle*/
-        int16_t needle_angle = (ext->values[i] - ext->min) * style->scale_angle /
-                               (ext->max - ext->min) + angle_ofs;
-        p_end.y = (trigo_sin(needle_angle) * r) / TRIGO_SIN_MAX + y_ofs;
-        p_end.x = (trigo_sin(needle_angle + 90) * r) / TRIGO_SIN_MAX + x_ofs;
+        lv_gauge_get_needle_end(gauge, ext->values[i], &p_end);
 
         /*Draw the needle with the corresponding color*/
         style->needle_lines.objs.color = style->needle_color[i];
@@ -506,6 +669,118 @@ static void lv_gauge_draw_needle(lv_obj_t * gauge, const area_t * mask)
 
 }
 
+/**
+ * Get the most critical value of the needles
+ * @param gauge pointer to gauge object
+ * @return the highest value (or the lowest if 'low_critical' is set)
+ */
+static int16_t lv_gauge_get_critical(lv_obj_t * gauge)
+{
+    lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
+
+    int16_t critical_value = ext->low_critical == 0 ? ext->min : ext->max;
+    uint8_t i;
+    for(i = 0; i < ext->needle_num; i++) {
+        critical_value = ext->low_critical == 0 ?
+                MATH_MAX(critical_value, ext->values[i]) : MATH_MIN(critical_value, ext->values[i]);
+    }
+
+    return critical_value;
+}
+
+/**
+ * Get the background colors of a gauge re-colored according to the critical value
+ * @param gauge pointer to gauge object
+ * @param mcolor store the top color here
+ * @param gcolor store the bottom color here
+ */
+static void lv_gauge_get_bg_color(lv_obj_t * gauge, color_t * mcolor, color_t * gcolor)
+{
+    lv_gauges_t * style = lv_obj_get_style(gauge);
+    lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
+
+    int16_t critical_val = lv_gauge_get_critical(gauge);
+    opa_t ratio = ((critical_val - ext->min) * OPA_COVER) / (ext->max - ext->min);
+
+    if(ext->low_critical != 0) ratio = OPA_COVER - ratio;
+
+    *mcolor = color_mix(style->mcolor_critical, style->rects.objs.color, ratio);
+    *gcolor = color_mix(style->gcolor_critical, style->rects.gcolor, ratio);
+}
+
+/**
+ * Get the end point of a needle
+ * @param gauge pointer to gauge object
+ * @param value value of the needle
+ * @param p_end store the end point here
+ */
+static void lv_gauge_get_needle_end(lv_obj_t * gauge, int16_t value, point_t * p_end)
+{
+    lv_gauges_t * style = lv_obj_get_style(gauge);
+    lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
+
+    cord_t r = lv_obj_get_width(gauge) / 2 - style->scale_pad;
+    cord_t x_ofs = lv_obj_get_width(gauge) / 2 + gauge->cords.x1;
+    cord_t y_ofs = lv_obj_get_height(gauge) / 2 + gauge->cords.y1;
+    int16_t angle_ofs = 90 + (360 - style->scale_angle) / 2;
+
+    int16_t needle_angle = (value - ext->min) * style->scale_angle /
+                           (ext->max - ext->min) + angle_ofs;
+    p_end->y = (trigo_sin(needle_angle) * r) / TRIGO_SIN_MAX + y_ofs;
+    p_end->x = (trigo_sin(needle_angle + 90) * r) / TRIGO_SIN_MAX + x_ofs;
+}
+
+/**
+ * Get the area of the value text
+ * @param gauge pointer to gauge object
+ * @param value the written critical value
+ * @param area_p store the area here
+ */
+static void lv_gauge_get_value_area(lv_obj_t * gauge, int16_t value, area_t * area_p)
+{
+    lv_gauges_t * style = lv_obj_get_style(gauge);
+    lv_gauge_ext_t * ext = lv_obj_get_ext(gauge);
+
+    char value_txt[16];
+    sprintf(value_txt, ext->txt, value);
+
+    point_t label_size;
+    txt_get_size(&label_size, value_txt, font_get(style->value_labels.font),
+            style->value_labels.letter_space, style->value_labels.line_space, LV_CORD_MAX);
+
+    area_p->x1 = gauge->cords.x1 + lv_obj_get_width(gauge) / 2 - label_size.x / 2;
+    area_p->y1 = gauge->cords.y1 +
+                 (cord_t)style->value_pos * lv_obj_get_height(gauge) / 100 - label_size.y / 2;
+
+    area_p->x2 = area_p->x1 + label_size.x;
+    area_p->y2 = area_p->y1 + label_size.y;
+}
+
+/**
+ * Invalidate the area of a needle
+ * @param gauge pointer to gauge object
+ * @param value value of the needle
+ */
+static void lv_gauge_inv_needle(lv_obj_t * gauge, int16_t value)
+{
+    lv_gauges_t * style = lv_obj_get_style(gauge);
+
+    point_t p_mid;
+    point_t p_end;
+    p_mid.x = lv_obj_get_width(gauge) / 2 + gauge->cords.x1;
+    p_mid.y = lv_obj_get_height(gauge) / 2 + gauge->cords.y1;
+    lv_gauge_get_needle_end(gauge, value, &p_end);
+
+    cord_t pad = style->needle_lines.width + 1;
+    area_t needle_a;
+    needle_a.x1 = MATH_MIN(p_mid.x, p_end.x) - pad;
+    needle_a.y1 = MATH_MIN(p_mid.y, p_end.y) - pad;
+    needle_a.x2 = MATH_MAX(p_mid.x, p_end.x) + pad;
+    needle_a.y2 = MATH_MAX(p_mid.y, p_end.y) + pad;
+
+    lv_obj_inv_area(gauge, &needle_a);
+}
+
 /**
  * Initialize the built-in gauge styles
  */
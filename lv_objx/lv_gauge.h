@@ -56,6 +56,13 @@ typedef struct
     char * txt;                 /*Printf-like text to display with the most critical value (e.g. "Value: %d")*/
     uint8_t needle_num;         /*Number of needles*/
     uint8_t low_critical    :1; /*0: the higher value is more critical, 1: the lower value is more critical*/
+    uint8_t dial_valid      :1; /*1: 'dial_buf' is up to date*/
+    uint8_t dial_fail       :1; /*1: 'dial_buf' couldn't be allocated with 'dial_w' and 'dial_h' (don't retry)*/
+    color_t * dial_buf;         /*Cached background and scale or NULL (see LV_GAUGE_CACHE_SIZE)*/
+    cord_t dial_w;              /*Width of 'dial_buf'*/
+    cord_t dial_h;              /*Height of 'dial_buf'*/
+    color_t dial_mcolor;        /*Top color of the background in 'dial_buf' (it depends on the critical value)*/
+    color_t dial_gcolor;        /*Bottom color of the background in 'dial_buf'*/
 }lv_gauge_ext_t;
 
 /*Style of gauge*/
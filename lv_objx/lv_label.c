@@ -14,6 +14,7 @@
 #include "lv_label.h"
 #include "../lv_obj/lv_obj.h"
 #include "../lv_misc/text.h"
+#include "../lv_misc/txt_pool.h"
 #include "../lv_misc/anim.h"
 #include "../lv_draw/lv_draw.h"
 
@@ -39,6 +40,9 @@
 
 #define LV_LABEL_DOT_NUM	3
 #define LV_LABEL_DOT_END_INV 0xFFFF
+#define LV_LABEL_TXT_RESERVE        16  /*Extra space to allocate when a text grows to make the next inserts cheap*/
+#define LV_LABEL_LINE_RESERVE       8   /*Extra space for line starts in the line index*/
+#define LV_LABEL_RELAYOUT_LINE_MAX  16  /*Max. number of re-wrapped lines after an insert/cut (else refresh everything)*/
 
 /**********************
  *      TYPEDEFS
@@ -49,6 +53,19 @@
  **********************/
 static bool lv_label_design(lv_obj_t * label, const area_t * mask, lv_design_mode_t mode);
 static void lv_label_refr_text(lv_obj_t * label);
+static void lv_label_refr_part(lv_obj_t * label, uint16_t pos, int32_t diff);
+static void lv_label_revert_dots(lv_obj_t * label);
+static bool lv_label_txt_reserve(lv_obj_t * label, uint32_t size);
+static void lv_label_txt_copy(lv_obj_t * label, const char * array, uint32_t size);
+static void lv_label_txt_free(lv_label_ext_t * ext);
+#if LV_LABEL_LINE_INDEX != 0
+static void lv_label_refr_line_index(lv_obj_t * label);
+static void lv_label_relayout(lv_obj_t * label, uint16_t pos, int32_t diff);
+static bool lv_label_line_index_alloc(lv_label_ext_t * ext, uint16_t cnt);
+static void lv_label_line_index_free(lv_label_ext_t * ext);
+static uint16_t lv_label_find_line(lv_label_ext_t * ext, uint16_t index);
+static cord_t lv_label_get_index_height(lv_obj_t * label);
+#endif
 static void lv_labels_init(void);
 
 /**********************
@@ -86,8 +103,13 @@ lv_obj_t * lv_label_create(lv_obj_t * par, lv_obj_t * copy)
     dm_assert(ext);
     ext->txt = NULL;
     ext->static_txt = 0;
+    ext->shared_txt = 0;
     ext->dot_end = LV_LABEL_DOT_END_INV;
     ext->long_mode = LV_LABEL_LONG_EXPAND;
+#if LV_LABEL_LINE_INDEX != 0
+    ext->line_start = NULL;
+    ext->line_cnt = 0;
+#endif
 
 	lv_obj_set_design_f(new_label, lv_label_design);
 	lv_obj_set_signal_f(new_label, lv_label_signal);
@@ -134,14 +156,23 @@ bool lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param)
         /*No signal handling*/
     	switch(sign) {
             case LV_SIGNAL_CLEANUP:
-                if(ext->static_txt == 0) {
-                    dm_free(ext->txt);
-                    ext->txt = NULL;
-                }
+                lv_label_txt_free(ext);
+#if LV_LABEL_LINE_INDEX != 0
+                lv_label_line_index_free(ext);
+#endif
                 break;
             case LV_SIGNAL_STYLE_CHG:
             	lv_label_set_text(label, NULL);
             	break;
+#if LV_LABEL_LINE_INDEX != 0
+            case LV_SIGNAL_CORD_CHG:
+                /*The line index is invalid with a new width*/
+                if(ext->line_start != NULL &&
+                   area_get_width(param) != lv_obj_get_width(label)) {
+                    lv_label_refr_text(label);
+                }
+                break;
+#endif
 
 			default:
 				break;
@@ -157,30 +188,29 @@ bool lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param)
 
 /**
  * Set a new text for a label. Memory will be allocated to store the text by the label.
+ * Labels with the same text share one copy of it. Nothing happens if the text is not changed.
  * @param label pointer to a label object
  * @param text '\0' terminated character string. NULL to refresh with the current text.
  */
 void lv_label_set_text(lv_obj_t * label, const char * text)
 {
-    lv_obj_inv(label);
-    
     lv_label_ext_t * ext = lv_obj_get_ext(label);
 
     /*If trying to set its own text or the text is NULL then refresh */
     if(text == ext->txt || text == NULL) {
+        lv_obj_inv(label);
         lv_label_refr_text(label);
         return;
     }
 
-    /*Allocate space for the new text*/
-    uint32_t len = strlen(text) + 1;
-    if(ext->txt != NULL && ext->static_txt == 0) {
-        dm_free(ext->txt);
+    /*Skip the refresh if the same text is set again (e.g. periodically updated values)*/
+    if(ext->txt != NULL && ext->static_txt == 0 &&
+       ext->dot_end == LV_LABEL_DOT_END_INV && strcmp(ext->txt, text) == 0) {
+        return;
     }
-    ext->txt = dm_alloc(len);
-    strcpy(ext->txt, text);
-    ext->static_txt = 0;    /*Now the text is dynamically allocated*/
-    
+
+    lv_obj_inv(label);
+    lv_label_txt_copy(label, text, strlen(text));
     lv_label_refr_text(label);
 }
 /**
@@ -192,25 +222,23 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
  */
 void lv_label_set_text_array(lv_obj_t * label, const char * array, uint16_t size)
 {
-    lv_obj_inv(label);
-
     lv_label_ext_t * ext = lv_obj_get_ext(label);
 
     /*If trying to set its own text or the array is NULL then refresh */
     if(array == ext->txt || array == NULL) {
+        lv_obj_inv(label);
         lv_label_refr_text(label);
         return;
     }
 
-    /*Allocate space for the new text*/
-    if(ext->txt != NULL && ext->static_txt == 0) {
-        dm_free(ext->txt);
+    /*Skip the refresh if the same text is set again*/
+    if(ext->txt != NULL && ext->static_txt == 0 && ext->dot_end == LV_LABEL_DOT_END_INV &&
+       strncmp(ext->txt, array, size) == 0 && ext->txt[size] == '\0') {
+        return;
     }
-    ext->txt = dm_alloc(size + 1);
-    memcpy(ext->txt, array, size);
-    ext->txt[size] = '\0';
-    ext->static_txt = 0;    /*Now the text is dynamically allocated*/
 
+    lv_obj_inv(label);
+    lv_label_txt_copy(label, array, size);
     lv_label_refr_text(label);
 }
 
@@ -223,17 +251,74 @@ void lv_label_set_text_array(lv_obj_t * label, const char * array, uint16_t size
 void lv_label_set_text_static(lv_obj_t * label, const char * text)
 {
     lv_label_ext_t * ext = lv_obj_get_ext(label);
-    if(ext->static_txt == 0 && ext->txt != NULL) {
-        dm_free(ext->txt);
-    }
 
-    if(text != NULL) {
+    if(text != NULL && text != ext->txt) {
+        lv_label_txt_free(ext);
         ext->static_txt = 1;
         ext->txt = (char *) text;
     }
 
     lv_label_refr_text(label);
 }
+/**
+ * Insert a text into a label. A static or shared text is copied first.
+ * Only the affected lines are re-wrapped and redrawn in 'LV_LABEL_LONG_BREAK' mode.
+ * @param label pointer to a label object
+ * @param pos character index to insert (0: before the first character)
+ * @param txt pointer to a '\0' terminated text to insert
+ */
+void lv_label_ins_text(lv_obj_t * label, uint16_t pos, const char * txt)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+    if(ext->txt == NULL || txt == NULL) return;
+
+    lv_label_revert_dots(label);
+
+    uint32_t old_len = strlen(ext->txt);
+    uint32_t ins_len = strlen(txt);
+    if(ins_len == 0) return;
+    if(pos > old_len) pos = old_len;
+
+    if(lv_label_txt_reserve(label, old_len + ins_len + 1) == false) return;
+
+    /*Make room for the new text in place and copy it there*/
+    memmove(&ext->txt[pos + ins_len], &ext->txt[pos], old_len - pos + 1);
+    memcpy(&ext->txt[pos], txt, ins_len);
+
+#if LV_LABEL_LINE_INDEX != 0
+    /*The line index can't address so long texts*/
+    if(old_len + ins_len > UINT16_MAX) lv_label_line_index_free(ext);
+#endif
+
+    lv_label_refr_part(label, pos, ins_len);
+}
+
+/**
+ * Delete characters from a label. A static or shared text is copied first.
+ * Only the affected lines are re-wrapped and redrawn in 'LV_LABEL_LONG_BREAK' mode.
+ * @param label pointer to a label object
+ * @param pos character index of the first character to delete
+ * @param cnt number of characters to delete
+ */
+void lv_label_cut_text(lv_obj_t * label, uint16_t pos, uint16_t cnt)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+    if(ext->txt == NULL) return;
+
+    lv_label_revert_dots(label);
+
+    uint32_t old_len = strlen(ext->txt);
+    if(pos >= old_len || cnt == 0) return;
+    if(pos + cnt > old_len) cnt = old_len - pos;
+
+    /*Copy a static text to be able to modify it*/
+    if(lv_label_txt_reserve(label, old_len + 1) == false) return;
+
+    memmove(&ext->txt[pos], &ext->txt[pos + cnt], old_len - pos - cnt + 1);
+
+    lv_label_refr_part(label, pos, -(int32_t)cnt);
+}
+
 /**
  * Set the behavior of the label with longer text then the object size
  * @param label pointer to a label object
@@ -244,13 +329,7 @@ void lv_label_set_long_mode(lv_obj_t * label, lv_label_long_mode_t long_mode)
     lv_label_ext_t * ext = lv_obj_get_ext(label);
 
     /*When changing from dot mode reload the characters replaced by dots*/
-    if(ext->long_mode == LV_LABEL_LONG_DOTS &&
-       ext->dot_end != LV_LABEL_DOT_END_INV) {
-    	uint8_t i;
-    	for(i = 0; i < LV_LABEL_DOT_NUM + 1; i++) {
-    		ext->txt[ext->dot_end - LV_LABEL_DOT_NUM + i] = ext->dot_tmp[i];
-    	}
-    }
+    lv_label_revert_dots(label);
 
     /*Delete the scroller animations*/
     if(ext->long_mode == LV_LABEL_LONG_SCROLL) {
@@ -312,16 +391,27 @@ void lv_label_get_letter_pos(lv_obj_t * label, uint16_t index, point_t * pos)
         max_w = LV_CORD_MAX;
     }
 
-    /*Search the line of the index letter */;
-    while (text[new_line_start] != '\0') {
-        new_line_start += txt_get_next_line(&text[line_start], font, labels->letter_space, max_w);
-        if(index < new_line_start || text[new_line_start] == '\0') break; /*The line of 'index' letter begins at 'line_start'*/
-
-        y += letter_height + labels->line_space;
-        line_start = new_line_start;
+#if LV_LABEL_LINE_INDEX != 0
+    /*Look up the line of the index letter from the line index*/
+    if(ext->line_start != NULL) {
+        uint16_t line = lv_label_find_line(ext, index);
+        line_start = ext->line_start[line];
+        new_line_start = line_start + txt_get_next_line(&text[line_start], font, labels->letter_space, max_w);
+        y = line * (letter_height + labels->line_space);
+    } else
+#endif
+    {
+        /*Search the line of the index letter */;
+        while (text[new_line_start] != '\0') {
+            new_line_start += txt_get_next_line(&text[line_start], font, labels->letter_space, max_w);
+            if(index < new_line_start || text[new_line_start] == '\0') break; /*The line of 'index' letter begins at 'line_start'*/
+
+            y += letter_height + labels->line_space;
+            line_start = new_line_start;
+        }
     }
 
-    if((text[index - 1] == '\n' || text[index - 1] == '\r') && text[index] == '\0') {
+    if(index > 0 && (text[index - 1] == '\n' || text[index - 1] == '\r') && text[index] == '\0') {
         y += letter_height + labels->line_space;
         line_start = index;
     }
@@ -368,12 +458,28 @@ uint16_t lv_label_get_letter_on(lv_obj_t * label, point_t * pos)
         max_w = LV_CORD_MAX;
     }
 
-    /*Search the line of the index letter */;
-    while (text[line_start] != '\0') {
-    	new_line_start += txt_get_next_line(&text[line_start], font, style->letter_space, max_w);
-    	if(pos->y <= y + letter_height + style->line_space) break; /*The line is found ('line_start')*/
-    	y += letter_height + style->line_space;
-        line_start = new_line_start;
+#if LV_LABEL_LINE_INDEX != 0
+    /*Calculate the line from the 'y' coordinate and look it up in the line index*/
+    if(ext->line_start != NULL) {
+        cord_t line_h = letter_height + style->line_space;
+        uint32_t line = pos->y <= 0 ? 0 : (pos->y - 1) / line_h;
+        if(line < ext->line_cnt) {
+            line_start = ext->line_start[line];
+            new_line_start = line_start + txt_get_next_line(&text[line_start], font, style->letter_space, max_w);
+        } else {
+            line_start = strlen(text);
+            new_line_start = line_start;
+        }
+    } else
+#endif
+    {
+        /*Search the line of the index letter */;
+        while (text[line_start] != '\0') {
+            new_line_start += txt_get_next_line(&text[line_start], font, style->letter_space, max_w);
+            if(pos->y <= y + letter_height + style->line_space) break; /*The line is found ('line_start')*/
+            y += letter_height + style->line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
@@ -465,9 +571,22 @@ static bool lv_label_design(lv_obj_t * label, const area_t * mask, lv_design_mod
 		lv_obj_get_cords(label, &cords);
 		opa_t opa = lv_obj_get_opa(label);
 		lv_label_ext_t * ext = lv_obj_get_ext(label);
+		const char * txt = ext->txt;
+
+#if LV_LABEL_LINE_INDEX != 0
+		/*Skip the lines above the mask*/
+		if(ext->line_start != NULL && mask->y1 > cords.y1) {
+		    lv_labels_t * style = lv_obj_get_style(label);
+		    cord_t line_h = font_get_height(font_get(style->font)) + style->line_space;
+		    uint32_t first = (mask->y1 - cords.y1) / line_h;
+		    if(first >= ext->line_cnt) return true;
+
+		    cords.y1 += first * line_h;
+		    txt = &ext->txt[ext->line_start[first]];
+		}
+#endif
 
-
-		lv_draw_label(&cords, mask, lv_obj_get_style(label), opa, ext->txt);
+		lv_draw_label(&cords, mask, lv_obj_get_style(label), opa, txt);
 
 
     }
@@ -497,7 +616,22 @@ static void lv_label_refr_text(lv_obj_t * label)
 
     /*Calc. the height and longest line*/
     point_t size;
-    txt_get_size(&size, ext->txt, font, style->letter_space, style->line_space, max_w);
+#if LV_LABEL_LINE_INDEX != 0
+    /*In break mode only the height is required which comes from the line index*/
+    if(ext->long_mode == LV_LABEL_LONG_BREAK) {
+        lv_label_refr_line_index(label);
+    } else {
+        lv_label_line_index_free(ext);
+    }
+
+    if(ext->line_start != NULL) {
+        size.x = 0;
+        size.y = lv_label_get_index_height(label);
+    } else
+#endif
+    {
+        txt_get_size(&size, ext->txt, font, style->letter_space, style->line_space, max_w);
+    }
 
     /*Refresh the full size in expand mode*/
     if(ext->long_mode == LV_LABEL_LONG_EXPAND || ext->long_mode == LV_LABEL_LONG_SCROLL) {
@@ -558,6 +692,11 @@ static void lv_label_refr_text(lv_obj_t * label)
         point.y = lv_obj_get_height(label) - 1;
         uint16_t index = lv_label_get_letter_on(label, &point);
 
+        /*A shared text can't be modified so get an own copy of it*/
+        if(index < strlen(ext->txt) - 1 && ext->shared_txt != 0) {
+            if(lv_label_txt_reserve(label, strlen(ext->txt) + 1) == false) index = LV_LABEL_DOT_END_INV;
+        }
+
         if(index < strlen(ext->txt) - 1) {
 
             /* Change the last 'LV_LABEL_DOT_NUM' to dots
@@ -588,6 +727,324 @@ static void lv_label_refr_text(lv_obj_t * label)
     lv_obj_inv(label);
 }
 
+/**
+ * Refresh only the modified part of a label after its text is edited in place
+ * @param label pointer to a label object
+ * @param pos index of the first modified character
+ * @param diff number of inserted (> 0) or deleted (< 0) characters
+ */
+static void lv_label_refr_part(lv_obj_t * label, uint16_t pos, int32_t diff)
+{
+#if LV_LABEL_LINE_INDEX != 0
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+    if(ext->long_mode == LV_LABEL_LONG_BREAK && ext->line_start != NULL) {
+        lv_label_relayout(label, pos, diff);
+        return;
+    }
+#endif
+
+    lv_obj_inv(label);
+    lv_label_refr_text(label);
+}
+
+/**
+ * Reload the characters which were replaced by dots in 'LV_LABEL_LONG_DOTS' mode
+ * @param label pointer to a label object
+ */
+static void lv_label_revert_dots(lv_obj_t * label)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+
+    if(ext->long_mode == LV_LABEL_LONG_DOTS &&
+       ext->dot_end != LV_LABEL_DOT_END_INV) {
+        uint8_t i;
+        for(i = 0; i < LV_LABEL_DOT_NUM + 1; i++) {
+            ext->txt[ext->dot_end - LV_LABEL_DOT_NUM + i] = ext->dot_tmp[i];
+        }
+        ext->dot_end = LV_LABEL_DOT_END_INV;
+    }
+}
+
+/**
+ * Make sure the text of a label is dynamically allocated, not shared and has enough space.
+ * A static or shared text is copied to a new buffer.
+ * @param label pointer to a label object
+ * @param size the required size in bytes (including the closing '\0')
+ * @return true: the text buffer is large enough, false: out of memory
+ */
+static bool lv_label_txt_reserve(lv_obj_t * label, uint32_t size)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+
+    if(ext->static_txt != 0 || ext->shared_txt != 0) {
+        char * txt_dyn = dm_alloc(size + LV_LABEL_TXT_RESERVE);
+        if(txt_dyn == NULL) return false;
+        strcpy(txt_dyn, ext->txt);
+        lv_label_txt_free(ext);
+        ext->txt = txt_dyn;
+        ext->static_txt = 0;
+        return true;
+    }
+
+    if(dm_get_size(ext->txt) >= size) return true;
+
+    /*Allocate some extra space to avoid a reallocation on every character*/
+    char * txt_new = dm_realloc(ext->txt, size + (size >> 2) + LV_LABEL_TXT_RESERVE);
+    if(txt_new == NULL) return false;
+    ext->txt = txt_new;
+
+    return true;
+}
+
+/**
+ * Replace the text of a label with a copy of a character array.
+ * The copy is shared with the other labels if possible.
+ * @param label pointer to a label object
+ * @param array array of characters (it can be part of the current text too)
+ * @param size the size of 'array' in bytes
+ */
+static void lv_label_txt_copy(lv_obj_t * label, const char * array, uint32_t size)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+    char * txt_new;
+    uint8_t shared = 0;
+
+#if LV_TXT_POOL_SIZE != 0
+    /*In dot mode the characters of the text are replaced so it can't be shared*/
+    if(ext->long_mode != LV_LABEL_LONG_DOTS) {
+        txt_new = (char *) txt_pool_get(array, size);
+        shared = 1;
+    } else
+#endif
+    {
+        txt_new = dm_alloc(size + 1);
+        memcpy(txt_new, array, size);
+        txt_new[size] = '\0';
+    }
+    dm_assert(txt_new);
+
+    /*Free the old text only now because 'array' can point into it*/
+    lv_label_txt_free(ext);
+    ext->txt = txt_new;
+    ext->static_txt = 0;    /*Now the text is dynamically allocated*/
+    ext->shared_txt = shared;
+}
+
+/**
+ * Free the text of a label if it is not static
+ * @param ext pointer to the extended data of a label
+ */
+static void lv_label_txt_free(lv_label_ext_t * ext)
+{
+    if(ext->txt != NULL && ext->static_txt == 0) {
+#if LV_TXT_POOL_SIZE != 0
+        if(ext->shared_txt != 0) txt_pool_release(ext->txt);
+        else dm_free(ext->txt);
+#else
+        dm_free(ext->txt);
+#endif
+    }
+
+    ext->txt = NULL;
+    ext->shared_txt = 0;
+}
+
+#if LV_LABEL_LINE_INDEX != 0
+/**
+ * Rebuild the whole line index of a label
+ * @param label pointer to a label object
+ */
+static void lv_label_refr_line_index(lv_obj_t * label)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+    lv_labels_t * style = lv_obj_get_style(label);
+    const font_t * font = font_get(style->font);
+    cord_t max_w = lv_obj_get_width(label);
+    const char * txt = ext->txt;
+    uint32_t line_start = 0;
+
+    ext->line_cnt = 0;
+    while(txt[line_start] != '\0') {
+        /*Work without index if there is not enough memory or the text is too long*/
+        if(line_start > UINT16_MAX ||
+           lv_label_line_index_alloc(ext, ext->line_cnt + 1) == false) {
+            lv_label_line_index_free(ext);
+            return;
+        }
+        ext->line_start[ext->line_cnt] = line_start;
+        ext->line_cnt++;
+        line_start += txt_get_next_line(&txt[line_start], font, style->letter_space, max_w);
+    }
+
+    /*An empty text has no lines*/
+    if(ext->line_cnt == 0) lv_label_line_index_free(ext);
+}
+
+/**
+ * Re-wrap only the lines around an in place text modification.
+ * The re-wrapping stops when a new line start matches an old one.
+ * @param label pointer to a label object
+ * @param pos index of the first modified character
+ * @param diff number of inserted (> 0) or deleted (< 0) characters
+ */
+static void lv_label_relayout(lv_obj_t * label, uint16_t pos, int32_t diff)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+    lv_labels_t * style = lv_obj_get_style(label);
+    const font_t * font = font_get(style->font);
+    cord_t max_w = lv_obj_get_width(label);
+    cord_t line_h = font_get_height(font) + style->line_space;
+    const char * txt = ext->txt;
+    uint16_t new_start[LV_LABEL_RELAYOUT_LINE_MAX];
+    uint16_t new_cnt = 0;
+    uint16_t old_cnt = ext->line_cnt;
+    int32_t edit_end = pos + (diff > 0 ? diff : 0);    /*End of the modified part in the new text*/
+    bool synced = false;
+
+    /*The previous line can change too (e.g. a word becomes short enough to fit into it)*/
+    uint16_t first = lv_label_find_line(ext, pos);
+    if(first > 0) first--;
+
+    uint16_t old_i = first + 1;
+    uint32_t act = ext->line_start[first];
+    while(txt[act] != '\0') {
+        /*If a line starts at the same text as an old line then the rest is unchanged*/
+        if((int32_t)act >= edit_end) {
+            while(old_i < old_cnt && (int32_t)ext->line_start[old_i] + diff < (int32_t)act) old_i++;
+            if(old_i < old_cnt && (int32_t)ext->line_start[old_i] + diff == (int32_t)act) {
+                synced = true;
+                break;
+            }
+        }
+
+        /*Too many lines are changed so refresh the whole label*/
+        if(new_cnt >= LV_LABEL_RELAYOUT_LINE_MAX) {
+            lv_obj_inv(label);
+            lv_label_refr_text(label);
+            return;
+        }
+
+        new_start[new_cnt] = act;
+        new_cnt++;
+        act += txt_get_next_line(&txt[act], font, style->letter_space, max_w);
+    }
+
+    uint16_t tail_cnt = synced != false ? old_cnt - old_i : 0;
+    uint16_t cnt = first + new_cnt + tail_cnt;
+
+    if(cnt == 0) {
+        lv_label_line_index_free(ext);
+        lv_obj_inv(label);
+        lv_label_refr_text(label);
+        return;
+    }
+
+    if(lv_label_line_index_alloc(ext, cnt) == false) {
+        lv_label_line_index_free(ext);
+        lv_obj_inv(label);
+        lv_label_refr_text(label);
+        return;
+    }
+
+    /*Move the unchanged lines to their new place and shift them with the modification*/
+    if(tail_cnt != 0) {
+        memmove(&ext->line_start[first + new_cnt], &ext->line_start[old_i], tail_cnt * sizeof(uint16_t));
+        uint16_t i;
+        for(i = first + new_cnt; i < cnt; i++) {
+            ext->line_start[i] += diff;
+        }
+    }
+    memcpy(&ext->line_start[first], new_start, new_cnt * sizeof(uint16_t));
+    ext->line_cnt = cnt;
+
+    /* Redraw only the re-wrapped lines if the line number is not changed
+     * else everything below them is moved*/
+    area_t inv_area;
+    lv_obj_get_cords(label, &inv_area);
+    inv_area.y1 += first * line_h;
+    if(cnt == old_cnt) inv_area.y2 = label->cords.y1 + (first + new_cnt) * line_h - 1;
+    lv_obj_inv_area(label, &inv_area);
+
+    /*Only the height can change in break mode*/
+    lv_obj_set_height(label, lv_label_get_index_height(label));
+}
+
+/**
+ * Make sure the line index can store 'cnt' line starts
+ * @param ext pointer to the ext. data of a label
+ * @param cnt number of required lines
+ * @return true: success, false: out of memory
+ */
+static bool lv_label_line_index_alloc(lv_label_ext_t * ext, uint16_t cnt)
+{
+    uint32_t size = ext->line_start == NULL ? 0 : dm_get_size(ext->line_start);
+    if(cnt * sizeof(uint16_t) <= size) return true;
+
+    uint16_t * new_p = dm_realloc(ext->line_start, (cnt + LV_LABEL_LINE_RESERVE) * sizeof(uint16_t));
+    if(new_p == NULL) return false;
+    ext->line_start = new_p;
+
+    return true;
+}
+
+/**
+ * Free the line index of a label
+ * @param ext pointer to the ext. data of a label
+ */
+static void lv_label_line_index_free(lv_label_ext_t * ext)
+{
+    if(ext->line_start != NULL) dm_free(ext->line_start);
+    ext->line_start = NULL;
+    ext->line_cnt = 0;
+}
+
+/**
+ * Find the line of a letter with binary search in the line index
+ * @param ext pointer to the ext. data of a label (the line index has to exist)
+ * @param index index of a letter
+ * @return the index of the line which contains the letter
+ */
+static uint16_t lv_label_find_line(lv_label_ext_t * ext, uint16_t index)
+{
+    uint16_t min = 0;
+    uint16_t max = ext->line_cnt - 1;
+
+    while(min < max) {
+        uint16_t mid = (min + max + 1) >> 1;
+        if(ext->line_start[mid] <= index) min = mid;
+        else max = mid - 1;
+    }
+
+    return min;
+}
+
+/**
+ * Get the height of a label from its line index
+ * @param label pointer to a label object (the line index has to exist)
+ * @return the height of the text
+ */
+static cord_t lv_label_get_index_height(lv_obj_t * label)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+    lv_labels_t * style = lv_obj_get_style(label);
+    const font_t * font = font_get(style->font);
+    cord_t letter_height = font_get_height(font);
+    cord_t h = ext->line_cnt * (letter_height + style->line_space);
+
+    /*Add an empty line if the text ends with a new line (like 'txt_get_size')*/
+    uint32_t last = ext->line_start[ext->line_cnt - 1];
+    uint32_t txt_end = last + txt_get_next_line(&ext->txt[last], font, style->letter_space,
+                                                lv_obj_get_width(label));
+    if(ext->txt[txt_end - 1] == '\n' || ext->txt[txt_end - 1] == '\r') {
+        h += letter_height + style->line_space;
+    }
+
+    h -= style->line_space;
+
+    return h;
+}
+#endif
+
 /**
  * Initialize the label styles
  */
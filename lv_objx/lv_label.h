@@ -20,6 +20,11 @@
  *********************/
 #define LV_LABEL_DOT_NUM 3
 
+/*Test configuration*/
+#ifndef LV_LABEL_LINE_INDEX
+#define LV_LABEL_LINE_INDEX     1   /*Store the line starts in break mode to speed up the edit of long texts*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -40,9 +45,14 @@ typedef struct
     /*New data for this type */
     char * txt;                     /*Text of the label*/
     lv_label_long_mode_t long_mode; /*Determinate what to do with the long texts*/
-    char dot_tmp[LV_LABEL_DOT_NUM]; /*Store character which are replaced with dots*/
+    char dot_tmp[LV_LABEL_DOT_NUM + 1]; /*Store character which are replaced with dots (and the closing one)*/
     uint16_t dot_end;               /* The text end position in dot mode*/
+#if LV_LABEL_LINE_INDEX != 0
+    uint16_t * line_start;          /*Start index of the lines in 'LV_LABEL_LONG_BREAK' mode (NULL if not used)*/
+    uint16_t line_cnt;              /*Number of valid elements in 'line_start'*/
+#endif
     uint8_t static_txt  :1;         /* Flag to indicate the text is static*/
+    uint8_t shared_txt  :1;         /* Flag to indicate the text is in the text pool (read only)*/
 }lv_label_ext_t;
 
 /*Style of label*/
@@ -109,6 +119,24 @@ void lv_label_set_text_array(lv_obj_t * label, const char * array, uint16_t size
  */
 void lv_label_set_text_static(lv_obj_t * label, const char * text);
 
+/**
+ * Insert a text into a label. A static or shared text is copied first.
+ * Only the affected lines are re-wrapped and redrawn in 'LV_LABEL_LONG_BREAK' mode.
+ * @param label pointer to a label object
+ * @param pos character index to insert (0: before the first character)
+ * @param txt pointer to a '\0' terminated text to insert
+ */
+void lv_label_ins_text(lv_obj_t * label, uint16_t pos, const char * txt);
+
+/**
+ * Delete characters from a label. A static or shared text is copied first.
+ * Only the affected lines are re-wrapped and redrawn in 'LV_LABEL_LONG_BREAK' mode.
+ * @param label pointer to a label object
+ * @param pos character index of the first character to delete
+ * @param cnt number of characters to delete
+ */
+void lv_label_cut_text(lv_obj_t * label, uint16_t pos, uint16_t cnt);
+
 /**
  * Set the behavior of the label with longer text then the object size
  * @param label pointer to a label object
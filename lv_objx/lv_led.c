@@ -12,6 +12,9 @@
 #include "lv_rect.h"
 #include "lv_led.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_vbasic.h"
+#include "../lv_obj/lv_refr.h"
+#include "misc/math/math_base.h"
 
 /*********************
  *      DEFINES
@@ -21,15 +24,35 @@
 #define LV_LED_BRIGHT_DEF	128
 #define LV_LED_BRIGHT_OFF	60
 #define LV_LED_BRIGHT_ON	255
+#define LV_LED_SNAP_NUM     4   /*Max. number of cached snapshots (LEDs with different style or size)*/
+
+/*Test configurations*/
+#ifndef LV_LED_CACHE_SIZE
+#define LV_LED_CACHE_SIZE   (16 * 1024)
+#endif
+
+#define LV_LED_CACHE_EN     (LV_LED_CACHE_SIZE != 0 && LV_VDB_SIZE != 0)
 
 /**********************
  *      TYPEDEFS
  **********************/
+/*Snapshot of the body of the LEDs with the same style and size on full brightness*/
+typedef struct
+{
+    lv_leds_t * style;      /*Style of the LEDs*/
+    uint32_t style_gen;     /*Generation of the style when the snapshot was rendered*/
+    cord_t w;               /*Width of the LEDs*/
+    cord_t h;               /*Height of the LEDs*/
+    uint32_t last_use;      /*To drop the least recently used snapshot first*/
+    color_t * buf;          /*The rendered pixels or NULL if the slot is free*/
+}lv_led_snap_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bool lv_led_design(lv_obj_t * led, const area_t * mask, lv_design_mode_t mode);
+static cord_t lv_led_get_light(lv_obj_t * led, uint8_t bright);
+static lv_led_snap_t * lv_led_get_snap(lv_obj_t * led);
 static void lv_leds_init(void);
 
 /**********************
@@ -40,6 +63,11 @@ static lv_leds_t lv_leds_def;
 static lv_leds_t lv_leds_red;
 static lv_leds_t lv_leds_green;
 static lv_design_f_t ancestor_design_f;
+#if LV_LED_CACHE_EN != 0
+static lv_led_snap_t led_snaps[LV_LED_SNAP_NUM];
+static uint32_t led_snap_use_cnt;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -131,12 +159,22 @@ bool lv_led_signal(lv_obj_t * led, lv_signal_t sign, void * param)
  */
 void lv_led_set_bright(lv_obj_t * led, uint8_t bright)
 {
-	/*Set the brightness*/
 	lv_led_ext_t * ext = lv_obj_get_ext(led);
+	if(ext->bright == bright) return;
+
+	/*Invalidate the LED with the larger light of the old and new brightness*/
+	cord_t light = MATH_MAX(lv_led_get_light(led, ext->bright), lv_led_get_light(led, bright));
+	area_t area;
+	lv_obj_get_cords(led, &area);
+	area.x1 -= light;
+	area.y1 -= light;
+	area.x2 += light;
+	area.y2 += light;
+
+	/*Set the brightness*/
 	ext->bright = bright;
 
-	/*Invalidate the object there fore it will be redrawn*/
-	lv_obj_inv(led);
+	lv_obj_inv_area(led, &area);
 }
 
 /**
@@ -244,7 +282,6 @@ static bool lv_led_design(lv_obj_t * led, const area_t * mask, lv_design_mode_t
     	/*Return false if the object is not covers the mask area*/
     	return ancestor_design_f(led, mask, mode);
     } else if(mode == LV_DESIGN_DRAW_MAIN) {
-		/*Make darker colors in a temporary style according to the brightness*/
 		lv_led_ext_t * ext = lv_obj_get_ext(led);
 		lv_leds_t * style = lv_obj_get_style(led);
 
@@ -252,23 +289,148 @@ static bool lv_led_design(lv_obj_t * led, const area_t * mask, lv_design_mode_t
         lv_leds_t leds_tmp;
 		memcpy(&leds_tmp, style, sizeof(leds_tmp));
 
-		/*Mix. the color with black proportionally with brightness*/
-		leds_tmp.bg_rect.objs.color = color_mix(leds_tmp.bg_rect.objs.color, COLOR_BLACK, ext->bright);
-		leds_tmp.bg_rect.gcolor = color_mix(leds_tmp.bg_rect.gcolor, COLOR_BLACK, ext->bright);
-
 		/*Set smaller light size with lower brightness*/
-		/*light = 0 comes to LV_LED_BRIGHTNESS_OFF and the original light comes to LV_LED_BRIGHTNESS_ON*/
-		leds_tmp.bg_rect.light = (uint16_t)((uint16_t)(ext->bright - LV_LED_BRIGHT_OFF) * style->bg_rect.light) /
-		                     (LV_LED_BRIGHT_ON - LV_LED_BRIGHT_OFF);
-
-
-		led->style_p = &leds_tmp;
-		ancestor_design_f(led, mask, mode);
-        led->style_p = style;
+		leds_tmp.bg_rect.light = lv_led_get_light(led, ext->bright);
+
+		lv_led_snap_t * snap = lv_led_get_snap(led);
+		if(snap != NULL) {
+			/*Draw only the light normally because it is mixed with the background*/
+			leds_tmp.bg_rect.empty = 1;
+			leds_tmp.bg_rect.bwidth = 0;
+			led->style_p = &leds_tmp;
+			ancestor_design_f(led, mask, mode);
+			led->style_p = style;
+
+			/*Draw the body from the snapshot and darken it according to the brightness*/
+			area_t cords;
+			lv_obj_get_cords(led, &cords);
+			lv_vmap(&cords, mask, snap->buf, OPA_COVER, true, false, COLOR_BLACK, OPA_COVER - ext->bright);
+		} else {
+			/*Mix. the colors with black proportionally with brightness*/
+			leds_tmp.bg_rect.objs.color = color_mix(leds_tmp.bg_rect.objs.color, COLOR_BLACK, ext->bright);
+			leds_tmp.bg_rect.gcolor = color_mix(leds_tmp.bg_rect.gcolor, COLOR_BLACK, ext->bright);
+			leds_tmp.bg_rect.bcolor = color_mix(leds_tmp.bg_rect.bcolor, COLOR_BLACK, ext->bright);
+
+			led->style_p = &leds_tmp;
+			ancestor_design_f(led, mask, mode);
+			led->style_p = style;
+		}
     }
     return true;
 }
 
+/**
+ * Get the size of the light of a LED on a brightness
+ * @param led pointer to a LED object
+ * @param bright a brightness
+ * @return the size of the light (0 on LV_LED_BRIGHT_OFF or darker, the style's light on LV_LED_BRIGHT_ON)
+ */
+static cord_t lv_led_get_light(lv_obj_t * led, uint8_t bright)
+{
+	lv_leds_t * style = lv_obj_get_style(led);
+	if(bright <= LV_LED_BRIGHT_OFF) return 0;
+
+	cord_t light = (uint32_t)(bright - LV_LED_BRIGHT_OFF) * style->bg_rect.light /
+	               (LV_LED_BRIGHT_ON - LV_LED_BRIGHT_OFF);
+
+	/*'lv_rect' draws a light with at least this size*/
+	if(light != 0 && light < LV_DOWNSCALE) light = LV_DOWNSCALE;
+
+	return light;
+}
+
+/**
+ * Get the snapshot of the body (without light) of a LED on full brightness.
+ * The LEDs with the same style and size share a snapshot. Render it if there is no such snapshot.
+ * @param led pointer to a LED object
+ * @return pointer to the snapshot or NULL if it can't be used (draw the LED normally)
+ */
+static lv_led_snap_t * lv_led_get_snap(lv_obj_t * led)
+{
+#if LV_LED_CACHE_EN != 0
+	lv_leds_t * style = lv_obj_get_style(led);
+	color_t transp_color = LV_COLOR_TRANSP;
+
+	/*The snapshot has no background so only an opaque LED can be drawn from it.
+	 *The pixels with the transparent color would be skipped so it can't be used in the style.*/
+	if(lv_obj_get_opa(led) != OPA_COVER || style->bg_rect.empty != 0) return NULL;
+	if(style->bg_rect.objs.color.full == transp_color.full ||
+	   style->bg_rect.gcolor.full == transp_color.full ||
+	   style->bg_rect.bcolor.full == transp_color.full) return NULL;
+
+	area_t cords;
+	lv_obj_get_cords(led, &cords);
+	cord_t w = area_get_width(&cords);
+	cord_t h = area_get_height(&cords);
+	if(w <= 0 || h <= 0) return NULL;
+
+	uint32_t buf_size = (uint32_t)w * h * sizeof(color_t);
+	if(buf_size > LV_LED_CACHE_SIZE) return NULL;
+
+	/*Search a snapshot of the same style and size*/
+	uint32_t style_gen = lv_style_get_gen(style);
+	lv_led_snap_t * snap;
+	uint8_t i;
+	for(i = 0; i < LV_LED_SNAP_NUM; i++) {
+		snap = &led_snaps[i];
+		if(snap->buf != NULL && snap->style == style && snap->style_gen == style_gen &&
+		   snap->w == w && snap->h == h) {
+			snap->last_use = ++led_snap_use_cnt;
+			return snap;
+		}
+	}
+
+	/*Drop the least recently used snapshots until there is a free slot and enough memory*/
+	while(1) {
+		lv_led_snap_t * free_snap = NULL;
+		lv_led_snap_t * lru_snap = NULL;
+		uint32_t mem_used = 0;
+		for(i = 0; i < LV_LED_SNAP_NUM; i++) {
+			snap = &led_snaps[i];
+			if(snap->buf == NULL) {
+				free_snap = snap;
+			} else {
+				mem_used += (uint32_t)snap->w * snap->h * sizeof(color_t);
+				if(lru_snap == NULL || snap->last_use < lru_snap->last_use) lru_snap = snap;
+			}
+		}
+
+		if(free_snap != NULL && mem_used + buf_size <= LV_LED_CACHE_SIZE) {
+			snap = free_snap;
+			break;
+		}
+
+		dm_free(lru_snap->buf);
+		lru_snap->buf = NULL;
+	}
+
+	snap->buf = dm_alloc(buf_size);
+	if(snap->buf == NULL) return NULL;
+
+	snap->style = style;
+	snap->style_gen = style_gen;
+	snap->w = w;
+	snap->h = h;
+	snap->last_use = ++led_snap_use_cnt;
+
+	uint32_t px_num = (uint32_t)w * h;
+	uint32_t px;
+	for(px = 0; px < px_num; px++) snap->buf[px] = transp_color;
+
+	/*Draw the body with the original colors and without light*/
+	lv_leds_t leds_tmp;
+	memcpy(&leds_tmp, style, sizeof(leds_tmp));
+	leds_tmp.bg_rect.light = 0;
+	led->style_p = &leds_tmp;
+	lv_refr_snapshot(led, snap->buf, &cords, ancestor_design_f);
+	led->style_p = style;
+
+	return snap;
+#else
+	return NULL;
+#endif
+}
+
 /**
  * Initialize the led styles
  */
@@ -25,6 +25,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define LV_LINE_BLOCK_SEG   16      /*Number of segments in a group of 'lv_line_block_t'*/
 
 /**********************
  *      TYPEDEFS
@@ -34,6 +35,8 @@
  *  STATIC PROTOTYPES
  **********************/
 static bool lv_line_design(lv_obj_t * line, const area_t * mask, lv_design_mode_t mode);
+static void lv_line_refr_blocks(lv_obj_t * line, uint16_t seg_first);
+static void lv_line_refr_size(lv_obj_t * line);
 static void lv_lines_init(void);
 
 /**********************
@@ -67,6 +70,9 @@ lv_obj_t * lv_line_create(lv_obj_t * par, lv_obj_t * copy)
     dm_assert(ext);
     ext->point_num = 0;
     ext->point_array = NULL;
+    ext->blocks = NULL;
+    ext->x_max = LV_CORD_MIN;
+    ext->y_max = LV_CORD_MIN;
     ext->auto_size = 1;
     ext->y_inv = 0;
     ext->upscale = 0;
@@ -109,7 +115,12 @@ bool lv_line_signal(lv_obj_t * line, lv_signal_t sign, void * param)
     /* The object can be deleted so check its validity and then
      * make the object specific signal handling */
     if(valid != false) {
+        lv_line_ext_t * ext = lv_obj_get_ext(line);
     	switch(sign) {
+    	    case LV_SIGNAL_CLEANUP:
+    	        if(ext->blocks != NULL) dm_free(ext->blocks);
+    	        ext->blocks = NULL;
+    	        break;
     		default:
     			break;
     	}
@@ -135,23 +146,81 @@ void lv_line_set_points(lv_obj_t * line, const point_t * point_a, uint16_t point
 	ext->point_array = point_a;
 	ext->point_num = point_num;
 
-	uint8_t us = 1;
-	if(ext->upscale != 0) {
-		us = LV_DOWNSCALE;
+	uint16_t i;
+	ext->x_max = LV_CORD_MIN;
+	ext->y_max = LV_CORD_MIN;
+	for(i = 0; i < point_num; i++) {
+		ext->x_max = MATH_MAX(point_a[i].x, ext->x_max);
+		ext->y_max = MATH_MAX(point_a[i].y, ext->y_max);
 	}
 
-	if(point_num > 0 && ext->auto_size != 0) {
-		uint16_t i;
-		cord_t xmax = LV_CORD_MIN;
-		cord_t ymax = LV_CORD_MIN;
-		for(i = 0; i < point_num; i++) {
-			xmax = MATH_MAX(point_a[i].x * us, xmax);
-			ymax = MATH_MAX(point_a[i].y * us, ymax);
-		}
+	if(ext->blocks != NULL) {
+		dm_free(ext->blocks);
+		ext->blocks = NULL;
+	}
+	lv_line_refr_blocks(line, 0);
 
-		lv_lines_t * lines = lv_obj_get_style(line);
-		lv_obj_set_size(line, xmax + lines->width, ymax + lines->width);
+	lv_line_refr_size(line);
+	lv_obj_inv(line);
+}
+
+/**
+ * Add points to the end of a line. They have to be written already after the last point
+ * in the array set by 'lv_line_set_points'. Only the new points are processed and
+ * only the new segments are redrawn (unless the auto size changes the size).
+ * @param line pointer to a line object
+ * @param num number of new points
+ */
+void lv_line_add_points(lv_obj_t * line, uint16_t num)
+{
+	lv_line_ext_t * ext = lv_obj_get_ext(line);
+	if(num == 0 || ext->point_array == NULL) return;
+
+	/*The first new segment starts from the old last point*/
+	uint16_t first = ext->point_num > 0 ? ext->point_num - 1 : 0;
+	uint16_t i;
+	for(i = ext->point_num; i < ext->point_num + num; i++) {
+		ext->x_max = MATH_MAX(ext->point_array[i].x, ext->x_max);
+		ext->y_max = MATH_MAX(ext->point_array[i].y, ext->y_max);
+	}
+	ext->point_num += num;
+
+	lv_line_refr_blocks(line, first);
+
+	/*Redraw everything if the size is changed, else only the new segments*/
+	cord_t w = lv_obj_get_width(line);
+	cord_t h = lv_obj_get_height(line);
+	lv_line_refr_size(line);
+	if(w != lv_obj_get_width(line) || h != lv_obj_get_height(line)) return;
+
+	lv_lines_t * lines = lv_obj_get_style(line);
+	uint8_t us = ext->upscale != 0 ? LV_DOWNSCALE : 1;
+	area_t inv;
+	lv_obj_get_cords(line, &inv);
+	cord_t x_min = LV_CORD_MAX;
+	cord_t x_max = LV_CORD_MIN;
+	cord_t y_min = LV_CORD_MAX;
+	cord_t y_max = LV_CORD_MIN;
+	for(i = first; i < ext->point_num; i++) {
+		x_min = MATH_MIN(ext->point_array[i].x, x_min);
+		x_max = MATH_MAX(ext->point_array[i].x, x_max);
+		y_min = MATH_MIN(ext->point_array[i].y, y_min);
+		y_max = MATH_MAX(ext->point_array[i].y, y_max);
 	}
+
+	cord_t x_ofs = inv.x1;
+	inv.x1 = x_min * us + x_ofs - lines->width;
+	inv.x2 = x_max * us + x_ofs + lines->width;
+	if(ext->y_inv == 0) {
+		inv.y2 = y_max * us + inv.y1 + lines->width;
+		inv.y1 = y_min * us + inv.y1 - lines->width;
+	} else {
+		cord_t y_ofs = inv.y1 + h;
+		inv.y1 = y_ofs - y_max * us - lines->width;
+		inv.y2 = y_ofs - y_min * us + lines->width;
+	}
+
+	lv_obj_inv_area(line, &inv);
 }
 
 /**
@@ -321,8 +390,34 @@ static bool lv_line_design(lv_obj_t * line, const area_t * mask, lv_design_mode_
 			us = LV_DOWNSCALE;
 		}
 
-		/*Read all pints and draw the lines*/
-		for (i = 0; i < ext->point_num - 1; i++) {
+		/*The segments farther than this from the mask are not drawn*/
+		area_t clip;
+		clip.x1 = mask->x1 - lines->width;
+		clip.y1 = mask->y1 - lines->width;
+		clip.x2 = mask->x2 + lines->width;
+		clip.y2 = mask->y2 + lines->width;
+
+		/*Read all points and draw the lines on the mask*/
+		uint16_t seg_num = ext->point_num - 1;
+		for (i = 0; i < seg_num; i++) {
+			/*Skip the whole group of segments if it's not on the mask (e.g. in an other VDB stripe)*/
+			if(ext->blocks != NULL && (i % LV_LINE_BLOCK_SEG) == 0) {
+				lv_line_block_t * block = &ext->blocks[i / LV_LINE_BLOCK_SEG];
+				cord_t y1;
+				cord_t y2;
+				if(ext->y_inv == 0) {
+					y1 = block->y_min * us + y_ofs;
+					y2 = block->y_max * us + y_ofs;
+				} else {
+					y1 = h - block->y_max * us + y_ofs;
+					y2 = h - block->y_min * us + y_ofs;
+				}
+
+				if(y1 > clip.y2 || y2 < clip.y1) {
+					i += LV_LINE_BLOCK_SEG - 1;
+					continue;
+				}
+			}
 
 			p1.x = ext->point_array[i].x * us + x_ofs;
 			p2.x = ext->point_array[i + 1].x * us + x_ofs;
@@ -334,12 +429,79 @@ static bool lv_line_design(lv_obj_t * line, const area_t * mask, lv_design_mode_
 				p1.y = h - ext->point_array[i].y * us + y_ofs;
 				p2.y = h - ext->point_array[i + 1].y * us + y_ofs;
 			}
+
+			if(MATH_MAX(p1.x, p2.x) < clip.x1 || MATH_MIN(p1.x, p2.x) > clip.x2 ||
+			   MATH_MAX(p1.y, p2.y) < clip.y1 || MATH_MIN(p1.y, p2.y) > clip.y2) continue;
+
 			lv_draw_line(&p1, &p2, mask, lines, opa);
 		}
     }
     return true;
 }
 
+/**
+ * Update the vertical ranges of the segment groups of a line.
+ * Short lines have no groups.
+ * @param line pointer to a line object
+ * @param seg_first index of the first changed segment
+ */
+static void lv_line_refr_blocks(lv_obj_t * line, uint16_t seg_first)
+{
+	lv_line_ext_t * ext = lv_obj_get_ext(line);
+	uint16_t seg_num = ext->point_num > 1 ? ext->point_num - 1 : 0;
+	uint16_t block_num = (seg_num + LV_LINE_BLOCK_SEG - 1) / LV_LINE_BLOCK_SEG;
+
+	if(block_num < 2) {
+		if(ext->blocks != NULL) dm_free(ext->blocks);
+		ext->blocks = NULL;
+		return;
+	}
+
+	if(ext->blocks == NULL) {
+		ext->blocks = dm_alloc(sizeof(lv_line_block_t) * block_num);
+		seg_first = 0;
+	} else {
+		/*Free the old blocks if they can't be reallocated (the line is drawn without them)*/
+		lv_line_block_t * new_blocks = dm_realloc(ext->blocks, sizeof(lv_line_block_t) * block_num);
+		if(new_blocks == NULL) dm_free(ext->blocks);
+		ext->blocks = new_blocks;
+	}
+	if(ext->blocks == NULL) return;     /*Draw every segment without the groups*/
+
+	uint16_t b;
+	for(b = seg_first / LV_LINE_BLOCK_SEG; b < block_num; b++) {
+		/*The segments of the block use these points*/
+		uint16_t p_first = b * LV_LINE_BLOCK_SEG;
+		uint16_t p_last = MATH_MIN(p_first + LV_LINE_BLOCK_SEG, ext->point_num - 1);
+		lv_line_block_t * block = &ext->blocks[b];
+		block->y_min = LV_CORD_MAX;
+		block->y_max = LV_CORD_MIN;
+		uint16_t i;
+		for(i = p_first; i <= p_last; i++) {
+			block->y_min = MATH_MIN(ext->point_array[i].y, block->y_min);
+			block->y_max = MATH_MAX(ext->point_array[i].y, block->y_max);
+		}
+	}
+}
+
+/**
+ * Set the size of a line to its points if auto size is enabled
+ * @param line pointer to a line object
+ */
+static void lv_line_refr_size(lv_obj_t * line)
+{
+	lv_line_ext_t * ext = lv_obj_get_ext(line);
+	if(ext->point_num == 0 || ext->auto_size == 0) return;
+
+	uint8_t us = 1;
+	if(ext->upscale != 0) {
+		us = LV_DOWNSCALE;
+	}
+
+	lv_lines_t * lines = lv_obj_get_style(line);
+	lv_obj_set_size(line, ext->x_max * us + lines->width, ext->y_max * us + lines->width);
+}
+
 /**
  * Initialize the line styles
  */
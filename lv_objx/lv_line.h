@@ -21,6 +21,12 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*Vertical range of a group of segments of a line (to skip them quickly while drawing)*/
+typedef struct
+{
+    cord_t y_min;
+    cord_t y_max;
+}lv_line_block_t;
 
 /*Data of line*/
 typedef struct
@@ -28,6 +34,9 @@ typedef struct
     /*Inherited from 'base_obj' so no inherited ext.*/  /*Ext. of ancestor*/
     const point_t * point_array;    /*Pointer to an array with the points of the line*/
     uint16_t  point_num;            /*Number of points in 'point_array' */
+    lv_line_block_t * blocks;       /*Y range of the segments in groups or NULL for short lines*/
+    cord_t x_max;                   /*Max. x of the points (not upscaled)*/
+    cord_t y_max;                   /*Max. y of the points (not upscaled)*/
     uint8_t  auto_size  :1;         /*1: set obj. width to x max and obj. height to y max */
     uint8_t  y_inv      :1;         /*1: y == 0 will be on the bottom*/
     uint8_t  upscale    :1;         /*1: upscale coordinates with LV_DOWNSCALE*/
@@ -78,6 +87,15 @@ bool lv_line_signal(lv_obj_t * line, lv_signal_t sign, void * param);
  */
 void lv_line_set_points(lv_obj_t * line, const point_t * point_a, uint16_t point_num);
 
+/**
+ * Add points to the end of a line. They have to be written already after the last point
+ * in the array set by 'lv_line_set_points'. Only the new points are processed and
+ * only the new segments are redrawn (unless the auto size changes the size).
+ * @param line pointer to a line object
+ * @param num number of new points
+ */
+void lv_line_add_points(lv_obj_t * line, uint16_t num);
+
 /**
  * Enable (or disable) the auto-size option. The size of the object will fit to its points.
  * (set width to x max and height to y max)
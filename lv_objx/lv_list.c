@@ -16,6 +16,11 @@
 /*********************
  *      DEFINES
  *********************/
+/*Test configurations*/
+#ifndef LV_LIST_VIRT_OVERSCAN
+#define LV_LIST_VIRT_OVERSCAN   2   /*Extra elements above and below the visible ones in virtual mode*/
+#endif
+
 #define LV_LIST_LAYOUT_DEF	LV_RECT_LAYOUT_COL_M
 
 /**********************
@@ -29,10 +34,15 @@
 static bool lv_list_design(lv_obj_t * list, const area_t * mask, lv_design_mode_t mode);
 #endif
 static void lv_lists_init(void);
+static bool lv_list_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void * param);
+static void lv_list_virt_refr(lv_obj_t * list, bool rebind);
+static void lv_list_virt_set_row_cnt(lv_obj_t * list, uint16_t row_cnt);
+static void lv_list_virt_bind(lv_obj_t * list, lv_obj_t * liste, uint32_t id);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_signal_f_t ancestor_scrl_signal_f;
 static lv_lists_t lv_lists_def;
 static lv_lists_t lv_lists_scrl;
 static lv_lists_t lv_lists_transp;
@@ -62,6 +72,16 @@ lv_obj_t * lv_list_create(lv_obj_t * par, lv_obj_t * copy)
     dm_assert(new_list);
     lv_list_ext_t * ext = lv_obj_alloc_ext(new_list, sizeof(lv_list_ext_t));
     dm_assert(ext);
+    ext->virt_cnt_f = NULL;
+    ext->virt_item_f = NULL;
+    ext->virt_rel_action = NULL;
+    ext->virt_rows = NULL;
+    ext->virt_cnt = 0;
+    ext->virt_base = 0;
+    ext->virt_first = 0;
+    ext->virt_row_cnt = 0;
+    ext->virt_row_h = 0;
+    ext->virt_refr = 0;
 
 	lv_obj_set_signal_f(new_list, lv_list_signal);
 
@@ -94,7 +114,21 @@ bool lv_list_signal(lv_obj_t * list, lv_signal_t sign, void * param)
     /* The object can be deleted so check its validity and then
      * make the object specific signal handling */
     if(valid != false) {
+        lv_list_ext_t * ext = lv_obj_get_ext(list);
     	switch(sign) {
+            case LV_SIGNAL_CLEANUP:
+                dm_free(ext->virt_rows);
+                ext->virt_rows = NULL;
+                ext->virt_row_cnt = 0;
+                ext->virt_cnt_f = NULL;
+                break;
+            case LV_SIGNAL_CORD_CHG:
+                /*More or less elements might be required with a new height*/
+                if(ext->virt_cnt_f != NULL &&
+                   lv_obj_get_height(list) != area_get_height(param)) {
+                    lv_list_virt_refr(list, false);
+                }
+                break;
     		default:
     			break;
     	}
@@ -155,6 +189,71 @@ lv_obj_t * lv_list_add(lv_obj_t * list, const char * img_fn, const char * txt, l
 	return liste;
 }
 
+/**
+ * Make a list virtual: only the visible items (and a few more around them) have
+ * real list elements which are reused with other items while the list is scrolled.
+ * Every element will have the height of the first item. The current elements are deleted.
+ * @param list pointer to a list object
+ * @param cnt_f function to get the number of items (NULL to turn off the virtual mode)
+ * @param item_f function to get the text and image file of an item
+ * @param rel_action release action of the elements. Use 'lv_list_get_item_id' to get the item
+ */
+void lv_list_set_virtual(lv_obj_t * list, lv_list_cnt_f_t cnt_f, lv_list_item_f_t item_f, lv_action_t rel_action)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext(list);
+    lv_obj_t * scrl = ext->page_ext.scrl;
+
+    /*Delete the current elements*/
+    lv_obj_t * liste = lv_obj_get_child(scrl, NULL);
+    while(liste != NULL) {
+        lv_obj_del(liste);
+        liste = lv_obj_get_child(scrl, NULL);
+    }
+    dm_free(ext->virt_rows);
+    ext->virt_rows = NULL;
+    ext->virt_row_cnt = 0;
+    ext->virt_row_h = 0;
+    ext->virt_base = 0;
+    ext->virt_first = 0;
+    ext->virt_cnt = 0;
+
+    ext->virt_cnt_f = cnt_f;
+    ext->virt_item_f = item_f;
+    ext->virt_rel_action = rel_action;
+
+    /*Normal list: let the scrollable object to follow the elements again*/
+    if(cnt_f == NULL) {
+        lv_rect_set_layout(scrl, LV_LIST_LAYOUT_DEF);
+        lv_rect_set_fit(scrl, true, true);
+        return;
+    }
+
+    /*The elements are positioned by the list and the scrollable object
+     * has the size of all the items, not only the live elements*/
+    lv_rect_set_layout(scrl, LV_RECT_LAYOUT_OFF);
+    lv_rect_set_fit(scrl, false, false);
+    lv_obj_set_y(scrl, 0);
+
+    /*Follow the scrolling*/
+    if(ancestor_scrl_signal_f == NULL) ancestor_scrl_signal_f = lv_obj_get_signal_f(scrl);
+    lv_obj_set_signal_f(scrl, lv_list_scrl_signal);
+
+    lv_list_virt_refr(list, true);
+}
+
+/**
+ * Refresh the items of a virtual list when its data is changed.
+ * The number of items is queried again and the visible elements are updated.
+ * @param list pointer to a virtual list object
+ */
+void lv_list_refr_virtual(lv_obj_t * list)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext(list);
+    if(ext->virt_cnt_f == NULL) return;
+
+    lv_list_virt_refr(list, true);
+}
+
 /**
  * Move the list elements up by one
  * @param list pointer a to list object
@@ -166,9 +265,13 @@ void lv_list_up(lv_obj_t * list)
 	lv_obj_t * h = lv_obj_get_parent(list);
 	lv_obj_t * e;
 	lv_obj_t * e_prev = NULL;
+	area_t e_cords;
+	area_t h_cords;
+	lv_obj_get_cords(h, &h_cords);
 	e = lv_obj_get_child(list, NULL);
 	while(e != NULL) {
-		if(e->cords.y2 <= h->cords.y2) {
+		lv_obj_get_cords(e, &e_cords);
+		if(e_cords.y2 <= h_cords.y2) {
 			if(e_prev != NULL)
 			lv_obj_set_y(list, lv_obj_get_height(h) -
 					             (lv_obj_get_y(e_prev) + lv_obj_get_height(e_prev)));
@@ -189,9 +292,13 @@ void lv_list_down(lv_obj_t * list)
 	 * and position the list to show this element on the top*/
 	lv_obj_t * h = lv_obj_get_parent(list);
 	lv_obj_t * e;
+	area_t e_cords;
+	area_t h_cords;
+	lv_obj_get_cords(h, &h_cords);
 	e = lv_obj_get_child(list, NULL);
 	while(e != NULL) {
-		if(e->cords.y1 < h->cords.y1) {
+		lv_obj_get_cords(e, &e_cords);
+		if(e_cords.y1 < h_cords.y1) {
 			lv_obj_set_y(list, -lv_obj_get_y(e));
 			break;
 		}
@@ -221,6 +328,29 @@ const char * lv_list_element_get_txt(lv_obj_t * liste)
     return lv_label_get_text(label);
 }
 
+/**
+ * Get the id of the item shown by an element of a virtual list
+ * @param list pointer to a virtual list object
+ * @param liste pointer to an element of the list (e.g. from the release action)
+ * @return the id of the item or LV_LIST_ITEM_INV if 'liste' is not a live element
+ */
+uint32_t lv_list_get_item_id(lv_obj_t * list, lv_obj_t * liste)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext(list);
+    uint16_t row_cnt = ext->virt_row_cnt;
+    uint16_t i;
+
+    for(i = 0; i < row_cnt; i++) {
+        if(ext->virt_rows[i] == liste) {
+            /*The live items are 'virt_first'... and row 'i' shows the one with 'id % row_cnt == i'*/
+            uint16_t first_row = ext->virt_first % row_cnt;
+            return ext->virt_first + (i + row_cnt - first_row) % row_cnt;
+        }
+    }
+
+    return LV_LIST_ITEM_INV;
+}
+
 /**
  * Return with a pointer to a built-in style and/or copy it to a variable
  * @param style a style name from lv_lists_builtin_t enum
@@ -290,6 +420,203 @@ static bool lv_list_design(lv_obj_t * list, const area_t * mask, lv_design_mode_
 }
 #endif
 
+/**
+ * Signal function of the scrollable part of a virtual list
+ * @param scrl pointer to the scrollable object
+ * @param sign a signal type from lv_signal_t enum
+ * @param param pointer to a signal specific variable
+ */
+static bool lv_list_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void * param)
+{
+    bool valid;
+
+    /* Include the ancient signal function */
+    valid = ancestor_scrl_signal_f(scrl, sign, param);
+
+    /*Show other items in the live elements if the list is scrolled*/
+    if(valid != false && sign == LV_SIGNAL_CORD_CHG) {
+        lv_obj_t * list = lv_obj_get_parent(scrl);
+        lv_list_ext_t * ext = lv_obj_get_ext(list);
+        if(ext->virt_cnt_f != NULL) lv_list_virt_refr(list, false);
+    }
+
+    return valid;
+}
+
+/**
+ * Refresh the live elements of a virtual list to show the items around the visible area.
+ * The scrollable object covers only a window of the items to keep the coordinates small.
+ * The window is moved when the visible area gets close to its edges.
+ * @param list pointer to a virtual list object
+ * @param rebind true: query the number of items and update every element,
+ *               false: update only the elements which got new items
+ */
+static void lv_list_virt_refr(lv_obj_t * list, bool rebind)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext(list);
+    lv_lists_t * style = lv_obj_get_style(list);
+    lv_obj_t * scrl = ext->page_ext.scrl;
+    cord_t vpad = style->bg_pages.scrl_rects.vpad;
+    cord_t opad = style->bg_pages.scrl_rects.opad;
+
+    if(ext->virt_refr != 0) return;
+    ext->virt_refr = 1;
+
+    if(rebind != false) ext->virt_cnt = ext->virt_cnt_f(list);
+
+    /*Measure the height of the elements on the first item*/
+    if(ext->virt_row_h == 0 && ext->virt_cnt != 0) {
+        lv_list_virt_set_row_cnt(list, 1);
+        lv_list_virt_bind(list, ext->virt_rows[0], 0);
+        ext->virt_row_h = lv_obj_get_height(ext->virt_rows[0]);
+        lv_rect_set_fit(ext->virt_rows[0], false, false);
+        rebind = true;
+    }
+
+    cord_t pitch = ext->virt_row_h + opad;
+    if(pitch <= 0) pitch = 1;
+
+    /*Number of live elements: the visible ones and the overscan*/
+    uint32_t row_cnt = lv_obj_get_height(list) / pitch + 2 + 2 * LV_LIST_VIRT_OVERSCAN;
+    if(row_cnt > ext->virt_cnt) row_cnt = ext->virt_cnt;
+    if(row_cnt != ext->virt_row_cnt) {
+        lv_list_virt_set_row_cnt(list, row_cnt);
+        rebind = true;
+    }
+
+    /*The items in the window of the scrollable object. Keep its height far from 'LV_CORD_MAX'*/
+    uint32_t win_cnt = (LV_CORD_MAX / 2) / pitch;
+    if(win_cnt < 2 * row_cnt) win_cnt = 2 * row_cnt;
+    if(win_cnt > ext->virt_cnt) win_cnt = ext->virt_cnt;
+    if(ext->virt_base + win_cnt > ext->virt_cnt) ext->virt_base = ext->virt_cnt - win_cnt;
+
+    cord_t scrl_h = 2 * vpad;
+    if(win_cnt != 0) scrl_h += win_cnt * pitch - opad;
+    if(lv_obj_get_height(scrl) != scrl_h) lv_obj_set_height(scrl, scrl_h);
+    if(row_cnt != 0) {
+        cord_t scrl_w = lv_obj_get_width(ext->virt_rows[0]) + 2 * style->bg_pages.scrl_rects.hpad;
+        if(lv_obj_get_width(scrl) != scrl_w) lv_obj_set_width(scrl, scrl_w);
+    }
+
+    /*The first visible item*/
+    cord_t scrl_y = lv_obj_get_y(scrl);
+    cord_t top_y = -scrl_y - vpad;
+    if(top_y < 0) top_y = 0;
+    uint32_t top_id = ext->virt_base + top_y / pitch;
+
+    /*Move the window if the visible items are close to its edges*/
+    uint32_t base_new = ext->virt_base;
+    if((top_id < ext->virt_base + win_cnt / 4 && ext->virt_base > 0) ||
+       (top_id + row_cnt > ext->virt_base + win_cnt - win_cnt / 4 &&
+        ext->virt_base + win_cnt < ext->virt_cnt)) {
+        base_new = top_id + row_cnt / 2 > win_cnt / 2 ? top_id + row_cnt / 2 - win_cnt / 2 : 0;
+        if(base_new + win_cnt > ext->virt_cnt) base_new = ext->virt_cnt - win_cnt;
+    }
+
+    /*The items to show on the live elements*/
+    uint32_t first = top_id > LV_LIST_VIRT_OVERSCAN ? top_id - LV_LIST_VIRT_OVERSCAN : 0;
+    if(first < base_new) first = base_new;
+    if(first + row_cnt > base_new + win_cnt) first = base_new + win_cnt - row_cnt;
+
+    uint32_t id;
+    for(id = first; id < first + row_cnt; id++) {
+        lv_obj_t * liste = ext->virt_rows[id % row_cnt];
+        if(rebind != false || id < ext->virt_first || id >= ext->virt_first + row_cnt) {
+            lv_list_virt_bind(list, liste, id);
+        }
+
+        cord_t y = vpad + (id - base_new) * pitch;
+        if(lv_obj_get_y(liste) != y) lv_obj_set_y(liste, y);
+    }
+    ext->virt_first = first;
+
+    /*Shift the scrollable object with the window to keep the same items visible*/
+    if(base_new != ext->virt_base) {
+        cord_t shift = ((int32_t)base_new - (int32_t)ext->virt_base) * pitch;
+        ext->virt_base = base_new;
+        lv_obj_set_y(scrl, scrl_y + shift);
+    }
+
+    ext->virt_refr = 0;
+}
+
+/**
+ * Create or delete live elements of a virtual list to have a given number of them
+ * @param list pointer to a virtual list object
+ * @param row_cnt the new number of live elements
+ */
+static void lv_list_virt_set_row_cnt(lv_obj_t * list, uint16_t row_cnt)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext(list);
+    lv_lists_t * lists = lv_obj_get_style(list);
+    uint16_t i;
+
+    /*Delete the unnecessary elements*/
+    for(i = row_cnt; i < ext->virt_row_cnt; i++) {
+        lv_obj_del(ext->virt_rows[i]);
+    }
+
+    if(row_cnt == 0) {
+        dm_free(ext->virt_rows);
+        ext->virt_rows = NULL;
+        ext->virt_row_cnt = 0;
+        return;
+    }
+
+    ext->virt_rows = dm_realloc(ext->virt_rows, row_cnt * sizeof(lv_obj_t *));
+    dm_assert(ext->virt_rows);
+
+    /*Create the new elements with a (hidden) image and a label*/
+    for(i = ext->virt_row_cnt; i < row_cnt; i++) {
+        lv_obj_t * liste = lv_list_add(list, NULL, NULL, ext->virt_rel_action);
+
+        lv_obj_t * img = lv_img_create(liste, NULL);
+        lv_obj_set_style(img, &lists->liste_imgs);
+        lv_obj_set_click(img, false);
+        lv_obj_set_hidden(img, true);
+
+        lv_obj_t * label = lv_label_create(liste, NULL);
+        lv_obj_set_style(label, &lists->liste_labels);
+        lv_obj_set_click(label, false);
+
+        /*Every element has the same height*/
+        if(ext->virt_row_h != 0) {
+            lv_rect_set_fit(liste, false, false);
+            lv_obj_set_height(liste, ext->virt_row_h);
+        }
+        ext->virt_rows[i] = liste;
+    }
+
+    ext->virt_row_cnt = row_cnt;
+}
+
+/**
+ * Show an item on a live element of a virtual list
+ * @param list pointer to a virtual list object
+ * @param liste pointer to a live element
+ * @param id id of the item to show
+ */
+static void lv_list_virt_bind(lv_obj_t * list, lv_obj_t * liste, uint32_t id)
+{
+    lv_list_ext_t * ext = lv_obj_get_ext(list);
+    const char * img_fn = NULL;
+    const char * txt = ext->virt_item_f(list, id, &img_fn);
+
+    /*The last child is the label and the image is before it*/
+    lv_obj_t * label = lv_obj_get_child(liste, NULL);
+    lv_obj_t * img = lv_obj_get_child(liste, label);
+
+    lv_label_set_text(label, txt != NULL ? txt : "");
+
+    if(img_fn != NULL) {
+        lv_img_ext_t * img_ext = lv_obj_get_ext(img);
+        if(img_ext->fn == NULL || strcmp(img_ext->fn, img_fn) != 0) lv_img_set_file(img, img_fn);
+        if(lv_obj_get_hidden(img) != false) lv_obj_set_hidden(img, false);
+    } else if(lv_obj_get_hidden(img) == false) {
+        lv_obj_set_hidden(img, true);
+    }
+}
+
 /**
  * Initialize the list styles
  */
@@ -35,15 +35,32 @@
  *      DEFINES
  *********************/
 
+#define LV_LIST_ITEM_INV    UINT32_MAX  /*Invalid item id in virtual mode*/
+
 /**********************
  *      TYPEDEFS
  **********************/
+/*Return the number of items of a virtual list*/
+typedef uint32_t (*lv_list_cnt_f_t)(lv_obj_t * list);
+
+/*Return the text of an item of a virtual list and set 'img_fn' to its image file (or NULL)*/
+typedef const char * (*lv_list_item_f_t)(lv_obj_t * list, uint32_t id, const char ** img_fn);
+
 /*Data of list*/
 typedef struct
 {
     lv_page_ext_t page_ext; /*Ext. of ancestor*/
     /*New data for this type */
-    /*No new data*/
+    lv_list_cnt_f_t virt_cnt_f;     /*Get the number of items in virtual mode (NULL: normal list)*/
+    lv_list_item_f_t virt_item_f;   /*Get the text and image of an item in virtual mode*/
+    lv_action_t virt_rel_action;    /*Release action of the rows in virtual mode*/
+    lv_obj_t ** virt_rows;          /*The live rows. Row 'i' shows the item 'id' where 'id % virt_row_cnt == i'*/
+    uint32_t virt_cnt;              /*Number of items*/
+    uint32_t virt_base;             /*Id of the item on the top of the scrollable object*/
+    uint32_t virt_first;            /*Id of the item shown by the top live row*/
+    uint16_t virt_row_cnt;          /*Number of live rows*/
+    cord_t virt_row_h;              /*Height of a row (0: not measured yet)*/
+    uint8_t virt_refr   :1;         /*1: the rows are being refreshed (avoid recursion)*/
 }lv_list_ext_t;
 
 /*Style of list*/
@@ -96,6 +113,24 @@ bool lv_list_signal(lv_obj_t * list, lv_signal_t sign, void * param);
  */
 lv_obj_t * lv_list_add(lv_obj_t * list, const char * img_fn, const char * txt, lv_action_t rel_action);
 
+/**
+ * Make a list virtual: only the visible items (and a few more around them) have
+ * real list elements which are reused with other items while the list is scrolled.
+ * Every element will have the height of the first item. The current elements are deleted.
+ * @param list pointer to a list object
+ * @param cnt_f function to get the number of items (NULL to turn off the virtual mode)
+ * @param item_f function to get the text and image file of an item
+ * @param rel_action release action of the elements. Use 'lv_list_get_item_id' to get the item
+ */
+void lv_list_set_virtual(lv_obj_t * list, lv_list_cnt_f_t cnt_f, lv_list_item_f_t item_f, lv_action_t rel_action);
+
+/**
+ * Refresh the items of a virtual list when its data is changed.
+ * The number of items is queried again and the visible elements are updated.
+ * @param list pointer to a virtual list object
+ */
+void lv_list_refr_virtual(lv_obj_t * list);
+
 /**
  * Move the list elements up by one
  * @param list pointer a to list object
@@ -115,6 +150,14 @@ void lv_list_down(lv_obj_t * list);
  */
 const char * lv_list_element_get_txt(lv_obj_t * liste);
 
+/**
+ * Get the id of the item shown by an element of a virtual list
+ * @param list pointer to a virtual list object
+ * @param liste pointer to an element of the list (e.g. from the release action)
+ * @return the id of the item or LV_LIST_ITEM_INV if 'liste' is not a live element
+ */
+uint32_t lv_list_get_item_id(lv_obj_t * list, lv_obj_t * liste);
+
 /**
  * Return with a pointer to a built-in style and/or copy it to a variable
  * @param style a style name from lv_lists_builtin_t enum
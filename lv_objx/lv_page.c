@@ -15,6 +15,7 @@
 #include "../lv_draw/lv_draw.h"
 #include "../lv_obj/lv_refr.h"
 #include "../lv_misc/anim.h"
+#include "hal/systick/systick.h"
 
 /*********************
  *      DEFINES
@@ -24,6 +25,28 @@
 #define LV_PAGE_ANIM_FOCUS_TIME     300 /*List focus animation time [ms] (0: turn off the animation)*/
 #endif
 
+#ifndef LV_PAGE_KIN_DECEL
+#define LV_PAGE_KIN_DECEL   (2000 * LV_DOWNSCALE)   /*Deceleration of kinetic scrolling [px/s^2] (0: use the drag throw of lv_dispi)*/
+#endif
+
+#ifndef LV_PAGE_ELASTIC
+#define LV_PAGE_ELASTIC     (30 * LV_DOWNSCALE)     /*Max. overscroll on the edges [px] (0: no elastic edges)*/
+#endif
+
+#ifndef LV_PAGE_SB_HIDE_DELAY
+#define LV_PAGE_SB_HIDE_DELAY   1000    /*Keep the scrollbars visible after scrolling in LV_PAGE_SB_MODE_HIDE [ms]*/
+#endif
+
+#ifndef LV_PAGE_SB_FADE_TIME
+#define LV_PAGE_SB_FADE_TIME    300     /*Fade out time of the scrollbars in LV_PAGE_SB_MODE_HIDE [ms] (0: hide without fading)*/
+#endif
+
+#define LV_PAGE_KIN_VMIN        (50 * LV_DOWNSCALE) /*Min. speed to start kinetic scrolling [px/s]*/
+#define LV_PAGE_KIN_STOP_TIME   100                 /*No kinetic scrolling if the drag was stopped for this time before release [ms]*/
+#define LV_PAGE_KIN_TIME_MAX    3000                /*Max. time of kinetic scrolling [ms]*/
+#define LV_PAGE_KIN_BACK_TIME   200                 /*Time of moving back from overscroll and snapping [ms]*/
+#define LV_PAGE_KIN_RES         256                 /*Resolution of the kinetic scrolling animations*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,6 +57,21 @@
 static void lv_page_sb_refresh(lv_obj_t * main);
 static bool lv_page_design(lv_obj_t * page, const area_t * mask, lv_design_mode_t mode);
 static bool lv_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void* param);
+static void lv_page_get_scrl_range(lv_obj_t * page, area_t * range);
+static cord_t lv_page_elastic(cord_t old_pos, cord_t new_pos, cord_t min, cord_t max, bool drag);
+static void lv_page_kin_sample(lv_obj_t * page);
+static bool lv_page_kin_start(lv_obj_t * page, bool hor);
+static cord_t lv_page_kin_snap(lv_obj_t * page, cord_t pos, bool hor);
+static void lv_page_kin_anim_x(lv_obj_t * scrl, int32_t rem);
+static void lv_page_kin_anim_y(lv_obj_t * scrl, int32_t rem);
+static void lv_page_kin_ready_x(lv_obj_t * scrl);
+static void lv_page_kin_ready_y(lv_obj_t * scrl);
+static void lv_page_kin_ready(lv_obj_t * page);
+static void lv_page_sb_hide(lv_obj_t * page);
+static void lv_page_sb_show(lv_obj_t * page);
+static void lv_page_sb_fade_anim(lv_obj_t * page, int32_t opa);
+static void lv_page_sb_fade_ready(lv_obj_t * page);
+static void lv_page_inv_sb(lv_obj_t * page, const area_t * sb);
 static void lv_pages_init(void);
 
 /**********************
@@ -76,6 +114,23 @@ lv_obj_t * lv_page_create(lv_obj_t * par, lv_obj_t * copy)
     ext->rel_action = NULL;
     ext->sbh_draw = 0;
     ext->sbv_draw = 0;
+    ext->sb_fade = OPA_COVER;
+    ext->kin_v.x = 0;
+    ext->kin_v.y = 0;
+    ext->kin_last.x = 0;
+    ext->kin_last.y = 0;
+    ext->kin_end.x = 0;
+    ext->kin_end.y = 0;
+    ext->kin_dist.x = 0;
+    ext->kin_dist.y = 0;
+    ext->kin_pos.x = 0;
+    ext->kin_pos.y = 0;
+    ext->kin_time = 0;
+    ext->snap = 0;
+    ext->drag = 0;
+    ext->scrl_free = 0;
+    ext->kin_x_run = 0;
+    ext->kin_y_run = 0;
 
     if(ancestor_design_f == NULL) ancestor_design_f = lv_obj_get_design_f(new_page);
 
@@ -85,7 +140,12 @@ lv_obj_t * lv_page_create(lv_obj_t * par, lv_obj_t * copy)
 	    ext->scrl = lv_rect_create(new_page, NULL);
 	    lv_obj_set_signal_f(ext->scrl, lv_scrl_signal);
 		lv_obj_set_drag(ext->scrl, true);
+#if LV_PAGE_KIN_DECEL == 0
 		lv_obj_set_drag_throw(ext->scrl, true);
+#else
+		lv_obj_set_drag_throw(ext->scrl, false);   /*The page makes the kinetic scrolling*/
+#endif
+		lv_obj_set_move_copy(ext->scrl, true);
 		lv_obj_set_protect(ext->scrl, LV_PROTECT_PARENT);
 		lv_rect_set_fit(ext->scrl, true, true);
 		lv_obj_set_style(ext->scrl, &pages->scrl_rects);
@@ -102,6 +162,7 @@ lv_obj_t * lv_page_create(lv_obj_t * par, lv_obj_t * copy)
 
         lv_page_set_pr_action(new_page, copy_ext->pr_action);
         lv_page_set_rel_action(new_page, copy_ext->rel_action);
+        lv_page_set_snap(new_page, copy_ext->snap);
 
 		/* Add the signal function only if 'scrolling' is created
 		 * because everything has to be ready before any signal is received*/
@@ -156,6 +217,10 @@ bool lv_page_signal(lv_obj_t * page, lv_signal_t sign, void * param)
             	area_set_width(&ext->sbv, pages->sb_width);
             	lv_obj_set_style(ext->scrl, &pages->scrl_rects);
 
+            	/*Stop the fading of the scrollbars*/
+            	anim_del(page, (anim_fp_t) lv_page_sb_fade_anim);
+            	ext->sb_fade = OPA_COVER;
+
             	if(pages->sb_mode == LV_PAGE_SB_MODE_ON) {
             		ext->sbh_draw = 1;
             		ext->sbv_draw = 1;
@@ -172,6 +237,7 @@ bool lv_page_signal(lv_obj_t * page, lv_signal_t sign, void * param)
             	if(ext->scrl != NULL &&
                    (lv_obj_get_width(page) != area_get_width(param) ||
                     lv_obj_get_height(page) != area_get_height(param))) {
+            		lv_obj_refr_cords(ext->scrl);
             		ext->scrl->signal_f(ext->scrl, LV_SIGNAL_CORD_CHG, &ext->scrl->cords);
 
             		/*The scrolbars are important olny if they are visible now*/
@@ -220,66 +286,80 @@ static bool lv_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void* param)
 
         cord_t new_x;
         cord_t new_y;
-        bool refr_x = false;
-        bool refr_y = false;
-        area_t page_cords;
-        area_t obj_cords;
+        area_t range;
+        area_t * ori;
         lv_obj_t * page = lv_obj_get_parent(scrl);
         lv_pages_t * style = lv_obj_get_style(page);
         lv_page_ext_t * page_ext = lv_obj_get_ext(page);
-        cord_t hpad = style->bg_rects.hpad;
-        cord_t vpad = style->bg_rects.vpad;
 
         switch(sign) {
             case LV_SIGNAL_CORD_CHG:
+                /* The edges of the scrollable can not be in the page (minus hpad/vpad)
+                 * or if it's smaller than the page align it to the top left.
+                 * While dragged or scrolled it can be out a little (elastic edges)*/
+                ori = param;
+                lv_page_get_scrl_range(page, &range);
                 new_x = lv_obj_get_x(scrl);
                 new_y = lv_obj_get_y(scrl);
-                lv_obj_get_cords(scrl, &obj_cords);
-                lv_obj_get_cords(page, &page_cords);
-
-                /*scrollable width smaller then page width? -> align to left*/
-                if(area_get_width(&obj_cords) + 2 * hpad < area_get_width(&page_cords)) {
-                    if(obj_cords.x1 != page_cords.x1 + hpad) {
-                        new_x = hpad;
-                        refr_x = true;
-                    }
+                if(page_ext->scrl_free != 0) {
+                    bool drag = page_ext->drag == 0 ? false : true;
+                    new_x = lv_page_elastic(ori->x1 - page->cords.x1, new_x, range.x1, range.x2, drag);
+                    new_y = lv_page_elastic(ori->y1 - page->cords.y1, new_y, range.y1, range.y2, drag);
                 } else {
-                	/*The edges of the scrollable can not be in the page (minus hpad) */
-                    if(obj_cords.x2  < page_cords.x2 - hpad) {
-                       new_x =  area_get_width(&page_cords) - area_get_width(&obj_cords) - hpad;   /* Right align */
-                       refr_x = true;
-                    }
-                    if (obj_cords.x1 > page_cords.x1 + hpad) {
-                        new_x = hpad;  /*Left align*/
-                        refr_x = true;
-                    }
+                    new_x = MATH_MIN(MATH_MAX(new_x, range.x1), range.x2);
+                    new_y = MATH_MIN(MATH_MAX(new_y, range.y1), range.y2);
                 }
 
-                /*scrollable height smaller then page height? -> align to left*/
-                if(area_get_height(&obj_cords) + 2 * vpad < area_get_height(&page_cords)) {
-                    if(obj_cords.y1 != page_cords.y1 + vpad) {
-                        new_y = vpad;
-                        refr_y = true;
+                /*The scrollbars might be moved with the drawn content. Invalidate them there too.*/
+                if(lv_obj_get_move_copy(scrl) != false) {
+                    area_t sb_area_tmp;
+                    cord_t dx = scrl->cords.x1 - ori->x1;
+                    cord_t dy = scrl->cords.y1 - ori->y1;
+                    if(page_ext->sbh_draw != 0) {
+                        area_cpy(&sb_area_tmp, &page_ext->sbh);
+                        sb_area_tmp.x1 += page->cords.x1 + dx;
+                        sb_area_tmp.y1 += page->cords.y1 + dy;
+                        sb_area_tmp.x2 += page->cords.x1 + dx;
+                        sb_area_tmp.y2 += page->cords.y1 + dy;
+                        lv_inv_area(&sb_area_tmp);
                     }
-                } else {
-                	/*The edges of the scrollable can not be in the page (minus vpad) */
-                    if(obj_cords.y2 < page_cords.y2 - vpad) {
-                       new_y =  area_get_height(&page_cords) - area_get_height(&obj_cords) - vpad;   /* Bottom align */
-                       refr_y = true;
-                    }
-                    if (obj_cords.y1  > page_cords.y1 + vpad) {
-                        new_y = vpad;  /*Top align*/
-                        refr_y = true;
+                    if(page_ext->sbv_draw != 0) {
+                        area_cpy(&sb_area_tmp, &page_ext->sbv);
+                        sb_area_tmp.x1 += page->cords.x1 + dx;
+                        sb_area_tmp.y1 += page->cords.y1 + dy;
+                        sb_area_tmp.x2 += page->cords.x1 + dx;
+                        sb_area_tmp.y2 += page->cords.y1 + dy;
+                        lv_inv_area(&sb_area_tmp);
                     }
                 }
-                if(refr_x != false || refr_y != false) {
+
+                if(new_x != lv_obj_get_x(scrl) || new_y != lv_obj_get_y(scrl)) {
                     lv_obj_set_pos(scrl, new_x, new_y);
                 }
 
+                if(page_ext->drag != 0) lv_page_kin_sample(page);
+
+                /*Show the hidden scrollbars if scrolled*/
+                if(scrl->cords.x1 != ori->x1 || scrl->cords.y1 != ori->y1) lv_page_sb_show(page);
+
                 lv_page_sb_refresh(page);
                 break;
 
             case LV_SIGNAL_DRAG_BEGIN:
+#if LV_PAGE_KIN_DECEL != 0
+                /*Stop the kinetic scrolling and start measure the speed*/
+                anim_del(scrl, (anim_fp_t) lv_page_kin_anim_x);
+                anim_del(scrl, (anim_fp_t) lv_page_kin_anim_y);
+                page_ext->kin_x_run = 0;
+                page_ext->kin_y_run = 0;
+                page_ext->drag = 1;
+                page_ext->scrl_free = LV_PAGE_ELASTIC != 0 ? 1 : 0;
+                page_ext->kin_v.x = 0;
+                page_ext->kin_v.y = 0;
+                page_ext->kin_last.x = lv_obj_get_x(scrl);
+                page_ext->kin_last.y = lv_obj_get_y(scrl);
+                page_ext->kin_time = systick_get();
+#endif
             	if(style->sb_mode == LV_PAGE_SB_MODE_DRAG ) {
             	    cord_t sbh_pad = MATH_MAX(style->sb_width, style->bg_rects.hpad);
             	    cord_t sbv_pad = MATH_MAX(style->sb_width, style->bg_rects.vpad);
@@ -293,27 +373,21 @@ static bool lv_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void* param)
                 break;
 
             case LV_SIGNAL_DRAG_END:
-            	if(style->sb_mode == LV_PAGE_SB_MODE_DRAG) {
-				    area_t sb_area_tmp;
-				    if(page_ext->sbh_draw != 0) {
-				        area_cpy(&sb_area_tmp, &page_ext->sbh);
-				        sb_area_tmp.x1 += page->cords.x1;
-				        sb_area_tmp.y1 += page->cords.y1;
-				        sb_area_tmp.x2 += page->cords.x2;
-				        sb_area_tmp.y2 += page->cords.y2;
-				        lv_inv_area(&sb_area_tmp);
-	                    page_ext->sbh_draw = 0;
-				    }
-				    if(page_ext->sbv_draw != 0)  {
-				        area_cpy(&sb_area_tmp, &page_ext->sbv);
-				        sb_area_tmp.x1 += page->cords.x1;
-				        sb_area_tmp.y1 += page->cords.y1;
-				        sb_area_tmp.x2 += page->cords.x2;
-				        sb_area_tmp.y2 += page->cords.y2;
-				        lv_inv_area(&sb_area_tmp);
-	                    page_ext->sbv_draw = 0;
-				    }
-            	}
+#if LV_PAGE_KIN_DECEL != 0
+                /*No throw if the drag was stopped before the release*/
+                page_ext->drag = 0;
+                if(systick_elaps(page_ext->kin_time) > LV_PAGE_KIN_STOP_TIME) {
+                    page_ext->kin_v.x = 0;
+                    page_ext->kin_v.y = 0;
+                }
+
+                /*Hide the scrollbars only when the kinetic scrolling is ready*/
+                lv_page_kin_start(page, true);
+                lv_page_kin_start(page, false);
+                if(page_ext->kin_x_run != 0 || page_ext->kin_y_run != 0) break;
+                page_ext->scrl_free = 0;
+#endif
+                lv_page_sb_hide(page);
                 break;
             case LV_SIGNAL_PRESSED:
                 if(page_ext->pr_action != NULL) {
@@ -363,6 +437,17 @@ void lv_page_set_pr_action(lv_obj_t * page, lv_action_t pr_action)
 }
 
 
+/**
+ * Enable snapping: the kinetic scrolling stops with a child of the page on the top (left) edge
+ * @param page pointer to a page object
+ * @param en true: enable snapping
+ */
+void lv_page_set_snap(lv_obj_t * page, bool en)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext(page);
+    ext->snap = en == false ? 0 : 1;
+}
+
 /**
  * Glue the object to the page. After it the page can be moved (dragged) with this object too.
  * @param obj pointer to an object on a page
@@ -385,6 +470,8 @@ void lv_page_focus(lv_obj_t * page, lv_obj_t * obj, bool anim_en)
 	lv_page_ext_t * ext = lv_obj_get_ext(page);
 	lv_pages_t * style = lv_obj_get_style(page);
 
+	lv_obj_refr_cords(obj);
+	lv_obj_refr_cords(ext->scrl);
 	cord_t obj_y = obj->cords.y1 - ext->scrl->cords.y1;
 	cord_t obj_h = lv_obj_get_height(obj);
 	cord_t scrlable_y = lv_obj_get_y(ext->scrl);
@@ -521,8 +608,9 @@ static bool lv_page_design(lv_obj_t * page, const area_t * mask, lv_design_mode_
 		lv_page_ext_t * ext = lv_obj_get_ext(page);
 		lv_pages_t * style = lv_obj_get_style(page);
 		opa_t sb_opa = lv_obj_get_opa(page) * style->sb_opa /100;
+		sb_opa = (uint16_t)sb_opa * ext->sb_fade / OPA_COVER;
 
-		/*Draw the scrollbars*/
+		/*Draw the scrollbars (only if they are on the mask)*/
 		area_t sb_area;
 		if(ext->sbh_draw != 0) {
 		    /*Convert the relative coordinates to absolute*/
@@ -531,7 +619,9 @@ static bool lv_page_design(lv_obj_t * page, const area_t * mask, lv_design_mode_
             sb_area.y1 += page->cords.y1;
             sb_area.x2 += page->cords.x1;
             sb_area.y2 += page->cords.y1;
-			lv_draw_rect(&sb_area, mask, &style->sb_rects, sb_opa);
+			if(area_is_on(&sb_area, mask) != false) {
+			    lv_draw_rect(&sb_area, mask, &style->sb_rects, sb_opa);
+			}
 		}
 
 		if(ext->sbv_draw != 0) {
@@ -541,7 +631,9 @@ static bool lv_page_design(lv_obj_t * page, const area_t * mask, lv_design_mode_
             sb_area.y1 += page->cords.y1;
             sb_area.x2 += page->cords.x1;
             sb_area.y2 += page->cords.y1;
-			lv_draw_rect(&sb_area, mask, &style->sb_rects, sb_opa);
+            if(area_is_on(&sb_area, mask) != false) {
+                lv_draw_rect(&sb_area, mask, &style->sb_rects, sb_opa);
+            }
 		}
 	}
 
@@ -574,35 +666,22 @@ static void lv_page_sb_refresh(lv_obj_t * page)
 
     if(style->sb_mode == LV_PAGE_SB_MODE_OFF) return;
 
+    lv_obj_refr_cords(page);
+
     if(style->sb_mode == LV_PAGE_SB_MODE_ON) {
         page_ext->sbh_draw = 1;
         page_ext->sbv_draw = 1;
     }
 
     /*Invalidate the current (old) scrollbar areas*/
-    area_t sb_area_tmp;
-    if(page_ext->sbh_draw != 0) {
-        area_cpy(&sb_area_tmp, &page_ext->sbh);
-        sb_area_tmp.x1 += page->cords.x1;
-        sb_area_tmp.y1 += page->cords.y1;
-        sb_area_tmp.x2 += page->cords.x2;
-        sb_area_tmp.y2 += page->cords.y2;
-        lv_inv_area(&sb_area_tmp);
-    }
-    if(page_ext->sbv_draw != 0)  {
-        area_cpy(&sb_area_tmp, &page_ext->sbv);
-        sb_area_tmp.x1 += page->cords.x1;
-        sb_area_tmp.y1 += page->cords.y1;
-        sb_area_tmp.x2 += page->cords.x2;
-        sb_area_tmp.y2 += page->cords.y2;
-        lv_inv_area(&sb_area_tmp);
-    }
+    if(page_ext->sbh_draw != 0) lv_page_inv_sb(page, &page_ext->sbh);
+    if(page_ext->sbv_draw != 0) lv_page_inv_sb(page, &page_ext->sbv);
 
     /*Horizontal scrollbar*/
     if(scrl_w <= obj_w - 2 * hpad) {        /*Full sized scroll bar*/
         area_set_width(&page_ext->sbh, obj_w - 2 * sbh_pad);
         area_set_pos(&page_ext->sbh, sbh_pad, obj_h - style->sb_width);
-        if(style->sb_mode == LV_PAGE_SB_MODE_AUTO)  page_ext->sbh_draw = 0;
+        if(style->sb_mode == LV_PAGE_SB_MODE_AUTO || style->sb_mode == LV_PAGE_SB_MODE_HIDE) page_ext->sbh_draw = 0;
     } else {
         size_tmp = (obj_w * (obj_w - (2 * sbh_pad))) / (scrl_w + 2 * hpad);
         area_set_width(&page_ext->sbh,  size_tmp);
@@ -618,7 +697,7 @@ static void lv_page_sb_refresh(lv_obj_t * page)
     if(scrl_h <= obj_h - 2 * vpad) {        /*Full sized scroll bar*/
         area_set_height(&page_ext->sbv,  obj_h - 2 * sbv_pad);
         area_set_pos(&page_ext->sbv, obj_w - style->sb_width, sbv_pad);
-        if(style->sb_mode == LV_PAGE_SB_MODE_AUTO)  page_ext->sbv_draw = 0;
+        if(style->sb_mode == LV_PAGE_SB_MODE_AUTO || style->sb_mode == LV_PAGE_SB_MODE_HIDE) page_ext->sbv_draw = 0;
     } else {
         size_tmp = (obj_h * (obj_h - (2 * sbv_pad))) / (scrl_h + 2 * vpad);
         area_set_height(&page_ext->sbv,  size_tmp);
@@ -632,22 +711,424 @@ static void lv_page_sb_refresh(lv_obj_t * page)
     }
 
     /*Invalidate the new scrollbar areas*/
-    if(page_ext->sbh_draw != 0) {
-        area_cpy(&sb_area_tmp, &page_ext->sbh);
-        sb_area_tmp.x1 += page->cords.x1;
-        sb_area_tmp.y1 += page->cords.y1;
-        sb_area_tmp.x2 += page->cords.x2;
-        sb_area_tmp.y2 += page->cords.y2;
-        lv_inv_area(&sb_area_tmp);
+    if(page_ext->sbh_draw != 0) lv_page_inv_sb(page, &page_ext->sbh);
+    if(page_ext->sbv_draw != 0) lv_page_inv_sb(page, &page_ext->sbv);
+}
+
+/**
+ * Get the valid position range of the scrollable object of a page.
+ * The edges of the scrollable can not be in the page (minus hpad/vpad)
+ * and a smaller scrollable is aligned to the top left.
+ * @param page pointer to a page object
+ * @param range store the min. (x1, y1) and max. (x2, y2) position of the scrollable here
+ */
+static void lv_page_get_scrl_range(lv_obj_t * page, area_t * range)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext(page);
+    lv_pages_t * style = lv_obj_get_style(page);
+    cord_t hpad = style->bg_rects.hpad;
+    cord_t vpad = style->bg_rects.vpad;
+    cord_t page_w = lv_obj_get_width(page);
+    cord_t page_h = lv_obj_get_height(page);
+    cord_t scrl_w = lv_obj_get_width(ext->scrl);
+    cord_t scrl_h = lv_obj_get_height(ext->scrl);
+
+    range->x2 = hpad;
+    range->y2 = vpad;
+
+    if(scrl_w + 2 * hpad < page_w) range->x1 = hpad;
+    else range->x1 = page_w - scrl_w - hpad;
+
+    if(scrl_h + 2 * vpad < page_h) range->y1 = vpad;
+    else range->y1 = page_h - scrl_h - vpad;
+}
+
+/**
+ * Limit the position of the scrollable on an axis if it's out of the page (elastic edges)
+ * @param old_pos the previous position
+ * @param new_pos the new position
+ * @param min the min. valid position
+ * @param max the max. valid position
+ * @param drag true: the scrollable is dragged, resist when it goes out
+ * @return the limited position
+ */
+static cord_t lv_page_elastic(cord_t old_pos, cord_t new_pos, cord_t min, cord_t max, bool drag)
+{
+    /*Move out only with the half of the drag*/
+    if(drag != false) {
+        if(new_pos > max && new_pos > old_pos) {
+            cord_t from = MATH_MAX(old_pos, max);
+            new_pos = from + (new_pos - from) / 2;
+        } else if(new_pos < min && new_pos < old_pos) {
+            cord_t from = MATH_MIN(old_pos, min);
+            new_pos = from + (new_pos - from) / 2;
+        }
+    }
+
+    if(new_pos > max + LV_PAGE_ELASTIC) new_pos = max + LV_PAGE_ELASTIC;
+    if(new_pos < min - LV_PAGE_ELASTIC) new_pos = min - LV_PAGE_ELASTIC;
+
+    return new_pos;
+}
+
+/**
+ * Measure the speed of the scrollable while it is dragged
+ * @param page pointer to a page object
+ */
+static void lv_page_kin_sample(lv_obj_t * page)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext(page);
+    uint32_t t = systick_elaps(ext->kin_time);
+
+    /*Skip the nested position corrections*/
+    if(t == 0) return;
+
+    cord_t x = lv_obj_get_x(ext->scrl);
+    cord_t y = lv_obj_get_y(ext->scrl);
+    int32_t vx = ((int32_t)x - ext->kin_last.x) * 1000 / (int32_t)t;
+    int32_t vy = ((int32_t)y - ext->kin_last.y) * 1000 / (int32_t)t;
+
+    /*Average with the previous speed to filter the noise, but forget it after a pause*/
+    if(t < LV_PAGE_KIN_STOP_TIME) {
+        vx = (vx + ext->kin_v.x) / 2;
+        vy = (vy + ext->kin_v.y) / 2;
+    }
+
+    ext->kin_v.x = MATH_MIN(MATH_MAX(vx, LV_CORD_MIN), LV_CORD_MAX);
+    ext->kin_v.y = MATH_MIN(MATH_MAX(vy, LV_CORD_MIN), LV_CORD_MAX);
+    ext->kin_last.x = x;
+    ext->kin_last.y = y;
+    ext->kin_time = systick_get();
+}
+
+/**
+ * Start the kinetic scrolling on an axis: decelerate from the measured speed,
+ * move back from the overscroll and snap to a child if enabled.
+ * @param page pointer to a page object
+ * @param hor true: horizontal, false: vertical axis
+ * @return true: the scrolling is started, false: the scrollable is already at its end position
+ */
+static bool lv_page_kin_start(lv_obj_t * page, bool hor)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext(page);
+    lv_obj_t * scrl = ext->scrl;
+    area_t range;
+    lv_page_get_scrl_range(page, &range);
+
+    cord_t min = hor != false ? range.x1 : range.y1;
+    cord_t max = hor != false ? range.x2 : range.y2;
+    cord_t pos = hor != false ? lv_obj_get_x(scrl) : lv_obj_get_y(scrl);
+    int32_t v = hor != false ? ext->kin_v.x : ext->kin_v.y;
+    bool throw = MATH_ABS(v) >= LV_PAGE_KIN_VMIN ? true : false;
+    int32_t end = pos;
+
+    /*Throw: the distance to stop with constant deceleration is v^2 / 2a*/
+    if(throw != false) {
+        end = pos + v * MATH_ABS(v) / (2 * LV_PAGE_KIN_DECEL);
+    }
+
+    if(ext->snap != 0) end = lv_page_kin_snap(page, MATH_MIN(MATH_MAX(end, min), max), hor);
+
+    /*Thrown out: stop a little behind the edge (then move back)*/
+    if(throw != false) {
+        if(end > max) end = max + MATH_MIN((end - max) / 4, LV_PAGE_ELASTIC);
+        if(end < min) end = min - MATH_MIN((min - end) / 4, LV_PAGE_ELASTIC);
+    } else {
+        end = MATH_MIN(MATH_MAX(end, min), max);
+    }
+
+    if(end == pos) return false;
+
+    /*Start with the measured speed or move back with a fix time*/
+    int32_t time;
+    if(throw != false) {
+        time = MATH_ABS(end - pos) * 2000 / MATH_ABS(v);
+        if(time > LV_PAGE_KIN_TIME_MAX) time = LV_PAGE_KIN_TIME_MAX;
+        if(time == 0) time = 1;
+    } else {
+        time = LV_PAGE_KIN_BACK_TIME;
+    }
+
+    anim_t a;
+    a.var = scrl;
+    a.start = LV_PAGE_KIN_RES;
+    a.end = 0;
+    a.time = time;
+    a.act_time = 0;
+    a.playback = 0;
+    a.repeat = 0;
+    a.playback_pause = 0;
+    a.repeat_pause = 0;
+    a.path = anim_get_path(ANIM_PATH_LIN);
+
+    if(hor != false) {
+        ext->kin_end.x = end;
+        ext->kin_dist.x = end - pos;
+        ext->kin_pos.x = pos;
+        ext->kin_x_run = 1;
+        a.fp = (anim_fp_t) lv_page_kin_anim_x;
+        a.end_cb = (anim_cb_t) lv_page_kin_ready_x;
+    } else {
+        ext->kin_end.y = end;
+        ext->kin_dist.y = end - pos;
+        ext->kin_pos.y = pos;
+        ext->kin_y_run = 1;
+        a.fp = (anim_fp_t) lv_page_kin_anim_y;
+        a.end_cb = (anim_cb_t) lv_page_kin_ready_y;
+    }
+
+    anim_del(scrl, a.fp);
+    anim_create(&a);
+
+    return true;
+}
+
+/**
+ * Get the position where a child of the page is on the top (left) edge
+ * or the scrollable is on its end
+ * @param page pointer to a page object
+ * @param pos position of the scrollable without snapping (in the valid range)
+ * @param hor true: horizontal, false: vertical axis
+ * @return the snapped position nearest to 'pos'
+ */
+static cord_t lv_page_kin_snap(lv_obj_t * page, cord_t pos, bool hor)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext(page);
+    lv_pages_t * style = lv_obj_get_style(page);
+    lv_obj_t * scrl = ext->scrl;
+    cord_t pad = hor != false ? style->bg_rects.hpad : style->bg_rects.vpad;
+    area_t range;
+    lv_page_get_scrl_range(page, &range);
+
+    /*The ends of the scrollable are always valid positions*/
+    cord_t min = hor != false ? range.x1 : range.y1;
+    cord_t max = hor != false ? range.x2 : range.y2;
+    cord_t snap = MATH_ABS(pos - min) < MATH_ABS(pos - max) ? min : max;
+    int32_t diff_min = MATH_ABS(snap - pos);
+
+    lv_obj_t * child;
+    LL_READ(scrl->child_ll, child) {
+        if(lv_obj_get_hidden(child) != false) continue;
+
+        cord_t child_pos = hor != false ? lv_obj_get_x(child) : lv_obj_get_y(child);
+        cord_t snap_act = pad - child_pos;
+        if(snap_act < min || snap_act > max) continue;
+
+        int32_t diff = MATH_ABS(snap_act - pos);
+        if(diff < diff_min) {
+            diff_min = diff;
+            snap = snap_act;
+        }
+    }
+
+    return snap;
+}
+
+/**
+ * Horizontal kinetic scrolling animator: decelerate with a constant rate.
+ * Move the scrollable by the change of the animated position to keep
+ * the moves of others (e.g. the window shift of virtual lists).
+ * @param scrl pointer to the scrollable object of a page
+ * @param rem remaining part of the time (LV_PAGE_KIN_RES -> 0)
+ */
+static void lv_page_kin_anim_x(lv_obj_t * scrl, int32_t rem)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext(lv_obj_get_parent(scrl));
+    cord_t x = ext->kin_end.x - (int32_t)ext->kin_dist.x * rem * rem / (LV_PAGE_KIN_RES * LV_PAGE_KIN_RES);
+    cord_t d = x - ext->kin_pos.x;
+
+#if LV_DOWNSCALE > 1
+    /*Move with whole display pixels to be able to move the drawn content*/
+    if(rem != 0) d -= d % LV_DOWNSCALE;
+#endif
+
+    if(d == 0) return;
+    ext->kin_pos.x += d;
+    lv_obj_set_x(scrl, lv_obj_get_x(scrl) + d);
+}
+
+/**
+ * Vertical kinetic scrolling animator: decelerate with a constant rate.
+ * Move the scrollable by the change of the animated position to keep
+ * the moves of others (e.g. the window shift of virtual lists).
+ * @param scrl pointer to the scrollable object of a page
+ * @param rem remaining part of the time (LV_PAGE_KIN_RES -> 0)
+ */
+static void lv_page_kin_anim_y(lv_obj_t * scrl, int32_t rem)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext(lv_obj_get_parent(scrl));
+    cord_t y = ext->kin_end.y - (int32_t)ext->kin_dist.y * rem * rem / (LV_PAGE_KIN_RES * LV_PAGE_KIN_RES);
+    cord_t d = y - ext->kin_pos.y;
+
+#if LV_DOWNSCALE > 1
+    /*Move with whole display pixels to be able to move the drawn content*/
+    if(rem != 0) d -= d % LV_DOWNSCALE;
+#endif
+
+    if(d == 0) return;
+    ext->kin_pos.y += d;
+    lv_obj_set_y(scrl, lv_obj_get_y(scrl) + d);
+}
+
+/**
+ * Called when the horizontal kinetic scrolling is ready
+ * @param scrl pointer to the scrollable object of a page
+ */
+static void lv_page_kin_ready_x(lv_obj_t * scrl)
+{
+    lv_obj_t * page = lv_obj_get_parent(scrl);
+    lv_page_ext_t * ext = lv_obj_get_ext(page);
+    ext->kin_x_run = 0;
+    ext->kin_v.x = 0;
+
+    /*Move back if stopped out of the page*/
+    if(lv_page_kin_start(page, true) == false) lv_page_kin_ready(page);
+}
+
+/**
+ * Called when the vertical kinetic scrolling is ready
+ * @param scrl pointer to the scrollable object of a page
+ */
+static void lv_page_kin_ready_y(lv_obj_t * scrl)
+{
+    lv_obj_t * page = lv_obj_get_parent(scrl);
+    lv_page_ext_t * ext = lv_obj_get_ext(page);
+    ext->kin_y_run = 0;
+    ext->kin_v.y = 0;
+
+    /*Move back if stopped out of the page*/
+    if(lv_page_kin_start(page, false) == false) lv_page_kin_ready(page);
+}
+
+/**
+ * Finish the kinetic scrolling if it's ready on both axes
+ * @param page pointer to a page object
+ */
+static void lv_page_kin_ready(lv_obj_t * page)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext(page);
+    if(ext->kin_x_run != 0 || ext->kin_y_run != 0) return;
+
+    ext->scrl_free = 0;
+    lv_page_sb_hide(page);
+}
+
+/**
+ * Hide the scrollbars after dragging in 'LV_PAGE_SB_MODE_DRAG' mode
+ * or start to fade them out later in 'LV_PAGE_SB_MODE_HIDE' mode
+ * @param page pointer to a page object
+ */
+static void lv_page_sb_hide(lv_obj_t * page)
+{
+    lv_page_ext_t * page_ext = lv_obj_get_ext(page);
+    lv_pages_t * style = lv_obj_get_style(page);
+
+    if(style->sb_mode == LV_PAGE_SB_MODE_DRAG) {
+        if(page_ext->sbh_draw != 0) {
+            lv_page_inv_sb(page, &page_ext->sbh);
+            page_ext->sbh_draw = 0;
+        }
+        if(page_ext->sbv_draw != 0)  {
+            lv_page_inv_sb(page, &page_ext->sbv);
+            page_ext->sbv_draw = 0;
+        }
+    } else if(style->sb_mode == LV_PAGE_SB_MODE_HIDE) {
+        /*Restart the delay when the dragging or kinetic scrolling is ready*/
+        if(page_ext->sbh_draw != 0 || page_ext->sbv_draw != 0) lv_page_sb_show(page);
     }
-    if(page_ext->sbv_draw != 0)  {
-        area_cpy(&sb_area_tmp, &page_ext->sbv);
-        sb_area_tmp.x1 += page->cords.x1;
-        sb_area_tmp.y1 += page->cords.y1;
-        sb_area_tmp.x2 += page->cords.x2;
-        sb_area_tmp.y2 += page->cords.y2;
-        lv_inv_area(&sb_area_tmp);
+}
+
+/**
+ * Show the scrollbars of the scrollable directions in 'LV_PAGE_SB_MODE_HIDE' mode
+ * and fade them out after 'LV_PAGE_SB_HIDE_DELAY'
+ * @param page pointer to a page object
+ */
+static void lv_page_sb_show(lv_obj_t * page)
+{
+    lv_page_ext_t * page_ext = lv_obj_get_ext(page);
+    lv_pages_t * style = lv_obj_get_style(page);
+
+    if(style->sb_mode != LV_PAGE_SB_MODE_HIDE) return;
+
+    /*Redraw the fading scrollbars with full opacity*/
+    if(page_ext->sb_fade != OPA_COVER) {
+        page_ext->sb_fade = OPA_COVER;
+        if(page_ext->sbh_draw != 0) lv_page_inv_sb(page, &page_ext->sbh);
+        if(page_ext->sbv_draw != 0) lv_page_inv_sb(page, &page_ext->sbv);
     }
+
+    /*'lv_page_sb_refresh' will invalidate the newly shown ones*/
+    if(lv_obj_get_width(page_ext->scrl) > lv_obj_get_width(page) - 2 * style->bg_rects.hpad) {
+        page_ext->sbh_draw = 1;
+    }
+    if(lv_obj_get_height(page_ext->scrl) > lv_obj_get_height(page) - 2 * style->bg_rects.vpad) {
+        page_ext->sbv_draw = 1;
+    }
+
+    /*(Re)start the fading out after the delay*/
+    anim_t a;
+    a.var = page;
+    a.start = OPA_COVER;
+    a.end = OPA_TRANSP;
+    a.fp = (anim_fp_t) lv_page_sb_fade_anim;
+    a.end_cb = (anim_cb_t) lv_page_sb_fade_ready;
+    a.time = LV_PAGE_SB_FADE_TIME;
+    a.act_time = -LV_PAGE_SB_HIDE_DELAY;
+    a.playback = 0;
+    a.repeat = 0;
+    a.playback_pause = 0;
+    a.repeat_pause = 0;
+    a.path = anim_get_path(ANIM_PATH_LIN);
+
+    anim_del(page, a.fp);
+    anim_create(&a);
+}
+
+/**
+ * Fade animator of the scrollbars in 'LV_PAGE_SB_MODE_HIDE' mode. Redraws only the scrollbars.
+ * @param page pointer to a page object
+ * @param opa opacity of the scrollbars relative to their style (OPA_TRANSP..OPA_COVER)
+ */
+static void lv_page_sb_fade_anim(lv_obj_t * page, int32_t opa)
+{
+    lv_page_ext_t * page_ext = lv_obj_get_ext(page);
+    if(page_ext->sb_fade == opa) return;
+
+    page_ext->sb_fade = opa;
+    if(page_ext->sbh_draw != 0) lv_page_inv_sb(page, &page_ext->sbh);
+    if(page_ext->sbv_draw != 0) lv_page_inv_sb(page, &page_ext->sbv);
+}
+
+/**
+ * Called when the scrollbars are faded out in 'LV_PAGE_SB_MODE_HIDE' mode
+ * @param page pointer to a page object
+ */
+static void lv_page_sb_fade_ready(lv_obj_t * page)
+{
+    lv_page_ext_t * page_ext = lv_obj_get_ext(page);
+
+    if(page_ext->sbh_draw != 0) lv_page_inv_sb(page, &page_ext->sbh);
+    if(page_ext->sbv_draw != 0) lv_page_inv_sb(page, &page_ext->sbv);
+    page_ext->sbh_draw = 0;
+    page_ext->sbv_draw = 0;
+    page_ext->sb_fade = OPA_COVER;
+}
+
+/**
+ * Invalidate the area of a scrollbar of a page
+ * @param page pointer to a page object
+ * @param sb area of the scrollbar relative to the page ('sbh' or 'sbv' of the page)
+ */
+static void lv_page_inv_sb(lv_obj_t * page, const area_t * sb)
+{
+    area_t sb_area;
+    lv_obj_get_cords(page, &sb_area);
+    sb_area.x2 = sb_area.x1 + sb->x2;
+    sb_area.y2 = sb_area.y1 + sb->y2;
+    sb_area.x1 += sb->x1;
+    sb_area.y1 += sb->y1;
+
+    lv_obj_inv_area(page, &sb_area);
 }
 
 /**
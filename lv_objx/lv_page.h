@@ -38,8 +38,20 @@ typedef struct
     lv_action_t pr_action;      /*Press action*/
     area_t sbh;                 /*Horizontal scrollbar area (relative to the page) */
     area_t sbv;                 /*Vertical scrollbar area (relative to the page)*/
+    point_t kin_v;              /*Speed of the scrollable while dragged [px/s]*/
+    point_t kin_last;           /*Last position of the scrollable while dragged*/
+    point_t kin_end;            /*End position of the kinetic scrolling*/
+    point_t kin_dist;           /*Distance of the kinetic scrolling*/
+    point_t kin_pos;            /*Position set by the last kinetic step (others can move the scrollable meanwhile)*/
+    uint32_t kin_time;          /*Time stamp of 'kin_last'*/
     uint8_t sbh_draw :1;        /*1: horizontal scrollbar is visible now*/
     uint8_t sbv_draw :1;        /*1: vertical scrollbar is visible now*/
+    opa_t sb_fade;              /*Opacity of the scrollbars while they fade out in LV_PAGE_SB_MODE_HIDE (OPA_COVER: not faded)*/
+    uint8_t snap     :1;        /*1: stop the scrolling with a child on the top left corner*/
+    uint8_t drag     :1;        /*1: the scrollable is being dragged*/
+    uint8_t scrl_free:1;        /*1: the scrollable can be out of the page (elastic edges)*/
+    uint8_t kin_x_run:1;        /*1: horizontal kinetic scrolling is in progress*/
+    uint8_t kin_y_run:1;        /*1: vertical kinetic scrolling is in progress*/
 }lv_page_ext_t;
 
 /*Scrollbar modes: shows when should the scrollbars be visible*/
@@ -49,6 +61,7 @@ typedef enum
 	LV_PAGE_SB_MODE_ON,     /*Always show scrollbars*/
 	LV_PAGE_SB_MODE_DRAG,   /*Show scrollbars when page is being dragged*/
     LV_PAGE_SB_MODE_AUTO,   /*Show scrollbars when the scrollable rect. is large enough to be scrolled*/
+    LV_PAGE_SB_MODE_HIDE,   /*Show scrollbars when the page is scrolled and fade them out after a while*/
 }lv_page_sb_mode_t;
 
 /*Style of page*/
@@ -105,6 +118,13 @@ void lv_page_set_rel_action(lv_obj_t * page, lv_action_t rel_action);
  */
 void lv_page_set_pr_action(lv_obj_t * page, lv_action_t pr_action);
 
+/**
+ * Enable snapping: the kinetic scrolling stops with a child of the page on the top (left) edge
+ * @param page pointer to a page object
+ * @param en true: enable snapping
+ */
+void lv_page_set_snap(lv_obj_t * page, bool en);
+
 /**
  * Glue the object to the page. After it the page can be moved (dragged) with this object too.
  * @param obj pointer to an object on a page
@@ -13,6 +13,7 @@
 
 #include "lv_pb.h"
 #include "../lv_draw/lv_draw.h"
+#include "misc/math/math_base.h"
 #include <stdio.h>
 
 /*********************
@@ -29,6 +30,8 @@
  *  STATIC PROTOTYPES
  **********************/
 static bool lv_pb_design(lv_obj_t * pb, const area_t * mask, lv_design_mode_t mode);
+static void lv_pb_get_bar_area(lv_obj_t * pb, uint16_t value, area_t * area_p);
+static void lv_pb_inv_bar(lv_obj_t * pb, uint16_t value_old, uint16_t value_new);
 static void lv_pbs_init(void);
 
 /**********************
@@ -157,13 +160,20 @@ bool lv_pb_signal(lv_obj_t * pb, lv_signal_t sign, void * param)
 void lv_pb_set_value(lv_obj_t * pb, uint16_t value)
 {
 	lv_pb_ext_t * ext = lv_obj_get_ext(pb);
+	uint16_t value_old = ext->act_value;
 	ext->act_value = value > ext->max_value ? ext->max_value : value;
 
+	/*Set the text only if it's changed to not redraw the label in vain*/
 	char buf[LV_PB_TXT_MAX_LENGTH];
 	sprintf(buf, ext->format_str, ext->act_value);
-	lv_label_set_text(ext->label, buf);
+	if(strcmp(buf, lv_label_get_text(ext->label)) != 0) {
+		lv_label_set_text(ext->label, buf);
+	}
 
-	lv_obj_inv(pb);
+	/*Redraw only the changed part of the bar*/
+	if(value_old != ext->act_value) {
+		lv_pb_inv_bar(pb, value_old, ext->act_value);
+	}
 }
 
 /**
@@ -274,27 +284,86 @@ static bool lv_pb_design(lv_obj_t * pb, const area_t * mask, lv_design_mode_t mo
 
 		lv_pb_ext_t * ext = lv_obj_get_ext(pb);
 		area_t bar_area;
-		uint32_t tmp;
-		area_cpy(&bar_area, &pb->cords);
-
-		cord_t w = lv_obj_get_width(pb);
-        cord_t h = lv_obj_get_height(pb);
-
-		if(w >= h) {
-            tmp = (uint32_t)ext->act_value * w;
-            tmp = (uint32_t) tmp / (ext->max_value - ext->min_value);
-            bar_area.x2 = bar_area.x1 + (cord_t) tmp;
-		} else {
-            tmp = (uint32_t)ext->act_value * h;
-            tmp = (uint32_t) tmp / (ext->max_value - ext->min_value);
-            bar_area.y1 = bar_area.y2 - (cord_t) tmp;
-		}
+		lv_pb_get_bar_area(pb, ext->act_value, &bar_area);
+
 		lv_pbs_t * style_p = lv_obj_get_style(pb);
 		lv_draw_rect(&bar_area, mask, &style_p->bar, OPA_COVER);
     }
     return true;
 }
 
+/**
+ * Get the area of the bar of a progress bar with a given value
+ * @param pb pointer to a progress bar object
+ * @param value the value to get the bar for
+ * @param area_p store the area of the bar here
+ */
+static void lv_pb_get_bar_area(lv_obj_t * pb, uint16_t value, area_t * area_p)
+{
+	lv_pb_ext_t * ext = lv_obj_get_ext(pb);
+	uint32_t tmp;
+	lv_obj_get_cords(pb, area_p);
+
+	cord_t w = area_get_width(area_p);
+	cord_t h = area_get_height(area_p);
+
+	if(w >= h) {
+		tmp = (uint32_t)value * w;
+		tmp = (uint32_t) tmp / (ext->max_value - ext->min_value);
+		area_p->x2 = area_p->x1 + (cord_t) tmp;
+	} else {
+		tmp = (uint32_t)value * h;
+		tmp = (uint32_t) tmp / (ext->max_value - ext->min_value);
+		area_p->y1 = area_p->y2 - (cord_t) tmp;
+	}
+}
+
+/**
+ * Invalidate the part of a progress bar which is changed between two values:
+ * the bar segment between the old and new end and the rounded end of the shorter bar.
+ * @param pb pointer to a progress bar object
+ * @param value_old the drawn value
+ * @param value_new the new value
+ */
+static void lv_pb_inv_bar(lv_obj_t * pb, uint16_t value_old, uint16_t value_new)
+{
+	lv_pbs_t * style = lv_obj_get_style(pb);
+	area_t short_a;
+	area_t long_a;
+	lv_pb_get_bar_area(pb, MATH_MIN(value_old, value_new), &short_a);
+	lv_pb_get_bar_area(pb, MATH_MAX(value_old, value_new), &long_a);
+
+	bool hor = lv_obj_get_width(pb) >= lv_obj_get_height(pb) ? true : false;
+	/*The border of a bar shorter than the border width is drawn out of the bar*/
+	if(hor) long_a.x2 = MATH_MAX(long_a.x2, long_a.x1 + style->bar.bwidth);
+	else long_a.y1 = MATH_MIN(long_a.y1, long_a.y2 - style->bar.bwidth);
+
+	cord_t thick = hor ? area_get_height(&short_a) : area_get_width(&short_a);
+	cord_t len = hor ? area_get_width(&short_a) : area_get_height(&short_a);
+
+	/*The radius is limited by the thickness of the bar (see 'lv_draw_rect')*/
+	cord_t r = style->bar.round;
+	if(r >= (thick >> 1)) {
+		r = thick >> 1;
+		if(r != 0) r--;
+	}
+
+	/*If the radius of the shorter bar is limited by its length too then its shape is changed.
+	 *Same if the vertical gradient is stretched to the new height. Invalidate the whole longer bar.*/
+	if(r >= (len >> 1) ||
+	   (hor == false && style->bar.objs.color.full != style->bar.gcolor.full)) {
+		lv_obj_inv_area(pb, &long_a);
+		return;
+	}
+
+	/*Else the rounded end of the shorter bar and its border is changed too*/
+	cord_t pad = MATH_MAX(r, style->bar.bwidth);
+	if(hor) long_a.x1 = MATH_MAX(long_a.x1, short_a.x2 - pad);
+	else long_a.y2 = MATH_MIN(long_a.y2, short_a.y1 + pad);
+
+	lv_obj_inv_area(pb, &long_a);
+}
+
 /**
  * Initialize the progess bar styles
  */
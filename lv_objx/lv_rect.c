@@ -126,19 +126,26 @@ bool lv_rect_signal(lv_obj_t * rect, lv_signal_t sign, void * param)
 
     	switch(sign) {
     	case LV_SIGNAL_STYLE_CHG: /*Recalculate the padding if the style changed*/
-        	lv_rect_refr_layout(rect);
-        	lv_rect_refr_autofit(rect);
+    	    if(lv_obj_trans_defer(rect) == false) {
+    	        lv_rect_refr_layout(rect);
+    	        lv_rect_refr_autofit(rect);
+    	    }
         	lv_obj_refr_ext_size(rect);
         	break;
         case LV_SIGNAL_CHILD_CHG:
-        	lv_rect_refr_layout(rect);
-        	lv_rect_refr_autofit(rect);
+            /*In a transaction the layout is refreshed only once at commit*/
+            if(lv_obj_trans_defer(rect) == false) {
+                lv_rect_refr_layout(rect);
+                lv_rect_refr_autofit(rect);
+            }
         	break;
         case LV_SIGNAL_CORD_CHG:
         	if(lv_obj_get_width(rect) != area_get_width(param) ||
     		  lv_obj_get_height(rect) != area_get_height(param)) {
-            	lv_rect_refr_layout(rect);
-            	lv_rect_refr_autofit(rect);
+        	    if(lv_obj_trans_defer(rect) == false) {
+        	        lv_rect_refr_layout(rect);
+        	        lv_rect_refr_autofit(rect);
+        	    }
         	}
         	break;
         case LV_SIGNAL_REFR_EXT_SIZE:
@@ -185,8 +192,8 @@ void lv_rect_set_fit(lv_obj_t * rect, bool hor_en, bool ver_en)
 	ext->hfit_en = hor_en == false ? 0 : 1;
 	ext->vfit_en = ver_en == false ? 0 : 1;
 
-	/*Send a signal to set a new size*/
-	rect->signal_f(rect, LV_SIGNAL_CORD_CHG, rect);
+	/*Send a signal to refresh the layout and set a new size*/
+	rect->signal_f(rect, LV_SIGNAL_CHILD_CHG, NULL);
 }
 
 /*=====================
@@ -596,6 +603,7 @@ static void lv_rect_layout_pretty(lv_obj_t * rect)
 			w_row -= style->opad * obj_num;
 			cord_t new_opad = (w_obj -  w_row) / (obj_num  - 1);
 			cord_t act_x = style->hpad; /*x init*/
+			lv_obj_t * child_end = child_rc == NULL ? NULL : ll_get_prev(&rect->child_ll, child_rc); /*Align the row closer too*/
 			child_tmp = child_rs;
 			do{
 				if(lv_obj_get_hidden(child_tmp) == false &&
@@ -604,7 +612,7 @@ static void lv_rect_layout_pretty(lv_obj_t * rect)
 					act_x += lv_obj_get_width(child_tmp) + new_opad;
 				}
 				child_tmp = ll_get_prev(&rect->child_ll, child_tmp);
-			}while(child_tmp != child_rc);
+			}while(child_tmp != child_end);
 
 		}
 
@@ -683,6 +691,7 @@ static void lv_rect_refr_autofit(lv_obj_t * rect)
 	area_t ori;
 	lv_rects_t * style = lv_obj_get_style(rect);
 	lv_obj_t * i;
+	area_t child_cords;
 	cord_t hpad = style->hpad;
 	cord_t vpad = style->vpad;
 
@@ -697,10 +706,11 @@ static void lv_rect_refr_autofit(lv_obj_t * rect)
 
     LL_READ(rect->child_ll, i) {
 		if(lv_obj_get_hidden(i) != false) continue;
-    	new_cords.x1 = MATH_MIN(new_cords.x1, i->cords.x1);
-    	new_cords.y1 = MATH_MIN(new_cords.y1, i->cords.y1);
-        new_cords.x2 = MATH_MAX(new_cords.x2, i->cords.x2);
-        new_cords.y2 = MATH_MAX(new_cords.y2, i->cords.y2);
+		lv_obj_get_cords(i, &child_cords);
+    	new_cords.x1 = MATH_MIN(new_cords.x1, child_cords.x1);
+    	new_cords.y1 = MATH_MIN(new_cords.y1, child_cords.y1);
+        new_cords.x2 = MATH_MAX(new_cords.x2, child_cords.x2);
+        new_cords.y2 = MATH_MAX(new_cords.y2, child_cords.y2);
     }
 
     /*If the value is not the init value then the page has >=1 child.*/
@@ -727,7 +737,7 @@ static void lv_rect_refr_autofit(lv_obj_t * rect)
            rect->cords.y2 != new_cords.y2) {
 
             lv_obj_inv(rect);
-            area_cpy(&rect->cords, &new_cords);
+            lv_obj_set_cords(rect, &new_cords);
             lv_obj_inv(rect);
 
             /*Notify the object about its new coordinates*/
@@ -735,6 +745,7 @@ static void lv_rect_refr_autofit(lv_obj_t * rect)
 
             /*Inform the parent about the new coordinates*/
             lv_obj_t * par = lv_obj_get_parent(rect);
+            lv_dispi_hit_inv(par);
             par->signal_f(par, LV_SIGNAL_CHILD_CHG, rect);
     	}
     }
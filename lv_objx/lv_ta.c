@@ -22,6 +22,10 @@
 #define LV_TA_MAX_LENGTH    256
 #endif
 
+#if LV_TA_MAX_LENGTH > LV_TA_CUR_LAST
+#error "lv_ta: LV_TA_MAX_LENGTH can't be greater then LV_TA_CUR_LAST (32767)"
+#endif
+
 #ifndef LV_TA_CUR_BLINK_TIME
 #define LV_TA_CUR_BLINK_TIME 400    /*ms*/
 #endif
@@ -39,6 +43,8 @@
 static bool lv_ta_design(lv_obj_t * ta, const area_t * mask, lv_design_mode_t mode);
 static bool lv_ta_scrling_design(lv_obj_t * scrling, const area_t * mask, lv_design_mode_t mode);
 static void lv_ta_hide_cursor(lv_obj_t * ta, uint8_t hide);
+static void lv_ta_get_cursor_area(lv_obj_t * ta, area_t * cur_area);
+static void lv_ta_inv_cursor(lv_obj_t * ta);
 static void lv_ta_save_valid_cursor_x(lv_obj_t * ta);
 static void lv_tas_init(void);
 
@@ -197,15 +203,13 @@ void lv_ta_add_char(lv_obj_t * ta, char c)
 
 	/*Test the new length: txt length + 1 (closing'\0') + 1 (c character)*/
     if((strlen(label_txt) + 2) > LV_TA_MAX_LENGTH) return;
-    char buf[LV_TA_MAX_LENGTH];
 
-    /*Insert the character*/
-	memcpy(buf, label_txt, ext->cursor_pos);
-	buf[ext->cursor_pos] = c;
-	memcpy(buf+ext->cursor_pos+1, label_txt+ext->cursor_pos, strlen(label_txt) - ext->cursor_pos + 1);
+    /*Redraw the cursor on its old place*/
+    lv_ta_inv_cursor(ta);
 
-	/*Refresh the label*/
-	lv_label_set_text(ext->label, buf);
+    /*Insert the character in place. Only the affected lines are refreshed*/
+    char buf[2] = {c, '\0'};
+    lv_label_ins_text(ext->label, ext->cursor_pos, buf);
 
 	/*Move the cursor after the new character*/
 	lv_ta_set_cursor_pos(ta, lv_ta_get_cursor_pos(ta) + 1);
@@ -230,15 +234,11 @@ void lv_ta_add_text(lv_obj_t * ta, const char * txt)
     /*Test the new length (+ 1 for the closing '\0')*/
     if((label_len + txt_len + 1) > LV_TA_MAX_LENGTH) return;
 
-    /*Insert the text*/
-    char buf[LV_TA_MAX_LENGTH];
-
-	memcpy(buf, label_txt, ext->cursor_pos);
-	memcpy(buf + ext->cursor_pos, txt, txt_len);
-	memcpy(buf + ext->cursor_pos + txt_len, label_txt+ext->cursor_pos, label_len - ext->cursor_pos + 1);
+    /*Redraw the cursor on its old place*/
+    lv_ta_inv_cursor(ta);
 
-	/*Refresh the label*/
-	lv_label_set_text(ext->label, buf);
+    /*Insert the text in place. Only the affected lines are refreshed*/
+    lv_label_ins_text(ext->label, ext->cursor_pos, txt);
 
 	/*Move the cursor after the new text*/
 	lv_ta_set_cursor_pos(ta, lv_ta_get_cursor_pos(ta) + txt_len);
@@ -273,15 +273,11 @@ void lv_ta_del(lv_obj_t * ta)
 
 	if(cur_pos == 0) return;
 
-	/*Delete a character*/
-	char buf[LV_TA_MAX_LENGTH];
-	const char * label_txt = lv_label_get_text(ext->label);
-	uint16_t label_len = strlen(label_txt);
-	memcpy(buf, label_txt, cur_pos - 1);
-	memcpy(buf+cur_pos - 1, label_txt + cur_pos, label_len - cur_pos + 1);
+	/*Redraw the cursor on its old place*/
+	lv_ta_inv_cursor(ta);
 
-	/*Refresh the label*/
-	lv_label_set_text(ext->label, buf);
+	/*Delete a character in place. Only the affected lines are refreshed*/
+	lv_label_cut_text(ext->label, cur_pos - 1, 1);
 
 	/*Move the cursor to the place of the deleted character*/
 	lv_ta_set_cursor_pos(ta, lv_ta_get_cursor_pos(ta) - 1);
@@ -307,6 +303,9 @@ void lv_ta_set_cursor_pos(lv_obj_t * ta, int16_t pos)
 
 	if(pos > txt_len || pos == LV_TA_CUR_LAST) pos = txt_len;
 
+	/*Redraw the cursor on its old place*/
+	lv_ta_inv_cursor(ta);
+
 	ext->cursor_pos = pos;
 
 	/*Position the label to make the cursor visible*/
@@ -331,7 +330,8 @@ void lv_ta_set_cursor_pos(lv_obj_t * ta, int16_t pos)
 				                     font_get_height(font_p) + 2 * style->pages.scrl_rects.vpad));
 	}
 
-	lv_obj_inv(ta);
+	/*Draw the cursor on its new place*/
+	lv_ta_inv_cursor(ta);
 }
 
 
@@ -534,16 +534,8 @@ static bool lv_ta_scrling_design(lv_obj_t * scrling, const area_t * mask, lv_des
 		lv_tas_t * ta_style = lv_obj_get_style(ta);
 
 		if(ta_style->cursor_show != 0 && ta_ext->cur_hide == 0) {
-			uint16_t cur_pos = lv_ta_get_cursor_pos(ta);
-			point_t letter_pos;
-			lv_label_get_letter_pos(ta_ext->label, cur_pos, &letter_pos);
-
 			area_t cur_area;
-			lv_labels_t * labels_p = lv_obj_get_style(ta_ext->label);
-			cur_area.x1 = letter_pos.x + ta_ext->label->cords.x1 - (ta_style->cursor_width >> 1);
-			cur_area.y1 = letter_pos.y + ta_ext->label->cords.y1;
-			cur_area.x2 = letter_pos.x + ta_ext->label->cords.x1 + (ta_style->cursor_width >> 1);
-			cur_area.y2 = letter_pos.y + ta_ext->label->cords.y1 + font_get_height(font_get(labels_p->font));
+			lv_ta_get_cursor_area(ta, &cur_area);
 
 			lv_rects_t cur_rects;
 			lv_rects_get(LV_RECTS_DEF, &cur_rects);
@@ -569,10 +561,44 @@ static void lv_ta_hide_cursor(lv_obj_t * ta, uint8_t hide)
 	lv_ta_ext_t * ta_ext = lv_obj_get_ext(ta);
 	if(hide != ta_ext->cur_hide) {
         ta_ext->cur_hide = hide  == 0 ? 0 : 1;
-        lv_obj_inv(ta);
+        lv_ta_inv_cursor(ta);
 	}
 }
 
+/**
+ * Get the area of the cursor
+ * @param ta pointer to a text area object
+ * @param cur_area store the absolute coordinates of the cursor here
+ */
+static void lv_ta_get_cursor_area(lv_obj_t * ta, area_t * cur_area)
+{
+    lv_ta_ext_t * ta_ext = lv_obj_get_ext(ta);
+    lv_tas_t * ta_style = lv_obj_get_style(ta);
+    lv_labels_t * labels_p = lv_obj_get_style(ta_ext->label);
+    point_t letter_pos;
+    lv_label_get_letter_pos(ta_ext->label, ta_ext->cursor_pos, &letter_pos);
+    lv_obj_refr_cords(ta_ext->label);
+
+    cur_area->x1 = letter_pos.x + ta_ext->label->cords.x1 - (ta_style->cursor_width >> 1);
+    cur_area->y1 = letter_pos.y + ta_ext->label->cords.y1;
+    cur_area->x2 = letter_pos.x + ta_ext->label->cords.x1 + (ta_style->cursor_width >> 1);
+    cur_area->y2 = letter_pos.y + ta_ext->label->cords.y1 + font_get_height(font_get(labels_p->font));
+}
+
+/**
+ * Invalidate only the area of the cursor (instead of the whole text area)
+ * @param ta pointer to a text area object
+ */
+static void lv_ta_inv_cursor(lv_obj_t * ta)
+{
+    lv_ta_ext_t * ta_ext = lv_obj_get_ext(ta);
+    if(ta_ext->label == NULL) return;
+
+    area_t cur_area;
+    lv_ta_get_cursor_area(ta, &cur_area);
+    lv_obj_inv_area(ta, &cur_area);
+}
+
 /**
  * Save the cursor x position as valid. It is important when jumping up/down to a shorter line
  * @param ta pointer to a text area object
@@ -30,6 +30,9 @@
 
 #include <lvgl/lv_objx/lv_chart.h>
 #include "lv_obj/lv_obj.h"
+#include "lv_obj/lv_layer.h"
+#include "lv_obj/lv_cmd.h"
+#include "lv_obj/lv_scrd.h"
 #include "lv_objx/lv_btn.h"
 #include "lv_objx/lv_img.h"
 #include "lv_objx/lv_label.h"